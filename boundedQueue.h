@@ -0,0 +1,250 @@
+/*******************************************************************************
+ *
+ * \file    boundedQueue.h
+ * \brief   нУλ尴λʵֶ߶ߣʱγɱѹͳռ
+ * \author  agent
+ * \version 1.0
+ * \date    2026-10-19
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * -----------------------------------------------------------------------------
+ * ļ޸ʷ
+ * <ʱ>       | <汾>  | <>         |
+ * 2026-10-19  | v1.0    | agent          |
+ * -----------------------------------------------------------------------------
+ ******************************************************************************/
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <chrono>
+#include <cstdint>
+using namespace std;
+
+/*===================================================================================*/
+/******************************** 궨 *********************************************/
+/*===================================================================================*/
+#define QUEUE_CAPACITY				4							// Ĭ,ȡΪ2
+#define QUEUE_SPINS				   64							// ǰó,֮תΪ
+#define QUEUE_SLEEPUS			   50							// ȴ߼ .us
+#define QUEUE_CACHELINE			   64							// дС .byte,дλ÷ֿűα
+/*-----------------------------------------------------------------------------------*/
+
+#pragma once
+#ifndef BOUNDEDQUEUE_H
+#define BOUNDEDQUEUE_H
+
+template<class T>
+class boundedQueue
+{
+public:
+	typedef struct
+	{
+		size_t capacity;							// 
+		size_t maxOccupancy;						// ʱ۲⵽ռ
+		double meanOccupancy;						// ʱ۲⵽ƽռ
+		size_t pushNum;								// Ӵ
+		size_t fullWaits;							// ʱĴ,ѹ
+		size_t emptyWaits;							// ʱΪնĴ,οյȴ
+	}queue_stats;
+
+public:
+	/*
+	 * @breif:캯,λųʼΪλ±
+	 * @prama[in]:capacity->,ȡΪ2,Ϊ2
+	 */
+	boundedQueue(size_t capacity = QUEUE_CAPACITY)
+	{
+		size_t cap = 2;
+		while (cap < capacity)	cap <<= 1;
+		boundedQueue::mask = cap - 1;
+		boundedQueue::cells.reset(new queue_cell[cap]);
+		for (size_t i = 0; i < cap; i++)	boundedQueue::cells[i].seq.store(i, memory_order_relaxed);
+		boundedQueue::enqueuePos.store(0, memory_order_relaxed);
+		boundedQueue::dequeuePos.store(0, memory_order_relaxed);
+		boundedQueue::closed.store(false);
+		boundedQueue::maxOccupancy.store(0);
+		boundedQueue::occupancySum.store(0);
+		boundedQueue::pushNum.store(0);
+		boundedQueue::fullWaits.store(0);
+		boundedQueue::emptyWaits.store(0);
+	}
+
+	/*
+	 * @breif:;λŵдλʱòۿ,CASռдλúд벢
+	 * @prama[in]:item->Ԫ,ɹʱ
+	 * @retval:true->ɹ; false->
+	 */
+	bool tryPush(T& item)
+	{
+		queue_cell* cell;
+		size_t pos = boundedQueue::enqueuePos.load(memory_order_relaxed);
+		while (true)
+		{
+			cell = &boundedQueue::cells[pos & boundedQueue::mask];
+			size_t seq = cell->seq.load(memory_order_acquire);
+			intptr_t dif = (intptr_t)seq - (intptr_t)pos;
+			if (dif == 0)
+			{
+				if (boundedQueue::enqueuePos.compare_exchange_weak(pos, pos + 1, memory_order_relaxed))	break;
+			}
+			else if (dif < 0)	return false;
+			else				pos = boundedQueue::enqueuePos.load(memory_order_relaxed);
+		}
+		cell->data = move(item);
+		cell->seq.store(pos + 1, memory_order_release);
+		boundedQueue::record(pos + 1);
+		return true;
+	}
+
+	/*
+	 * @breif:;λŵڶλ+1ʱòд,ǰһȦ
+	 * @prama[in]:item->ĳԪ
+	 * @retval:true->ɹ; false->Ϊ
+	 */
+	bool tryPop(T& item)
+	{
+		queue_cell* cell;
+		size_t pos = boundedQueue::dequeuePos.load(memory_order_relaxed);
+		while (true)
+		{
+			cell = &boundedQueue::cells[pos & boundedQueue::mask];
+			size_t seq = cell->seq.load(memory_order_acquire);
+			intptr_t dif = (intptr_t)seq - (intptr_t)(pos + 1);
+			if (dif == 0)
+			{
+				if (boundedQueue::dequeuePos.compare_exchange_weak(pos, pos + 1, memory_order_relaxed))	break;
+			}
+			else if (dif < 0)	return false;
+			else				pos = boundedQueue::dequeuePos.load(memory_order_relaxed);
+		}
+		item = move(cell->data);
+		cell->seq.store(pos + boundedQueue::mask + 1, memory_order_release);
+		return true;
+	}
+
+	/*
+	 * @breif:,ʱȴȡ,˱
+	 * @prama[in]:item->Ԫ,ɹʱ
+	 * @retval:true->ɹ; false->ѹر
+	 */
+	bool push(T& item)
+	{
+		if (boundedQueue::closed.load(memory_order_acquire))	return false;
+		if (boundedQueue::tryPush(item))	return true;
+		boundedQueue::fullWaits++;
+		for (int spin = 0; !boundedQueue::tryPush(item); spin++)
+		{
+			if (boundedQueue::closed.load(memory_order_acquire))	return false;
+			boundedQueue::backoff(spin);
+		}
+		return true;
+	}
+
+	/*
+	 * @breif:,пʱȴд
+	 * @prama[in]:item->ĳԪ
+	 * @retval:true->ɹ; false->ѹرȡ
+	 */
+	bool pop(T& item)
+	{
+		if (boundedQueue::tryPop(item))	return true;
+		boundedQueue::emptyWaits++;
+		for (int spin = 0; !boundedQueue::tryPop(item); spin++)
+		{
+			// رǰдԪȡ,رձ־λһ
+			if (boundedQueue::closed.load(memory_order_acquire))	return boundedQueue::tryPop(item);
+			boundedQueue::backoff(spin);
+		}
+		return true;
+	}
+
+	/*
+	 * @breif:رն,˺ʧ,ȡʣԪغʧ
+	 * @prama[in]:None
+	 * @retval:None
+	 */
+	void close()
+	{
+		boundedQueue::closed.store(true, memory_order_release);
+	}
+
+	/*
+	 * @breif:ǰռ(дʱΪֵ)
+	 * @prama[in]:None
+	 * @retval:Ԫظ
+	 */
+	size_t size() const
+	{
+		size_t head = boundedQueue::dequeuePos.load(memory_order_relaxed);
+		size_t tail = boundedQueue::enqueuePos.load(memory_order_relaxed);
+		return tail > head ? tail - head : 0;
+	}
+	size_t capacity() const
+	{
+		return boundedQueue::mask + 1;
+	}
+
+	/*
+	 * @breif:ռͳ
+	 * @prama[in]:None
+	 * @retval:ͳƽ
+	 */
+	queue_stats getStats() const
+	{
+		queue_stats stats;
+		stats.capacity = boundedQueue::capacity();
+		stats.maxOccupancy = boundedQueue::maxOccupancy.load();
+		stats.pushNum = boundedQueue::pushNum.load();
+		stats.meanOccupancy = stats.pushNum == 0 ? 0 : (double)boundedQueue::occupancySum.load() / stats.pushNum;
+		stats.fullWaits = boundedQueue::fullWaits.load();
+		stats.emptyWaits = boundedQueue::emptyWaits.load();
+		return stats;
+	}
+
+private:
+	typedef struct
+	{
+		atomic<size_t> seq;							// λ,ʶòۿд(=дλ)ɶ(=λ+1)
+		T data;										// Ԫ
+	}queue_cell;
+
+	unique_ptr<queue_cell[]> cells;					// λ
+	size_t mask;									// -1
+	alignas(QUEUE_CACHELINE) atomic<size_t> enqueuePos;		// дλ
+	alignas(QUEUE_CACHELINE) atomic<size_t> dequeuePos;		// λ
+	alignas(QUEUE_CACHELINE) atomic<bool> closed;			// Ƿѹر
+	atomic<size_t> maxOccupancy;					// ռ
+	atomic<size_t> occupancySum;					// ʱռ֮
+	atomic<size_t> pushNum;							// Ӵ
+	atomic<size_t> fullWaits;						// 
+	atomic<size_t> emptyWaits;						// 
+
+	/*
+	 * @breif:ӳɹ¼ռ,дλλ֮
+	 * @prama[in]:tail->Ӻдλ
+	 * @retval:None
+	 */
+	void record(size_t tail)
+	{
+		size_t head = boundedQueue::dequeuePos.load(memory_order_relaxed);
+		size_t occupancy = tail > head ? tail - head : 0;
+		boundedQueue::occupancySum.fetch_add(occupancy, memory_order_relaxed);
+		boundedQueue::pushNum.fetch_add(1, memory_order_relaxed);
+		size_t prevMax = boundedQueue::maxOccupancy.load(memory_order_relaxed);
+		while (occupancy > prevMax && !boundedQueue::maxOccupancy.compare_exchange_weak(prevMax, occupancy, memory_order_relaxed));
+	}
+
+	/*
+	 * @breif:ȴ˱,óʱƬ,õȺתռ
+	 * @prama[in]:spin->ѵȴ
+	 * @retval:None
+	 */
+	static void backoff(int spin)
+	{
+		if (spin < QUEUE_SPINS)	this_thread::yield();
+		else					this_thread::sleep_for(chrono::microseconds(QUEUE_SLEEPUS));
+	}
+};
+
+#endif // !BOUNDEDQUEUE_H
@@ -0,0 +1,467 @@
+/*******************************************************************************
+ *
+ * \file    bundleAdjust.cpp
+ * \brief   ȫֹƽȫƴӶԵڵŻͼοͼĵӦ
+ * \author  agent
+ * \version 1.0
+ * \date    2026-10-19
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * -----------------------------------------------------------------------------
+ * ļ޸ʷ
+ * <ʱ>       | <汾>  | <>         |
+ * 2026-10-19  | v1.0    | agent          |
+ * -----------------------------------------------------------------------------
+ ******************************************************************************/
+#include "bundleAdjust.h"
+
+/*===================================================================================*/
+/******************************* к *********************************************/
+/*===================================================================================*/
+
+/*
+ * @breif:캯
+ * @prama[in]:maxIters->LM; huber->Huber³ֵ .pix
+ */
+bundleAdjust::bundleAdjust(int maxIters, double huber)
+{
+	bundleAdjust::refIdx = 0;
+	bundleAdjust::maxIters = maxIters;
+	bundleAdjust::huber = huber;
+	bundleAdjust::iters = 0;
+	bundleAdjust::pcgIters = 0;
+	bundleAdjust::initRms = 0;
+	bundleAdjust::finalRms = 0;
+}
+
+/*
+ * @breif:һƴӶԵڵ,ʱ
+ * @prama[in]:idx_1,idx_2->ͼ; pt_1,pt_2->Ӧڵ
+ * @retval:None
+ */
+void bundleAdjust::addPair(int idx_1, int idx_2, const vector<Point2f>& pt_1, const vector<Point2f>& pt_2)
+{
+	if (idx_1 == idx_2 || pt_1.size() != pt_2.size() || pt_1.size() < 4)	return;
+	pair_match pair;
+	pair.idx_1 = idx_1;
+	pair.idx_2 = idx_2;
+	pair.pt_1 = pt_1;
+	pair.pt_2 = pt_2;
+	bundleAdjust::pairs.push_back(pair);
+}
+
+/*
+ * @breif:Levenberg-MarquardtŻhomoToRef;̰ͼֿϡ洢,
+ *        ԿJacobiԤĹݶ,вſɱȰƴӶԲм
+ * @prama[in]:None
+ * @retval:true->Ż; false->οͼƴӶЧ
+ */
+bool bundleAdjust::optimize()
+{
+	int imgNum = (int)bundleAdjust::homoToRef.size();
+	bundleAdjust::iters = 0;
+	bundleAdjust::pcgIters = 0;
+	if (bundleAdjust::refIdx < 0 || bundleAdjust::refIdx >= imgNum)
+	{
+		MOSAIC_LOG_ERROR("bundleAdjust::optimize οͼЧ:" << bundleAdjust::refIdx);
+		return false;
+	}
+	size_t ptNum = 0;
+	for (const pair_match& pair : bundleAdjust::pairs)
+	{
+		if (pair.idx_1 < 0 || pair.idx_1 >= imgNum || pair.idx_2 < 0 || pair.idx_2 >= imgNum)
+		{
+			MOSAIC_LOG_ERROR("bundleAdjust::optimize ƴӶԽ:" << pair.idx_1 << "," << pair.idx_2);
+			return false;
+		}
+		ptNum += pair.pt_1.size();
+	}
+	if (ptNum == 0)	return true;
+
+	vector<homo_param> params, trialParams;
+	vector<pair_block> blocks, trialBlocks;
+	vector<param_vec> delta;
+	bundleAdjust::normalize(params);
+	double cost = bundleAdjust::evaluate(params, blocks, true);
+	double sqErr = 0;
+	for (const pair_block& block : blocks)	sqErr += block.sqErr;
+	bundleAdjust::initRms = sqrt(sqErr / ptNum);
+
+	// ,SchurΪͼ鱾,ֱͼPCG
+	double lambda = BA_LAMBDA;
+	while (bundleAdjust::iters < bundleAdjust::maxIters)
+	{
+		bundleAdjust::iters++;
+		bundleAdjust::pcgIters += bundleAdjust::solvePCG(blocks, lambda, delta);
+
+		// ҳ˾ֲ P <- P(I+D)
+		trialParams = params;
+		for (int i = 0; i < imgNum; i++)
+		{
+			double D[9] = { 0 };
+			for (int k = 0; k < BA_PARAMNUM; k++)	D[k] = delta[i][k];
+			for (int r = 0; r < 3; r++)
+				for (int c = 0; c < 3; c++)
+					trialParams[i][3 * r + c] += params[i][3 * r] * D[c] + params[i][3 * r + 1] * D[3 + c] + params[i][3 * r + 2] * D[6 + c];
+		}
+
+		double trialCost = bundleAdjust::evaluate(trialParams, trialBlocks, false);
+		if (trialCost < cost)
+		{
+			double decrease = (cost - trialCost) / cost;
+			params.swap(trialParams);
+			cost = bundleAdjust::evaluate(params, blocks, true);
+			lambda = max(lambda / 3, 1e-12);
+			if (decrease < BA_FUNCTOL)	break;
+		}
+		else
+		{
+			lambda *= 4;
+			if (lambda > 1e8)
+			{
+				MOSAIC_LOG_WARN("bundleAdjust::optimize ϵ," << bundleAdjust::iters << "εǰֹ");
+				break;
+			}
+		}
+	}
+
+	// ԭԭͼ: H = P * T
+	sqErr = 0;
+	for (const pair_block& block : blocks)	sqErr += block.sqErr;
+	bundleAdjust::finalRms = sqrt(sqErr / ptNum);
+	for (int i = 0; i < imgNum; i++)
+	{
+		Mat P(3, 3, CV_64F);
+		for (int k = 0; k < 9; k++)	P.at<double>(k / 3, k % 3) = params[i][k];
+		Mat H = P * bundleAdjust::normTrans[i];
+		if (abs(H.at<double>(2, 2)) > 1e-12)	H /= H.at<double>(2, 2);
+		bundleAdjust::homoToRef[i] = H;
+	}
+	return true;
+}
+/*-----------------------------------------------------------------------------------*/
+
+
+/*===================================================================================*/
+/******************************* ˽к *********************************************/
+/*===================================================================================*/
+
+/*
+ * @breif:ͼһ任һµڵ㡢ʼ
+ * @prama[in]:params->ĳʼ
+ * @retval:None
+ */
+void bundleAdjust::normalize(vector<homo_param>& params)
+{
+	int imgNum = (int)bundleAdjust::homoToRef.size();
+	vector<Point2d> centers(imgNum, Point2d(0, 0));
+	vector<double> dists(imgNum, 0);
+	vector<size_t> counts(imgNum, 0);
+	bundleAdjust::adjPairs.assign(imgNum, vector<int>());
+	for (int p = 0; p < (int)bundleAdjust::pairs.size(); p++)
+	{
+		const pair_match& pair = bundleAdjust::pairs[p];
+		bundleAdjust::adjPairs[pair.idx_1].push_back(p);
+		bundleAdjust::adjPairs[pair.idx_2].push_back(p);
+		for (size_t k = 0; k < pair.pt_1.size(); k++)
+		{
+			centers[pair.idx_1] += Point2d(pair.pt_1[k]);
+			centers[pair.idx_2] += Point2d(pair.pt_2[k]);
+		}
+		counts[pair.idx_1] += pair.pt_1.size();
+		counts[pair.idx_2] += pair.pt_2.size();
+	}
+	for (int i = 0; i < imgNum; i++)	if (counts[i])	centers[i] /= (double)counts[i];
+	for (const pair_match& pair : bundleAdjust::pairs)
+	{
+		for (size_t k = 0; k < pair.pt_1.size(); k++)
+		{
+			dists[pair.idx_1] += norm(Point2d(pair.pt_1[k]) - centers[pair.idx_1]);
+			dists[pair.idx_2] += norm(Point2d(pair.pt_2[k]) - centers[pair.idx_2]);
+		}
+	}
+
+	// ȥĲŵƽsqrt(2),ʹһ
+	bundleAdjust::normTrans.assign(imgNum, Mat());
+	params.assign(imgNum, homo_param());
+	for (int i = 0; i < imgNum; i++)
+	{
+		double scale = (counts[i] && dists[i] > 1e-9) ? sqrt(2.0) * counts[i] / dists[i] : 1.0;
+		bundleAdjust::normTrans[i] = (Mat_<double>(3, 3) << scale, 0, -scale * centers[i].x, 0, scale, -scale * centers[i].y, 0, 0, 1);
+		Mat H;
+		bundleAdjust::homoToRef[i].convertTo(H, CV_64F);
+		Mat P = H * bundleAdjust::normTrans[i].inv();
+		for (int k = 0; k < 9; k++)	params[i][k] = P.at<double>(k / 3, k % 3);
+	}
+
+	bundleAdjust::normPairs = bundleAdjust::pairs;
+	for (pair_match& pair : bundleAdjust::normPairs)
+	{
+		vector<Point2f> srcPt_1 = pair.pt_1, srcPt_2 = pair.pt_2;
+		perspectiveTransform(srcPt_1, pair.pt_1, bundleAdjust::normTrans[pair.idx_1]);
+		perspectiveTransform(srcPt_2, pair.pt_2, bundleAdjust::normTrans[pair.idx_2]);
+	}
+}
+
+/*
+ * @breif:ƴӶԲм,needJacobianΪtrueʱͬʱۼӸƴӶԵķ̿
+ * @prama[in]:params->ǰ; blocks->ĸƴӶԷ̿; needJacobian->Ƿſɱ
+ * @retval:ܴ
+ */
+double bundleAdjust::evaluate(const vector<homo_param>& params, vector<pair_block>& blocks, bool needJacobian)
+{
+	double h = bundleAdjust::huber;
+	blocks.resize(bundleAdjust::normPairs.size());
+	parallel_for_(Range(0, (int)bundleAdjust::normPairs.size()), [&](const Range& range)
+	{
+		double J1[2][BA_PARAMNUM], J2[2][BA_PARAMNUM];
+		for (int p = range.start; p < range.end; p++)
+		{
+			const pair_match& pair = bundleAdjust::normPairs[p];
+			const homo_param& P1 = params[pair.idx_1];
+			const homo_param& P2 = params[pair.idx_2];
+			pair_block& block = blocks[p];
+			block.cost = 0;
+			block.sqErr = 0;
+			if (needJacobian)
+			{
+				block.A11.fill(0);	block.A22.fill(0);	block.A12.fill(0);
+				block.g1.fill(0);	block.g2.fill(0);
+			}
+			for (size_t k = 0; k < pair.pt_1.size(); k++)
+			{
+				double x[3] = { pair.pt_1[k].x, pair.pt_1[k].y, 1 };
+				double y[3] = { pair.pt_2[k].x, pair.pt_2[k].y, 1 };
+				double u[3], v[3];
+				for (int r = 0; r < 3; r++)
+				{
+					u[r] = P1[3 * r] * x[0] + P1[3 * r + 1] * x[1] + P1[3 * r + 2];
+					v[r] = P2[3 * r] * y[0] + P2[3 * r + 1] * y[1] + P2[3 * r + 2];
+				}
+				if (abs(u[2]) < 1e-12 || abs(v[2]) < 1e-12)	continue;
+
+				// ӳ䵽οͼľ,Huber˰IRLSȨ
+				double res[2] = { u[0] / u[2] - v[0] / v[2], u[1] / u[2] - v[1] / v[2] };
+				double e2 = res[0] * res[0] + res[1] * res[1];
+				double e = sqrt(e2);
+				double w = (e <= h) ? 1.0 : h / e;
+				block.cost += (e <= h) ? e2 : 2 * h * e - h * h;
+				block.sqErr += e2;
+				if (!needJacobian)	continue;
+
+				bundleAdjust::calJacobian(P1, u, x, 1.0, J1);
+				bundleAdjust::calJacobian(P2, v, y, -1.0, J2);
+				for (int a = 0; a < BA_PARAMNUM; a++)
+				{
+					block.g1[a] += w * (J1[0][a] * res[0] + J1[1][a] * res[1]);
+					block.g2[a] += w * (J2[0][a] * res[0] + J2[1][a] * res[1]);
+					for (int b = 0; b < BA_PARAMNUM; b++)
+					{
+						block.A11[a * BA_PARAMNUM + b] += w * (J1[0][a] * J1[0][b] + J1[1][a] * J1[1][b]);
+						block.A22[a * BA_PARAMNUM + b] += w * (J2[0][a] * J2[0][b] + J2[1][a] * J2[1][b]);
+						block.A12[a * BA_PARAMNUM + b] += w * (J1[0][a] * J2[0][b] + J1[1][a] * J2[1][b]);
+					}
+				}
+			}
+		}
+	});
+
+	// ˳Լ,߳޹
+	double cost = 0;
+	for (const pair_block& block : blocks)	cost += block.cost;
+	return cost;
+}
+
+/*
+ * @breif:JacobiԤݶ (JtJ + lambda*diag(JtJ)) delta = -g
+ * @prama[in]:blocks->ƴӶԷ̿; lambda->ϵ; delta->Ĳ
+ * @retval:PCG
+ */
+int bundleAdjust::solvePCG(const vector<pair_block>& blocks, double lambda, vector<param_vec>& delta)
+{
+	int imgNum = (int)bundleAdjust::homoToRef.size();
+	const int N = BA_PARAMNUM;
+	param_block zeroBlock;
+	param_vec zeroVec;
+	zeroBlock.fill(0);
+	zeroVec.fill(0);
+
+	// ԽǿݶȰͼԼ;οͼδƴӵͼ̶,
+	vector<param_block> diag(imgNum, zeroBlock), precond(imgNum, zeroBlock);
+	vector<param_vec> rhs(imgNum, zeroVec);
+	vector<bool> fixed(imgNum);
+	for (int p = 0; p < (int)blocks.size(); p++)
+	{
+		const pair_match& pair = bundleAdjust::normPairs[p];
+		for (int k = 0; k < N * N; k++)
+		{
+			diag[pair.idx_1][k] += blocks[p].A11[k];
+			diag[pair.idx_2][k] += blocks[p].A22[k];
+		}
+		for (int k = 0; k < N; k++)
+		{
+			rhs[pair.idx_1][k] -= blocks[p].g1[k];
+			rhs[pair.idx_2][k] -= blocks[p].g2[k];
+		}
+	}
+	for (int i = 0; i < imgNum; i++)
+	{
+		fixed[i] = (i == bundleAdjust::refIdx || bundleAdjust::adjPairs[i].empty());
+		if (fixed[i])
+		{
+			diag[i] = zeroBlock;
+			rhs[i] = zeroVec;
+			continue;
+		}
+		for (int k = 0; k < N; k++)	diag[i][k * N + k] += lambda * max(diag[i][k * N + k], 1e-9);
+		precond[i] = diag[i];
+		if (!bundleAdjust::choleskyDecomp(precond[i]))
+		{
+			// ˻ΪԽԤ
+			precond[i] = zeroBlock;
+			for (int k = 0; k < N; k++)	precond[i][k * N + k] = sqrt(max(diag[i][k * N + k], 1e-12));
+		}
+	}
+
+	// ϡ: y_i = D_i x_i + sum(A_ij x_j),ͼ,ͼֻд
+	auto multiply = [&](const vector<param_vec>& x, vector<param_vec>& y)
+	{
+		parallel_for_(Range(0, imgNum), [&](const Range& range)
+		{
+			for (int i = range.start; i < range.end; i++)
+			{
+				y[i].fill(0);
+				if (fixed[i])	continue;
+				for (int a = 0; a < N; a++)
+					for (int b = 0; b < N; b++)	y[i][a] += diag[i][a * N + b] * x[i][b];
+				for (int p : bundleAdjust::adjPairs[i])
+				{
+					const pair_match& pair = bundleAdjust::normPairs[p];
+					const param_block& A12 = blocks[p].A12;
+					if (pair.idx_1 == i && !fixed[pair.idx_2])
+					{
+						for (int a = 0; a < N; a++)
+							for (int b = 0; b < N; b++)	y[i][a] += A12[a * N + b] * x[pair.idx_2][b];
+					}
+					else if (pair.idx_2 == i && !fixed[pair.idx_1])
+					{
+						for (int a = 0; a < N; a++)
+							for (int b = 0; b < N; b++)	y[i][a] += A12[b * N + a] * x[pair.idx_1][b];
+					}
+				}
+			}
+		});
+	};
+	auto dot = [&](const vector<param_vec>& a, const vector<param_vec>& b)
+	{
+		double sum = 0;
+		for (int i = 0; i < imgNum; i++)
+			for (int k = 0; k < N; k++)	sum += a[i][k] * b[i][k];
+		return sum;
+	};
+	auto precondition = [&](const vector<param_vec>& r, vector<param_vec>& z)
+	{
+		for (int i = 0; i < imgNum; i++)
+		{
+			if (fixed[i])	z[i] = zeroVec;
+			else	bundleAdjust::choleskySolve(precond[i], r[i], z[i]);
+		}
+	};
+
+	delta.assign(imgNum, zeroVec);
+	vector<param_vec> r = rhs, z(imgNum), d(imgNum), q(imgNum);
+	precondition(r, z);
+	d = z;
+	double rz = dot(r, z);
+	double rz0 = rz;
+	int it = 0;
+	while (it < BA_PCGITERS && rz > BA_PCGTOL * rz0 && rz0 > 0)
+	{
+		it++;
+		multiply(d, q);
+		double dq = dot(d, q);
+		if (dq <= 0)	break;
+		double alpha = rz / dq;
+		for (int i = 0; i < imgNum; i++)
+		{
+			for (int k = 0; k < N; k++)
+			{
+				delta[i][k] += alpha * d[i][k];
+				r[i][k] -= alpha * q[i][k];
+			}
+		}
+		precondition(r, z);
+		double rzNew = dot(r, z);
+		double beta = rzNew / rz;
+		rz = rzNew;
+		for (int i = 0; i < imgNum; i++)
+			for (int k = 0; k < N; k++)	d[i][k] = z[i][k] + beta * d[i][k];
+	}
+	return it;
+}
+
+/*
+ * @breif:вԾֲſɱ,r=proj(P(I+D)x),J(:,3r+c)=G(:,r)*x[c],G=dproj/du*P
+ * @prama[in]:P->Ӧ; u->P*x; x->һ; sign->в; J->2x8ſɱ
+ * @retval:None
+ */
+void bundleAdjust::calJacobian(const homo_param& P, const double u[3], const double x[3], double sign, double J[2][BA_PARAMNUM])
+{
+	double invW = sign / u[2];
+	double px = u[0] / u[2], py = u[1] / u[2];
+	for (int r = 0; r < 3; r++)
+	{
+		double G0 = (P[r] - px * P[6 + r]) * invW;
+		double G1 = (P[3 + r] - py * P[6 + r]) * invW;
+		for (int c = 0; c < 3; c++)
+		{
+			int k = 3 * r + c;
+			if (k >= BA_PARAMNUM)	break;
+			J[0][k] = G0 * x[c];
+			J[1][k] = G1 * x[c];
+		}
+	}
+}
+
+/*
+ * @breif:8x8ԳԭλCholeskyֽ⼰,ڿJacobiԤ
+ * @prama[in]:A->Գƿ,ֽΪL; b->Ҷ; x->
+ * @retval:true->ֽɹ; false->
+ */
+bool bundleAdjust::choleskyDecomp(param_block& A)
+{
+	const int N = BA_PARAMNUM;
+	for (int j = 0; j < N; j++)
+	{
+		double s = A[j * N + j];
+		for (int k = 0; k < j; k++)	s -= A[j * N + k] * A[j * N + k];
+		if (s <= 0)	return false;
+		A[j * N + j] = sqrt(s);
+		for (int i = j + 1; i < N; i++)
+		{
+			double t = A[i * N + j];
+			for (int k = 0; k < j; k++)	t -= A[i * N + k] * A[j * N + k];
+			A[i * N + j] = t / A[j * N + j];
+		}
+	}
+	return true;
+}
+
+void bundleAdjust::choleskySolve(const param_block& L, const param_vec& b, param_vec& x)
+{
+	const int N = BA_PARAMNUM;
+	for (int i = 0; i < N; i++)
+	{
+		double s = b[i];
+		for (int k = 0; k < i; k++)	s -= L[i * N + k] * x[k];
+		x[i] = s / L[i * N + i];
+	}
+	for (int i = N - 1; i >= 0; i--)
+	{
+		double s = x[i];
+		for (int k = i + 1; k < N; k++)	s -= L[k * N + i] * x[k];
+		x[i] = s / L[i * N + i];
+	}
+}
+/*-----------------------------------------------------------------------------------*/
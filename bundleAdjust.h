@@ -0,0 +1,136 @@
+/*******************************************************************************
+ *
+ * \file    bundleAdjust.h
+ * \brief   ȫֹƽȫƴӶԵڵŻͼοͼĵӦ
+ * \author  agent
+ * \version 1.0
+ * \date    2026-10-19
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * -----------------------------------------------------------------------------
+ * ļ޸ʷ
+ * <ʱ>       | <汾>  | <>         |
+ * 2026-10-19  | v1.0    | agent          |
+ * -----------------------------------------------------------------------------
+ ******************************************************************************/
+#include <opencv2/core.hpp>
+#include "publicElement.h"
+#include <iostream>
+#include <array>
+#include <vector>
+using namespace cv;
+using namespace std;
+
+/*===================================================================================*/
+/******************************** 궨 *********************************************/
+/*===================================================================================*/
+#define BA_PARAMNUM					8							// ÿͼĲ(ֲӦ,H33̶)
+#define BA_MAXITERS				   50							// LM
+#define BA_PCGITERS				  200							// ÿLMPCG
+#define BA_PCGTOL				 1e-8							// PCGԲвֵ(ƽ)
+#define BA_HUBER				  2.0							// Huber³ֵ .pix
+#define BA_LAMBDA				 1e-4							// LMʼϵ
+#define BA_FUNCTOL				 1e-4							// ½ֵ
+#define BA_MINPAIRPTS			   16							// ƴӶԲƽڵ
+/*-----------------------------------------------------------------------------------*/
+
+#pragma once
+#ifndef BUNDLEADJUST_H
+#define BUNDLEADJUST_H
+
+class bundleAdjust
+{
+public:
+	typedef struct
+	{
+		int idx_1, idx_2;							// ͼ
+		vector<Point2f> pt_1, pt_2;					// Ӧڵ,Եͼ
+	}pair_match;
+
+	vector<Mat> homoToRef;							// ͼοͼϵĵӦ(CV_64F),Ϊֵ,Żд
+	vector<pair_match> pairs;						// ȫƴӶԵڵ
+	int refIdx;										// οͼ,䵥Ӧ̶
+	int maxIters;									// LM
+	double huber;									// Huber³ֵ .pix
+	int iters;										// ʵLM
+	int pcgIters;									// ۼPCG
+	double initRms, finalRms;						// ŻǰӦڲοͼϵµľ .pix
+
+public:
+	/*
+	 * @breif:캯
+	 * @prama[in]:maxIters->LM; huber->Huber³ֵ .pix
+	 */
+	bundleAdjust(int maxIters = BA_MAXITERS, double huber = BA_HUBER);
+
+	/*
+	 * @breif:һƴӶԵڵ,ʱ
+	 * @prama[in]:idx_1,idx_2->ͼ; pt_1,pt_2->Ӧڵ
+	 * @retval:None
+	 */
+	void addPair(int idx_1, int idx_2, const vector<Point2f>& pt_1, const vector<Point2f>& pt_2);
+
+	/*
+	 * @breif:Levenberg-MarquardtŻhomoToRef;̰ͼֿϡ洢,
+	 *        ԿJacobiԤĹݶ,вſɱȰƴӶԲм
+	 * @prama[in]:None
+	 * @retval:true->Ż; false->οͼƴӶЧ
+	 */
+	bool optimize();
+
+private:
+	typedef array<double, 9> homo_param;			// Ӧ(һ->οͼ),
+	typedef array<double, BA_PARAMNUM * BA_PARAMNUM> param_block;
+	typedef array<double, BA_PARAMNUM> param_vec;
+
+	typedef struct
+	{
+		param_block A11, A22, A12;					// J1'WJ1, J2'WJ2, J1'WJ2
+		param_vec g1, g2;							// J1'Wr, J2'Wr
+		double cost;								// Huber
+		double sqErr;								// δȨƽ
+	}pair_block;
+
+	vector<Mat> normTrans;							// ͼһ任(ȥĲ)
+	vector<pair_match> normPairs;					// һµڵ
+	vector<vector<int>> adjPairs;					// ͼƴӶ
+
+	/*
+	 * @breif:ͼһ任һµڵ㡢ʼ
+	 * @prama[in]:params->ĳʼ
+	 * @retval:None
+	 */
+	void normalize(vector<homo_param>& params);
+
+	/*
+	 * @breif:ƴӶԲм,needJacobianΪtrueʱͬʱۼӸƴӶԵķ̿
+	 * @prama[in]:params->ǰ; blocks->ĸƴӶԷ̿; needJacobian->Ƿſɱ
+	 * @retval:ܴ
+	 */
+	double evaluate(const vector<homo_param>& params, vector<pair_block>& blocks, bool needJacobian);
+
+	/*
+	 * @breif:JacobiԤݶ (JtJ + lambda*diag(JtJ)) delta = -g
+	 * @prama[in]:blocks->ƴӶԷ̿; lambda->ϵ; delta->Ĳ
+	 * @retval:PCG
+	 */
+	int solvePCG(const vector<pair_block>& blocks, double lambda, vector<param_vec>& delta);
+
+	/*
+	 * @breif:вԾֲſɱ,r=proj(P(I+D)x),J(:,3r+c)=G(:,r)*x[c],G=dproj/du*P
+	 * @prama[in]:P->Ӧ; u->P*x; x->һ; sign->в; J->2x8ſɱ
+	 * @retval:None
+	 */
+	static void calJacobian(const homo_param& P, const double u[3], const double x[3], double sign, double J[2][BA_PARAMNUM]);
+
+	/*
+	 * @breif:8x8ԳԭλCholeskyֽ⼰,ڿJacobiԤ
+	 * @prama[in]:A->Գƿ,ֽΪL; b->Ҷ; x->
+	 * @retval:true->ֽɹ; false->
+	 */
+	static bool choleskyDecomp(param_block& A);
+	static void choleskySolve(const param_block& L, const param_vec& b, param_vec& x);
+};
+
+#endif // !BUNDLEADJUST_H
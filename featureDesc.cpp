@@ -17,6 +17,17 @@
  ******************************************************************************/
 #include "featureDesc.h"
 
+/*
+ * @breif:캯
+ */
+featureDesc::featureDesc()
+{
+	featureDesc::detectMs = 0;
+	featureDesc::describeMs = 0;
+	featureDesc::keyPtBudget = 0;
+	featureDesc::orbFeatureNum = 0;
+}
+
 /*
  * @breif:ORB㷨
  * @prama[in]:srcGray->ԴͼĻҶͼ; keyPoint->; Desc->Ӧ
@@ -24,8 +35,26 @@
  */
 void featureDesc::getFeatureDesc_ORB(Mat& srcGray, vector<KeyPoint>& keyPoint, Mat& Desc)
 {
-	Ptr<ORB> OrbFeature = ORB::create();
-	OrbFeature->detectAndCompute(srcGray, Mat(), keyPoint, Desc);
+	auto timeBegin = chrono::steady_clock::now();
+	// ޶ʱɱѡ,SSCɸѡֻԱ
+	int featureNum = (featureDesc::keyPtBudget <= 0) ? 500 : max(featureDesc::keyPtBudget * FEATURE_OVERSAMPLE, 500);
+	if (featureDesc::orbFeature.empty() || featureDesc::orbFeatureNum != featureNum)
+	{
+		featureDesc::orbFeature = ORB::create(featureNum);
+		featureDesc::orbFeatureNum = featureNum;
+	}
+	if (featureDesc::keyPtBudget <= 0)
+	{
+		featureDesc::orbFeature->detectAndCompute(srcGray, Mat(), keyPoint, Desc);
+		featureDesc::detectMs += chrono::duration<double, milli>(chrono::steady_clock::now() - timeBegin).count();
+		return;
+	}
+	featureDesc::orbFeature->detect(srcGray, keyPoint);
+	featureDesc::selectKeyPoints_SSC(keyPoint, featureDesc::keyPtBudget, srcGray.size());
+	auto timeDetect = chrono::steady_clock::now();
+	featureDesc::orbFeature->compute(srcGray, keyPoint, Desc);
+	featureDesc::detectMs += chrono::duration<double, milli>(timeDetect - timeBegin).count();
+	featureDesc::describeMs += chrono::duration<double, milli>(chrono::steady_clock::now() - timeDetect).count();
 }
 
 /*
@@ -35,9 +64,14 @@ void featureDesc::getFeatureDesc_ORB(Mat& srcGray, vector<KeyPoint>& keyPoint, M
  */
 void featureDesc::getFeatureDesc_SIFT(Mat& srcGray, vector<KeyPoint>& keyPoint, Mat& Desc)
 {
-	Ptr<Feature2D> siftFeature = SIFT::create();
-	siftFeature->detect(srcGray, keyPoint);
-	siftFeature->compute(srcGray, keyPoint, Desc);
+	if (featureDesc::siftFeature.empty())	featureDesc::siftFeature = SIFT::create();
+	auto timeBegin = chrono::steady_clock::now();
+	featureDesc::siftFeature->detect(srcGray, keyPoint);
+	if (featureDesc::keyPtBudget > 0)	featureDesc::selectKeyPoints_SSC(keyPoint, featureDesc::keyPtBudget, srcGray.size());
+	auto timeDetect = chrono::steady_clock::now();
+	featureDesc::siftFeature->compute(srcGray, keyPoint, Desc);
+	featureDesc::detectMs += chrono::duration<double, milli>(timeDetect - timeBegin).count();
+	featureDesc::describeMs += chrono::duration<double, milli>(chrono::steady_clock::now() - timeDetect).count();
 }
 
 /*
@@ -59,7 +93,76 @@ void featureDesc::getFeatureDesc_SIFT(Mat& srcGray, vector<KeyPoint>& keyPoint,
  */
 void featureDesc::getFeatureDesc_BRISK(Mat& srcGray, vector<KeyPoint>& keyPoint, Mat& Desc)
 {
-	Ptr<Feature2D> BriskFeature = BRISK::create();
-	BriskFeature->detect(srcGray, keyPoint);
-	BriskFeature->compute(srcGray, keyPoint, Desc);
-}
\ No newline at end of file
+	if (featureDesc::briskFeature.empty())	featureDesc::briskFeature = BRISK::create();
+	auto timeBegin = chrono::steady_clock::now();
+	featureDesc::briskFeature->detect(srcGray, keyPoint);
+	if (featureDesc::keyPtBudget > 0)	featureDesc::selectKeyPoints_SSC(keyPoint, featureDesc::keyPtBudget, srcGray.size());
+	auto timeDetect = chrono::steady_clock::now();
+	featureDesc::briskFeature->compute(srcGray, keyPoint, Desc);
+	featureDesc::detectMs += chrono::duration<double, milli>(timeDetect - timeBegin).count();
+	featureDesc::describeMs += chrono::duration<double, milli>(chrono::steady_clock::now() - timeDetect).count();
+}
+
+/*
+ * @breif:SSC(Suppression via Square Covering)ӦǼֵ,Ӧǿ̰ı,
+ *        ÿ㸲Χ߳2rķ;rʹӽbudget,֤ɿҿռֲ
+ * @prama[in]:keyPoint->,Ϊ(Ӧ); budget->; imgSize->ͼߴ
+ * @retval:None
+ */
+void featureDesc::selectKeyPoints_SSC(vector<KeyPoint>& keyPoint, int budget, Size imgSize)
+{
+	sort(keyPoint.begin(), keyPoint.end(), [](const KeyPoint& a, const KeyPoint& b) { return a.response > b.response; });
+	if (budget <= 0 || (int)keyPoint.size() <= budget)	return;
+
+	// ߳ȡr/2,һ㸲Ϊĵ(2*r/cell+1)^2
+	int tolerance = (int)(budget * FEATURE_SSCTOL);
+	int low = 1, high = max(imgSize.width, imgSize.height);
+	vector<int> kept, bestKept;
+	vector<uchar> covered;
+	while (low <= high)
+	{
+		int radius = (low + high) / 2;
+		double cell = max(radius / 2.0, 1.0);
+		int gridCols = (int)(imgSize.width / cell) + 1, gridRows = (int)(imgSize.height / cell) + 1;
+		int reach = (int)ceil(radius / cell);
+		covered.assign((size_t)gridCols * gridRows, 0);
+		kept.clear();
+		for (int i = 0; i < (int)keyPoint.size(); i++)
+		{
+			int col = min(max((int)(keyPoint[i].pt.x / cell), 0), gridCols - 1);
+			int row = min(max((int)(keyPoint[i].pt.y / cell), 0), gridRows - 1);
+			if (covered[(size_t)row * gridCols + col])	continue;
+			kept.push_back(i);
+			for (int r = max(row - reach, 0); r <= min(row + reach, gridRows - 1); r++)
+				for (int c = max(col - reach, 0); c <= min(col + reach, gridCols - 1); c++)	covered[(size_t)r * gridCols + c] = 1;
+		}
+		// ¼budget뾶Ľ
+		if ((int)kept.size() >= budget)
+		{
+			bestKept = kept;
+			if ((int)kept.size() <= budget + tolerance)	break;
+			low = radius + 1;
+		}
+		else	high = radius - 1;
+	}
+
+	// 뾶Ϊ1Բʱ˻ΪӦȡ
+	vector<KeyPoint> selected;
+	if (bestKept.empty())	selected.assign(keyPoint.begin(), keyPoint.begin() + budget);
+	else
+	{
+		for (int k = 0; k < min((int)bestKept.size(), budget); k++)	selected.push_back(keyPoint[bestKept[k]]);
+	}
+	keyPoint.swap(selected);
+}
+
+/*
+ * @breif:ƥʱԤ㻻,ƥԼΪn*nӱȽ
+ * @prama[in]:latencyMs->ͼƥĺʱԤ .ms; binaryDesc->trueΪ(ORBBRISK)
+ * @retval:
+ */
+int featureDesc::budgetFromLatency(double latencyMs, bool binaryDesc)
+{
+	double nsPerPair = binaryDesc ? FEATURE_NSPERPAIR_HAMMING : FEATURE_NSPERPAIR_L2;
+	return max((int)sqrt(max(latencyMs, 0.0) * 1e6 / nsPerPair), 1);
+}
@@ -16,20 +16,42 @@
  * -----------------------------------------------------------------------------
  ******************************************************************************/
 #include <iostream>
+#include <chrono>
+#ifndef MOSAIC_HEADLESS
 #include <opencv2/highgui/highgui.hpp>
+#endif
 #include <opencv2/imgproc/imgproc.hpp>
 #include <opencv2/features2d.hpp>
 //#include <opencv2/xfeatures2d.hpp>
 using namespace cv;
 using namespace std;
 
+/*===================================================================================*/
+/******************************** 궨 *********************************************/
+/*===================================================================================*/
+#define FEATURE_OVERSAMPLE			4							// ޶ʱORBĺѡ㱶,SSCѡ
+#define FEATURE_SSCTOL			  0.1							// SSCĿݲ
+#define FEATURE_NSPERPAIR_L2	 25.0							// һ128άӱȽϺʱ .ns,mosaicBench궨
+#define FEATURE_NSPERPAIR_HAMMING 3.0							// һ256λӱȽϺʱ .ns
+/*-----------------------------------------------------------------------------------*/
+
 #pragma once
 #ifndef FEATUREDESC_H
 #define FEATUREDESC_H
 
 class featureDesc
 {
+public:
+	double detectMs;							// ۼƼʱ .ms
+	double describeMs;							// ۼʱ .ms, ORBһ,ʱdetectMs
+	int keyPtBudget;							// ÿͼ,0Ϊ;޶ʱSSCɸѡ,Ա
+
 public:
+	/*
+	 * @breif:캯
+	 */
+	featureDesc();
+
 	/*
 	 * @breif:ORB㷨
 	 * @prama[in]:srcGray->ԴͼĻҶͼ; keyPoint->; Desc->Ӧ
@@ -56,6 +78,27 @@ public:
 	 * @retval:None
 	 */
 	void getFeatureDesc_SURF(Mat& srcGray, vector<KeyPoint>& keyPoint, Mat& Desc);
+
+	/*
+	 * @breif:SSC(Suppression via Square Covering)ӦǼֵ,Ӧǿ̰ı,
+	 *        ÿ㸲Χ߳2rķ;rʹӽbudget,֤ɿҿռֲ
+	 * @prama[in]:keyPoint->,Ϊ(Ӧ); budget->; imgSize->ͼߴ
+	 * @retval:None
+	 */
+	static void selectKeyPoints_SSC(vector<KeyPoint>& keyPoint, int budget, Size imgSize);
+
+	/*
+	 * @breif:ƥʱԤ㻻,ƥԼΪn*nӱȽ
+	 * @prama[in]:latencyMs->ͼƥĺʱԤ .ms; binaryDesc->trueΪ(ORBBRISK)
+	 * @retval:
+	 */
+	static int budgetFromLatency(double latencyMs, bool binaryDesc);
+
+private:
+	Ptr<Feature2D> orbFeature;					// ,״ʹʱ,ͬһͼʱ
+	Ptr<Feature2D> siftFeature;
+	Ptr<Feature2D> briskFeature;
+	int orbFeatureNum;							// orbFeatureʱ,keyPtBudgetıʱؽ
 };
 
 
@@ -47,6 +47,13 @@ vector<DMatch> featureMatch::featureMatch_Lows(const Mat Desc_1, const Mat Desc_
         }
     }
 
+    // L2,,ѵѯFLANN֧һ
+    else if (matchMode == MATCHMODE_HNSW)
+    {
+        hnswIndex index;
+        if (index.build(Desc_1))    GoodMatchPoints = featureMatch::featureMatch_Lows(index, Desc_2, threshold);
+    }
+
     // L2
     else if (matchMode == MATCHMODE_NORML2)
     {
@@ -81,6 +88,14 @@ vector<DMatch> featureMatch::featureMatch_MinMax(const Mat Desc_1, const Mat Des
     Mat largeDesc = featureMatch::getLargeDesc(Desc_1, Desc_2);
     vector<DMatch> matchPoints,GoodMatchPoints;
 
+    // ϶һ,ٵһѯ
+    if (matchMode == MATCHMODE_HNSW)
+    {
+        hnswIndex index;
+        if (index.build(largeDesc)) GoodMatchPoints = featureMatch::featureMatch_MinMax(index, smallDesc, threshold);
+        return GoodMatchPoints;
+    }
+
     matcher.match(smallDesc, largeDesc, matchPoints);
     sort(matchPoints.begin(), matchPoints.end());                           // վ볤
     double minDist = matchPoints[0].distance;
@@ -93,6 +108,46 @@ vector<DMatch> featureMatch::featureMatch_MinMax(const Mat Desc_1, const Mat Des
     return GoodMatchPoints;
 }
 
+/*
+ * @breif:ƥ䣬ԤȽHNSWм,һͼͼƥʱֻһ
+ * @prama[in]:index->ѵӽHNSW;queryDesc->ѯ(CV_32F);threshold->ֵ
+ * @retval:GoodMatchPoints->ɸѡƥ,queryIdxӦѯ,trainIdxӦе
+ */
+vector<DMatch> featureMatch::featureMatch_Lows(const hnswIndex& index, const Mat& queryDesc, float threshold)
+{
+    vector<vector<DMatch> > matchePoints;
+    vector<DMatch> GoodMatchPoints;
+    index.knnMatch(queryDesc, matchePoints, 2);
+    for (int i = 0; i < matchePoints.size(); i++)
+    {
+        if (matchePoints[i].size() == 2 && matchePoints[i][0].distance < threshold * matchePoints[i][1].distance)
+        {
+            GoodMatchPoints.push_back(matchePoints[i][0]);
+        }
+    }
+    return GoodMatchPoints;
+}
+
+vector<DMatch> featureMatch::featureMatch_MinMax(const hnswIndex& index, const Mat& queryDesc, float threshold)
+{
+    vector<vector<DMatch> > matchePoints;
+    vector<DMatch> matchPoints, GoodMatchPoints;
+    index.knnMatch(queryDesc, matchePoints, 1);
+    for (int i = 0; i < matchePoints.size(); i++)
+    {
+        if (!matchePoints[i].empty())   matchPoints.push_back(matchePoints[i][0]);
+    }
+    if (matchPoints.empty())    return GoodMatchPoints;
+    sort(matchPoints.begin(), matchPoints.end());                           // վ볤
+    double minDist = matchPoints[0].distance;
+
+    for (int i = 0; i < matchPoints.size(); i++)
+    {
+        if (matchPoints[i].distance <= max(threshold * minDist, 30.0))  GoodMatchPoints.push_back(matchPoints[i]);
+    }
+    return GoodMatchPoints;
+}
+
 /*
  * @breif:ԶӦԭͼ
  * @prama[in]:goodMatchPoints->ɸѡƥ;keyPtLeft,keyPtRight->㼯
@@ -134,6 +189,7 @@ flann_distance_t featureMatch::matchModeTransFlann(int matchMode)
     {
     case(MATCHMODE_HAMMING):    return FLANN_DIST_HAMMING;
     case(MATCHMODE_NORML2):     return FLANN_DIST_L2;
+    case(MATCHMODE_HNSW):       return FLANN_DIST_L2;
     default:                    return FLANN_DIST_HAMMING;
         break;
     }  
@@ -145,6 +201,7 @@ int featureMatch::matchModeTransBFM(int matchMode)
     {
     case(MATCHMODE_HAMMING):    return NORM_HAMMING;
     case(MATCHMODE_NORML2):     return NORM_L2;
+    case(MATCHMODE_HNSW):       return NORM_L2;
     default:                    return NORM_HAMMING;
         break;
     }
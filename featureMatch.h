@@ -15,9 +15,12 @@
  * -----------------------------------------------------------------------------
  ******************************************************************************/
 #include <iostream>
+#ifndef MOSAIC_HEADLESS
 #include <opencv2/highgui/highgui.hpp>
+#endif
 #include <opencv2/imgproc/imgproc.hpp>
 #include <opencv2/features2d.hpp>
+#include "hnswIndex.h"
 using namespace cv;
 using namespace std;
 using namespace cvflann;
@@ -29,6 +32,7 @@ using namespace flann;
 #define MAXNUMBER		   10000					// 
 #define MATCHMODE_HAMMING  0						// ƥģʽ
 #define MATCHMODE_NORML2   1						// ηƥģʽ
+#define MATCHMODE_HNSW     2						// ηƥģʽ,HNSW
 /*-----------------------------------------------------------------------------------*/
 
 #pragma once
@@ -52,6 +56,14 @@ public:
 	 */
 	vector<DMatch> featureMatch_MinMax(const Mat Desc_1, const Mat Desc_2, float threshold, int matchMode);
 
+	/*
+	 * @breif:ƥ䣬ԤȽHNSWм,һͼͼƥʱֻһ
+	 * @prama[in]:index->ѵӽHNSW;queryDesc->ѯ(CV_32F);threshold->ֵ
+	 * @retval:GoodMatchPoints->ɸѡƥ,queryIdxӦѯ,trainIdxӦе
+	 */
+	vector<DMatch> featureMatch_Lows(const hnswIndex& index, const Mat& queryDesc, float threshold);
+	vector<DMatch> featureMatch_MinMax(const hnswIndex& index, const Mat& queryDesc, float threshold);
+
 	//void drawMatchImg();
 
 	/*
@@ -0,0 +1,375 @@
+/*******************************************************************************
+ *
+ * \file    hnswIndex.cpp
+ * \brief   HNSWӵķֲɵСͼ0ھӱţѯ
+ * \author  agent
+ * \version 1.0
+ * \date    2026-10-19
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * -----------------------------------------------------------------------------
+ * ļ޸ʷ
+ * <ʱ>       | <汾>  | <>         |
+ * 2026-10-19  | v1.0    | agent          |
+ * -----------------------------------------------------------------------------
+ ******************************************************************************/
+#include "hnswIndex.h"
+
+/*===================================================================================*/
+/******************************* к *********************************************/
+/*===================================================================================*/
+
+/*
+ * @breif:캯
+ * @prama[in]:M->ھ; efConstruction->ʱĺѡС; efSearch->ѯʱĺѡС
+ */
+hnswIndex::hnswIndex(int M, int efConstruction, int efSearch)
+{
+	hnswIndex::M = cmpMax(M, 2);
+	hnswIndex::efConstruction = cmpMax(efConstruction, 1);
+	hnswIndex::efSearch = cmpMax(efSearch, 1);
+	hnswIndex::dim = 0;
+	hnswIndex::nodeNum = 0;
+	hnswIndex::maxLevel = 0;
+	hnswIndex::entryPoint = -1;
+	hnswIndex::maxM0 = 2 * hnswIndex::M;
+	hnswIndex::linkBytes = 0;
+	hnswIndex::nodeStride = 0;
+	hnswIndex::level0 = nullptr;
+	hnswIndex::building = false;
+}
+
+/*
+ * @breif:ӽ,ڵżк
+ * @prama[in]:desc->(CV_32F,ÿһ)
+ * @retval:true->ɹ; false->ΪջͲCV_32F
+ */
+bool hnswIndex::build(const Mat& desc)
+{
+	if (desc.empty() || desc.type() != CV_32F)	return false;
+	hnswIndex::dim = desc.cols;
+	hnswIndex::nodeNum = desc.rows;
+	hnswIndex::maxM0 = 2 * hnswIndex::M;
+
+	// 0ڵ:ھ+ھӱ,,鳤ȡ
+	hnswIndex::linkBytes = sizeof(int) * (1 + hnswIndex::maxM0);
+	hnswIndex::nodeStride = (hnswIndex::linkBytes + sizeof(float) * hnswIndex::dim + HNSW_CACHELINE - 1)
+		/ HNSW_CACHELINE * HNSW_CACHELINE;
+	hnswIndex::level0Buf.assign(hnswIndex::nodeStride * hnswIndex::nodeNum + HNSW_CACHELINE, 0);
+	size_t offset = (HNSW_CACHELINE - (size_t)hnswIndex::level0Buf.data() % HNSW_CACHELINE) % HNSW_CACHELINE;
+	hnswIndex::level0 = hnswIndex::level0Buf.data() + offset;
+	for (int i = 0; i < hnswIndex::nodeNum; i++)
+		memcpy(hnswIndex::level0 + i * hnswIndex::nodeStride + hnswIndex::linkBytes, desc.ptr<float>(i),
+			sizeof(float) * hnswIndex::dim);
+
+	// 1/ln(M)Ϊ߶ȵֲָ
+	RNG rng(HNSW_SEED);
+	double levelScale = 1.0 / log((double)hnswIndex::M);
+	hnswIndex::levels.assign(hnswIndex::nodeNum, 0);
+	hnswIndex::upperLinks.assign(hnswIndex::nodeNum, vector<int>());
+	hnswIndex::maxLevel = 0;
+	hnswIndex::entryPoint = 0;
+	for (int i = 0; i < hnswIndex::nodeNum; i++)
+	{
+		int level = (int)(-log(1.0 - rng.uniform(0.0, 1.0)) * levelScale);
+		hnswIndex::levels[i] = level;
+		if (level > 0)	hnswIndex::upperLinks[i].assign(level * (hnswIndex::M + 1), 0);
+		if (level > hnswIndex::maxLevel)
+		{
+			hnswIndex::maxLevel = level;
+			hnswIndex::entryPoint = i;
+		}
+	}
+
+	// ڽڵ,ڵ㲢в;ÿԴʱ,ȡ߳Ծ⸺
+	hnswIndex::linkLocks.reset(new mutex[HNSW_LOCKSTRIPES]);
+	hnswIndex::building = true;
+	parallel_for_(Range(0, hnswIndex::nodeNum), [&](const Range& range)
+	{
+		vector<unsigned> visited(hnswIndex::nodeNum, 0);
+		unsigned tag = 0;
+		for (int i = range.start; i < range.end; i++)
+			if (i != hnswIndex::entryPoint)	hnswIndex::insert(i, visited, tag);
+	}, cmpMax(getNumThreads(), 1) * 4);
+	hnswIndex::building = false;
+	hnswIndex::linkLocks.reset();
+	return true;
+}
+
+/*
+ * @breif:ѯÿӵk,ѯв
+ * @prama[in]:queryDesc->ѯ(CV_32F,άһ); matches->Ľ,; k->
+ * @retval:None
+ */
+void hnswIndex::knnMatch(const Mat& queryDesc, vector<vector<DMatch>>& matches, int k) const
+{
+	matches.assign(queryDesc.rows, vector<DMatch>());
+	if (hnswIndex::empty() || queryDesc.empty() || k <= 0)	return;
+	if (queryDesc.type() != CV_32F || queryDesc.cols != hnswIndex::dim)
+	{
+		MOSAIC_LOG_ERROR("hnswIndex::knnMatch ѯΪCV_32FΪ" << hnswIndex::dim << "ά");
+		return;
+	}
+
+	int ef = cmpMax(hnswIndex::efSearch, k);
+	parallel_for_(Range(0, queryDesc.rows), [&](const Range& range)
+	{
+		vector<unsigned> visited(hnswIndex::nodeNum, 0);
+		unsigned tag = 0;
+		vector<dist_node> result;
+		for (int i = range.start; i < range.end; i++)
+		{
+			const float* q = queryDesc.ptr<float>(i);
+			int ep = hnswIndex::greedyDescend(q, hnswIndex::entryPoint, hnswIndex::maxLevel, 1);
+			hnswIndex::searchLayer(q, ep, ef, 0, visited, tag, result);
+			for (int j = 0; j < k && j < (int)result.size(); j++)
+				matches[i].push_back(DMatch(i, result[j].second, sqrt(result[j].first)));
+		}
+	}, cmpMax(getNumThreads(), 1) * 4);
+}
+
+/*
+ * @breif:ռõڴ
+ * @prama[in]:None
+ * @retval:ֽ
+ */
+size_t hnswIndex::memoryBytes() const
+{
+	size_t bytes = hnswIndex::level0Buf.size() + hnswIndex::levels.size() * sizeof(int);
+	for (const vector<int>& upper : hnswIndex::upperLinks)	bytes += sizeof(upper) + upper.size() * sizeof(int);
+	return bytes;
+}
+
+/*
+ * @breif:ǷΪ
+ * @prama[in]:None
+ * @retval:true->δ޽ڵ
+ */
+bool hnswIndex::empty() const
+{
+	return hnswIndex::nodeNum == 0 || hnswIndex::entryPoint < 0;
+}
+/*-----------------------------------------------------------------------------------*/
+
+
+/*===================================================================================*/
+/******************************* ˽к *********************************************/
+/*===================================================================================*/
+
+/*
+ * @breif:ڵlevelھӱ(Ϊھ)
+ * @prama[in]:node->ڵ; level->
+ * @retval:ַ
+ */
+const float* hnswIndex::vec(int node) const
+{
+	return (const float*)(hnswIndex::level0 + node * hnswIndex::nodeStride + hnswIndex::linkBytes);
+}
+
+int* hnswIndex::links(int node, int level)
+{
+	if (level == 0)	return (int*)(hnswIndex::level0 + node * hnswIndex::nodeStride);
+	return hnswIndex::upperLinks[node].data() + (level - 1) * (hnswIndex::M + 1);
+}
+
+const int* hnswIndex::links(int node, int level) const
+{
+	if (level == 0)	return (const int*)(hnswIndex::level0 + node * hnswIndex::nodeStride);
+	return hnswIndex::upperLinks[node].data() + (level - 1) * (hnswIndex::M + 1);
+}
+
+/*
+ * @breif:L2ƽ
+ * @prama[in]:a,b->
+ * @retval:
+ */
+float hnswIndex::dist(const float* a, const float* b) const
+{
+	return hal::normL2Sqr_(a, b, hnswIndex::dim);
+}
+
+/*
+ * @breif:ڵĵlevelھ,ʱ
+ * @prama[in]:node->ڵ; level->; neighbors->ھ
+ * @retval:None
+ */
+void hnswIndex::readLinks(int node, int level, vector<int>& neighbors) const
+{
+	const int* linkList = hnswIndex::links(node, level);
+	if (!hnswIndex::building)
+	{
+		neighbors.assign(linkList + 1, linkList + 1 + linkList[0]);
+		return;
+	}
+	lock_guard<mutex> lock(hnswIndex::linkLocks[node % HNSW_LOCKSTRIPES]);
+	neighbors.assign(linkList + 1, linkList + 1 + linkList[0]);
+}
+
+/*
+ * @breif:fromLeveltoLevel̰ѯĽڵ
+ * @prama[in]:q->ѯ; node->ʼڵ; fromLevel,toLevel->ֹ
+ * @retval:toLevelѯĽڵ
+ */
+int hnswIndex::greedyDescend(const float* q, int node, int fromLevel, int toLevel) const
+{
+	int cur = node;
+	float curDist = hnswIndex::dist(q, hnswIndex::vec(cur));
+	vector<int> neighbors;
+	for (int level = fromLevel; level >= toLevel; level--)
+	{
+		bool changed = true;
+		while (changed)
+		{
+			changed = false;
+			hnswIndex::readLinks(cur, level, neighbors);
+			for (int n : neighbors)
+			{
+				float d = hnswIndex::dist(q, hnswIndex::vec(n));
+				if (d < curDist)
+				{
+					curDist = d;
+					cur = n;
+					changed = true;
+				}
+			}
+		}
+	}
+	return cur;
+}
+
+/*
+ * @breif:һefĽڵ
+ * @prama[in]:q->ѯ; ep->ڽڵ; ef->ѡС; level->
+ * @prama[in]:visited,tag->ʱ뱾ıֵ; result->Ľڵ,
+ * @retval:None
+ */
+void hnswIndex::searchLayer(const float* q, int ep, int ef, int level, vector<unsigned>& visited, unsigned& tag,
+	vector<dist_node>& result) const
+{
+	// ֵշʱ,ʱ
+	if (++tag == 0)
+	{
+		fill(visited.begin(), visited.end(), 0);
+		tag = 1;
+	}
+	priority_queue<dist_node, vector<dist_node>, greater<dist_node>> candidates;	// չڵ,
+	priority_queue<dist_node> nearest;												// ǰefڵ,Զڶ
+	float d = hnswIndex::dist(q, hnswIndex::vec(ep));
+	candidates.push(dist_node(d, ep));
+	nearest.push(dist_node(d, ep));
+	visited[ep] = tag;
+
+	vector<int> neighbors;
+	while (!candidates.empty())
+	{
+		dist_node cur = candidates.top();
+		if (cur.first > nearest.top().first && (int)nearest.size() >= ef)	break;
+		candidates.pop();
+		hnswIndex::readLinks(cur.second, level, neighbors);
+		for (int n : neighbors)
+		{
+			if (visited[n] == tag)	continue;
+			visited[n] = tag;
+			float dn = hnswIndex::dist(q, hnswIndex::vec(n));
+			if ((int)nearest.size() < ef || dn < nearest.top().first)
+			{
+				candidates.push(dist_node(dn, n));
+				nearest.push(dist_node(dn, n));
+				if ((int)nearest.size() > ef)	nearest.pop();
+			}
+		}
+	}
+
+	result.resize(nearest.size());
+	for (int i = (int)nearest.size() - 1; i >= 0; i--)
+	{
+		result[i] = nearest.top();
+		nearest.pop();
+	}
+}
+
+/*
+ * @breif:ʽѡھ:,ѡѡھӶѯԶʱű,ʹھӷֲڲͬ
+ * @prama[in]:candidates->ѡڵ,ΪѡеĽڵ; maxNum->ھ
+ * @retval:None
+ */
+void hnswIndex::selectNeighbors(vector<dist_node>& candidates, int maxNum) const
+{
+	sort(candidates.begin(), candidates.end());
+	if ((int)candidates.size() <= maxNum)	return;
+	vector<dist_node> selected;
+	for (const dist_node& c : candidates)
+	{
+		if ((int)selected.size() >= maxNum)	break;
+		bool keep = true;
+		for (const dist_node& s : selected)
+		{
+			if (hnswIndex::dist(hnswIndex::vec(c.second), hnswIndex::vec(s.second)) < c.first)
+			{
+				keep = false;
+				break;
+			}
+		}
+		if (keep)	selected.push_back(c);
+	}
+	candidates.swap(selected);
+}
+
+/*
+ * @breif:дڵڵlevelھӱ,ѽڵھӵھӱ,ھӱʱѡ
+ * @prama[in]:node->ڵ; level->; neighbors->ѡеھ
+ * @retval:None
+ */
+void hnswIndex::connect(int node, int level, const vector<dist_node>& neighbors)
+{
+	int maxNum = level == 0 ? hnswIndex::maxM0 : hnswIndex::M;
+	{
+		lock_guard<mutex> lock(hnswIndex::linkLocks[node % HNSW_LOCKSTRIPES]);
+		int* linkList = hnswIndex::links(node, level);
+		linkList[0] = 0;
+		for (const dist_node& nb : neighbors)
+			if (nb.second != node && linkList[0] < maxNum)	linkList[++linkList[0]] = nb.second;
+	}
+
+	// ͬһʱֻһ,߳
+	for (const dist_node& nb : neighbors)
+	{
+		int n = nb.second;
+		if (n == node)	continue;
+		lock_guard<mutex> lock(hnswIndex::linkLocks[n % HNSW_LOCKSTRIPES]);
+		int* linkList = hnswIndex::links(n, level);
+		if (linkList[0] < maxNum)
+		{
+			linkList[++linkList[0]] = node;
+			continue;
+		}
+		vector<dist_node> candidates(1, dist_node(nb.first, node));
+		for (int j = 1; j <= linkList[0]; j++)
+			candidates.push_back(dist_node(hnswIndex::dist(hnswIndex::vec(n), hnswIndex::vec(linkList[j])), linkList[j]));
+		hnswIndex::selectNeighbors(candidates, maxNum);
+		linkList[0] = 0;
+		for (const dist_node& c : candidates)	linkList[++linkList[0]] = c.second;
+	}
+}
+
+/*
+ * @breif:һڵ:ĸ̰½,ѡ
+ * @prama[in]:node->ڵ; visited,tag->ʱֵ
+ * @retval:None
+ */
+void hnswIndex::insert(int node, vector<unsigned>& visited, unsigned& tag)
+{
+	const float* q = hnswIndex::vec(node);
+	int level = hnswIndex::levels[node];
+	int ep = hnswIndex::greedyDescend(q, hnswIndex::entryPoint, hnswIndex::maxLevel, level + 1);
+	vector<dist_node> candidates;
+	for (int l = level; l >= 0; l--)
+	{
+		hnswIndex::searchLayer(q, ep, hnswIndex::efConstruction, l, visited, tag, candidates);
+		ep = candidates.front().second;
+		hnswIndex::selectNeighbors(candidates, l == 0 ? hnswIndex::maxM0 : hnswIndex::M);
+		hnswIndex::connect(node, l, candidates);
+	}
+}
+/*-----------------------------------------------------------------------------------*/
@@ -0,0 +1,169 @@
+/*******************************************************************************
+ *
+ * \file    hnswIndex.h
+ * \brief   HNSWӵķֲɵСͼ0ھӱţѯ
+ * \author  agent
+ * \version 1.0
+ * \date    2026-10-19
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * -----------------------------------------------------------------------------
+ * ļ޸ʷ
+ * <ʱ>       | <汾>  | <>         |
+ * 2026-10-19  | v1.0    | agent          |
+ * -----------------------------------------------------------------------------
+ ******************************************************************************/
+#include <opencv2/core.hpp>
+#include <opencv2/core/hal/hal.hpp>
+#include <opencv2/features2d.hpp>
+#include "publicElement.h"
+#include <vector>
+#include <queue>
+#include <mutex>
+#include <memory>
+#include <cmath>
+using namespace cv;
+using namespace std;
+
+/*===================================================================================*/
+/******************************** 궨 *********************************************/
+/*===================================================================================*/
+#define HNSW_M					   16							// 1㼰ÿڵھ,0Ϊ2
+#define HNSW_EFCONSTRUCTION		  100							// ʱÿĺѡС,ԽͼԽߡԽ
+#define HNSW_EFSEARCH			   64							// ѯʱ0ĺѡС,ԽٻԽߡѯԽ
+#define HNSW_SEED			 20210617							// ڵ
+#define HNSW_LOCKSTRIPES		 4096							// нʱھӱķֶ
+#define HNSW_CACHELINE			   64							// 0ڵֽ
+/*-----------------------------------------------------------------------------------*/
+
+#pragma once
+#ifndef HNSWINDEX_H
+#define HNSWINDEX_H
+
+/*
+ * 0ÿڵռһ:[ھ, 2Mھ, ],ʱھӱŶ,
+ * 鰴ж;1㼰ϵĽڵ(Լ1/M),ھӱšΪL2ƽ,ʱ
+ * ڵԤȰ,ߵĽڵȲΪ,ڵ㲢в,ھӱдֶ
+ */
+class hnswIndex
+{
+public:
+	int M;											// 1㼰ÿڵھ
+	int efConstruction;								// ʱĺѡС
+	int efSearch;									// ѯʱĺѡС,ڽ
+	int dim;										// ά
+	int nodeNum;									// ڵ
+	int maxLevel;									// ߲
+	int entryPoint;									// ڽڵ
+
+public:
+	/*
+	 * @breif:캯
+	 * @prama[in]:M->ھ; efConstruction->ʱĺѡС; efSearch->ѯʱĺѡС
+	 */
+	hnswIndex(int M = HNSW_M, int efConstruction = HNSW_EFCONSTRUCTION, int efSearch = HNSW_EFSEARCH);
+
+	/*
+	 * @breif:ӽ,ڵżк
+	 * @prama[in]:desc->(CV_32F,ÿһ)
+	 * @retval:true->ɹ; false->ΪջͲCV_32F
+	 */
+	bool build(const Mat& desc);
+
+	/*
+	 * @breif:ѯÿӵk,ѯв
+	 * @prama[in]:queryDesc->ѯ(CV_32F,άһ); matches->Ľ,; k->
+	 * @retval:None
+	 */
+	void knnMatch(const Mat& queryDesc, vector<vector<DMatch>>& matches, int k) const;
+
+	/*
+	 * @breif:ռõڴ
+	 * @prama[in]:None
+	 * @retval:ֽ
+	 */
+	size_t memoryBytes() const;
+
+	/*
+	 * @breif:ǷΪ
+	 * @prama[in]:None
+	 * @retval:true->δ޽ڵ
+	 */
+	bool empty() const;
+
+private:
+	typedef pair<float, int> dist_node;				// (L2ƽ, ڵ)
+
+	int maxM0;										// 0ھ
+	size_t linkBytes;								// 0ڵھӱֽ
+	size_t nodeStride;								// 0ڵֽ
+	vector<char> level0Buf;							// 0ڵ,һڶ
+	char* level0;									// ׸ڵ
+	vector<int> levels;								// ڵ߲
+	vector<vector<int>> upperLinks;					// l(l>=1)ھӱλupperLinks[node][(l-1)*(M+1)],Ϊھ
+	unique_ptr<mutex[]> linkLocks;					// ھӱֶ,ʱʹ
+	bool building;									// Ƿڽ,ʱھӱ
+
+	/*
+	 * @breif:ڵlevelھӱ(Ϊھ)
+	 * @prama[in]:node->ڵ; level->
+	 * @retval:ַ
+	 */
+	const float* vec(int node) const;
+	int* links(int node, int level);
+	const int* links(int node, int level) const;
+
+	/*
+	 * @breif:L2ƽ
+	 * @prama[in]:a,b->
+	 * @retval:
+	 */
+	float dist(const float* a, const float* b) const;
+
+	/*
+	 * @breif:ڵĵlevelھ,ʱ
+	 * @prama[in]:node->ڵ; level->; neighbors->ھ
+	 * @retval:None
+	 */
+	void readLinks(int node, int level, vector<int>& neighbors) const;
+
+	/*
+	 * @breif:fromLeveltoLevel̰ѯĽڵ
+	 * @prama[in]:q->ѯ; node->ʼڵ; fromLevel,toLevel->ֹ
+	 * @retval:toLevelѯĽڵ
+	 */
+	int greedyDescend(const float* q, int node, int fromLevel, int toLevel) const;
+
+	/*
+	 * @breif:һefĽڵ
+	 * @prama[in]:q->ѯ; ep->ڽڵ; ef->ѡС; level->
+	 * @prama[in]:visited,tag->ʱ뱾ıֵ; result->Ľڵ,
+	 * @retval:None
+	 */
+	void searchLayer(const float* q, int ep, int ef, int level, vector<unsigned>& visited, unsigned& tag,
+		vector<dist_node>& result) const;
+
+	/*
+	 * @breif:ʽѡھ:,ѡѡھӶѯԶʱű,ʹھӷֲڲͬ
+	 * @prama[in]:candidates->ѡڵ,ΪѡеĽڵ; maxNum->ھ
+	 * @retval:None
+	 */
+	void selectNeighbors(vector<dist_node>& candidates, int maxNum) const;
+
+	/*
+	 * @breif:дڵڵlevelھӱ,ѽڵھӵھӱ,ھӱʱѡ
+	 * @prama[in]:node->ڵ; level->; neighbors->ѡеھ
+	 * @retval:None
+	 */
+	void connect(int node, int level, const vector<dist_node>& neighbors);
+
+	/*
+	 * @breif:һڵ:ĸ̰½,ѡ
+	 * @prama[in]:node->ڵ; visited,tag->ʱֵ
+	 * @retval:None
+	 */
+	void insert(int node, vector<unsigned>& visited, unsigned& tag);
+};
+
+#endif // !HNSWINDEX_H
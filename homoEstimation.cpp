@@ -33,6 +33,30 @@ homoEst::homoEst(vector<Point2f> srcPoints_1, vector<Point2f> srcPoints_2, MatSi
 	homoEst::srcPoints_2 = srcPoints_2;
 	homoEst::imgHeight = imgSize[0];
 	homoEst::imgWidth = imgSize[1];
+	homoEst::ransacIters = 0;
+	homoEst::inlierNum = 0;
+	homoEst::motionMode = MOTIONMODE_AUTO;
+	homoEst::motionModel = MOTIONMODE_HOMOGRAPHY;
+}
+homoEst::homoEst(vector<Point2f> srcPoints_1, vector<Point2f> srcPoints_2, Size imgSize)
+{
+	homoEst::srcPoints_1 = srcPoints_1;
+	homoEst::srcPoints_2 = srcPoints_2;
+	homoEst::imgHeight = imgSize.height;
+	homoEst::imgWidth = imgSize.width;
+	homoEst::ransacIters = 0;
+	homoEst::inlierNum = 0;
+	homoEst::motionMode = MOTIONMODE_AUTO;
+	homoEst::motionModel = MOTIONMODE_HOMOGRAPHY;
+}
+homoEst::homoEst()
+{
+	homoEst::imgHeight = 0;
+	homoEst::imgWidth = 0;
+	homoEst::ransacIters = 0;
+	homoEst::inlierNum = 0;
+	homoEst::motionMode = MOTIONMODE_AUTO;
+	homoEst::motionModel = MOTIONMODE_HOMOGRAPHY;
 }
 
 /*
@@ -114,7 +138,7 @@ cv::Mat find_H_SVD(std::vector<cv::Point2f> src, std::vector<cv::Point2f> tgt) {
 
 
 /*
- * @breif:ӳԣԴͼĵӦԾ()
+ * @breif:ӳԣmotionModeԴͼı任(ͳһΪ3x3),ƽơơģ͵СС,RANSAC
  * @prama[in]:dir:1->src1src2ӳ(Ĭ),dir:0->src2src1ӳ
  * @retval:None
  */
@@ -125,9 +149,22 @@ void homoEst::findHomography_Base(int dir)
     Mat H_32;
     vector<size_t> best_inliers;
     //ʹԶRANSAC
-    if (dir) GetHomographyRANSAC(homoEst::srcPoints_1, homoEst::srcPoints_2,4,H_32,best_inliers,3,2000, 0.995);
-    else GetHomographyRANSAC(homoEst::srcPoints_2, homoEst::srcPoints_1, 4, H_32, best_inliers, 3, 2000, 0.995);
+    size_t iters;
+    vector<Point2f>& ptSrc = dir ? homoEst::srcPoints_1 : homoEst::srcPoints_2;
+    vector<Point2f>& ptDst = dir ? homoEst::srcPoints_2 : homoEst::srcPoints_1;
+    if (homoEst::motionMode == MOTIONMODE_AUTO)
+        homoEst::motionModel = SelectMotionModel(ptSrc, ptDst, H_32, best_inliers, HOMO_THRESH, HOMO_MAXITERS,
+            HOMO_CONFIDENCE, HOMO_SIGMA, iters);
+    else
+    {
+        homoEst::motionModel = homoEst::motionMode;
+        iters = GetMotionRANSAC(ptSrc, ptDst, homoEst::motionMode, GetMotionSampleSize(homoEst::motionMode), H_32,
+            best_inliers, HOMO_THRESH, HOMO_MAXITERS, HOMO_CONFIDENCE);
+    }
     H_32.convertTo(homoEst::H,CV_64F,1,0);
+    homoEst::ransacIters = (int)iters;
+    homoEst::inlierNum = (int)best_inliers.size();
+    homoEst::inliers = best_inliers;
     
     //ʹԻ
     /*if (dir)	homoEst::H = find_H_matrix(homoEst::srcPoints_1, homoEst::srcPoints_2);
@@ -164,10 +201,64 @@ void homoEst::calTransBound(int dir)
 Mat homoEst::imgMapByHomo(Mat& srcImg, Mat& H, Size mapSize, int debug)
 {
     Mat dstImg;
-    warpPerspective(srcImg, dstImg, H, mapSize);
-    if (debug)      imshow("homoEst::imgMapByHomo", dstImg);
+    homoEst::imgMapByHomo(srcImg, H, mapSize, dstImg, debug);
+    return dstImg;
+}
+
+/*
+ * @breif:ȡӦ任ͼ,ʹӳ,Hݲڲʱֱremap
+ * @prama[in]:srcImg->任ǰԭͼH->Ӧ任; mapSize->任ͼĴС
+ * @prama[in]:mapCache->ӳ; cacheDir->ӳĿ¼(Ϊ)debug->ģʽ
+ * @retval:dstImg->任ͼ
+ */
+Mat homoEst::imgMapByHomo(Mat& srcImg, Mat& H, Size mapSize, warpMapCache& mapCache, string cacheDir, int debug)
+{
+    Mat dstImg;
+    homoEst::imgMapByHomo(srcImg, H, mapSize, mapCache, dstImg, cacheDir, debug);
     return dstImg;
 }
+
+/*
+ * @breif:ȡӦ任ͼ,д,ߴ粻ʱڴ
+ * @prama[in]:srcImg->任ǰԭͼH->Ӧ任; mapSize->任ͼĴС; dstImg->;debug->ģʽ
+ * @retval:None
+ */
+void homoEst::imgMapByHomo(Mat& srcImg, Mat& H, Size mapSize, Mat& dstImg, int debug)
+{
+    warpPerspective(srcImg, dstImg, H, mapSize);
+    if (debug)      MOSAIC_SHOW("homoEst::imgMapByHomo", dstImg);
+}
+
+void homoEst::imgMapByHomo(Mat& srcImg, Mat& H, Size mapSize, warpMapCache& mapCache, Mat& dstImg, string cacheDir, int debug)
+{
+    mapCache.loadOrBuild(cacheDir, H, srcImg.size(), Rect(0, 0, mapSize.width, mapSize.height));
+    mapCache.apply(srcImg, dstImg);
+    if (debug)      MOSAIC_SHOW("homoEst::imgMapByHomo", dstImg);
+}
+
+/*
+ * @breif:ȡӦ任ͼЧ,HнԴͼӳõ
+ * @prama[in]:srcImg->任ǰԭͼH->Ӧ任; mapSize->任ͼĴС; dstImg->
+ * @prama[in]:dstMask->Ч; srcMask->ԭͼЧ(ΪЧ)
+ * @prama[in]:mapCache->ӳ; cacheDir->ӳĿ¼(Ϊ)debug->ģʽ
+ * @retval:None
+ */
+void homoEst::imgMapByHomo(Mat& srcImg, Mat& H, Size mapSize, Mat& dstImg, validMask& dstMask, const validMask* srcMask,
+    int debug)
+{
+    homoEst::imgMapByHomo(srcImg, H, mapSize, dstImg, debug);
+    if (srcMask == nullptr)     dstMask.setHomo(mapSize, H, srcImg.size());
+    else                        dstMask.warpFrom(*srcMask, H, mapSize);
+}
+
+void homoEst::imgMapByHomo(Mat& srcImg, Mat& H, Size mapSize, warpMapCache& mapCache, Mat& dstImg, validMask& dstMask,
+    const validMask* srcMask, string cacheDir, int debug)
+{
+    // ݲڱ仯ʱû,ߴʵΪ׼
+    homoEst::imgMapByHomo(srcImg, H, mapSize, mapCache, dstImg, cacheDir, debug);
+    if (srcMask == nullptr)     dstMask.setHomo(dstImg.size(), H, srcImg.size());
+    else                        dstMask.warpFrom(*srcMask, H, dstImg.size(), &mapCache);
+}
 /*-----------------------------------------------------------------------------------*/
 
 
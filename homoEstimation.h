@@ -17,14 +17,27 @@
  * -----------------------------------------------------------------------------
  ******************************************************************************/
 #include <opencv2/imgproc/imgproc.hpp>
+#ifndef MOSAIC_HEADLESS
 #include <opencv2/highgui/highgui.hpp>
+#endif
 #include "opencv2/calib3d/calib3d.hpp"
 #include "publicElement.h"
 #include"ransac_personal.h"
+#include "warpMapCache.h"
+#include "validMask.h"
 #include <iostream>
 using namespace cv;
 using namespace std;
 
+/*===================================================================================*/
+/******************************** 궨 *********************************************/
+/*===================================================================================*/
+#define HOMO_THRESH                 3           // RANSACڵֵ(ͶӰ֮) .pix
+#define HOMO_MAXITERS            2000           // RANSAC
+#define HOMO_CONFIDENCE         0.995           // RANSACŶ
+#define HOMO_SIGMA                1.0           // GRICģѡ㶨λ .pix
+/*-----------------------------------------------------------------------------------*/
+
 #pragma once
 #ifndef HOMOESTIMATION_H
 #define HOMOESTIMATION_H
@@ -49,6 +62,11 @@ public:
     int leftBound;                              // Ӧ任ͼ߽
     int topBound;                               // Ӧ任ͼϱ߽
     int bottomBound;                            // Ӧ任ͼ±߽
+    int ransacIters;                            // һRANSACĵ
+    int inlierNum;                              // һRANSACڵ
+    vector<size_t> inliers;                     // һRANSACڵ,ȫƽʹ
+    int motionMode;                             // ˶ģ,MOTIONMODE_AUTOʱGRICԶѡ
+    int motionModel;                            // һιʵʲõ˶ģ
 
 public:
     /*
@@ -57,6 +75,7 @@ public:
      * @prama[in]:MatSize imgSize->Դͼߴ
      */
     homoEst(vector<Point2f> srcPoints_1, vector<Point2f> srcPoints_2, MatSize imgSize);
+    homoEst(vector<Point2f> srcPoints_1, vector<Point2f> srcPoints_2, Size imgSize);
     homoEst();
 
     /*
@@ -68,7 +87,7 @@ public:
     void printBound();
 
     /*
-     * @breif:ӳԣԴͼĵӦԾ()
+     * @breif:ӳԣmotionModeԴͼı任(ͳһΪ3x3),ƽơơģ͵СС,RANSAC
      * @prama[in]:dir:1->src1src2ӳ(Ĭ),dir:0->src2src1ӳ
      * @retval:None
      */
@@ -88,6 +107,36 @@ public:
      */
     Mat imgMapByHomo(Mat& srcImg, Mat& H, Size mapSize, int debug= DEBUGMODE_NORMAL);
 
+    /*
+     * @breif:ȡӦ任ͼ,д,ߴ粻ʱڴ
+     * @prama[in]:srcImg->任ǰԭͼH->Ӧ任; mapSize->任ͼĴС; dstImg->;debug->ģʽ
+     * @retval:None
+     */
+    void imgMapByHomo(Mat& srcImg, Mat& H, Size mapSize, Mat& dstImg, int debug = DEBUGMODE_NORMAL);
+    void imgMapByHomo(Mat& srcImg, Mat& H, Size mapSize, warpMapCache& mapCache, Mat& dstImg, string cacheDir = "",
+        int debug = DEBUGMODE_NORMAL);
+
+    /*
+     * @breif:ȡӦ任ͼ,ʹӳ,Hݲڲʱֱremap
+     * @prama[in]:srcImg->任ǰԭͼH->Ӧ任; mapSize->任ͼĴС
+     * @prama[in]:mapCache->ӳ; cacheDir->ӳĿ¼(Ϊ)debug->ģʽ
+     * @retval:dstImg->任ͼ
+     */
+    Mat imgMapByHomo(Mat& srcImg, Mat& H, Size mapSize, warpMapCache& mapCache, string cacheDir = "",
+        int debug = DEBUGMODE_NORMAL);
+
+    /*
+     * @breif:ȡӦ任ͼЧ,HнԴͼӳõ
+     * @prama[in]:srcImg->任ǰԭͼH->Ӧ任; mapSize->任ͼĴС; dstImg->
+     * @prama[in]:dstMask->Ч; srcMask->ԭͼЧ(ΪЧ)
+     * @prama[in]:mapCache->ӳ; cacheDir->ӳĿ¼(Ϊ)debug->ģʽ
+     * @retval:None
+     */
+    void imgMapByHomo(Mat& srcImg, Mat& H, Size mapSize, Mat& dstImg, validMask& dstMask, const validMask* srcMask = nullptr,
+        int debug = DEBUGMODE_NORMAL);
+    void imgMapByHomo(Mat& srcImg, Mat& H, Size mapSize, warpMapCache& mapCache, Mat& dstImg, validMask& dstMask,
+        const validMask* srcMask = nullptr, string cacheDir = "", int debug = DEBUGMODE_NORMAL);
+
 private:
     /*
      * @breif:㵥ӦԱ任ͼĸ
@@ -23,23 +23,103 @@
  /*===================================================================================*/
 
  /*
-  * @breif:构造函数,构造路径下的彩色与对应灰度图片集
-  * @prama[in]:string srcFileTxt->.txt格式的源图片路径文件
+  * @breif:构造函数,预算不限时在线程池上并行解码路径下的图片,否则只登记路径,取用时解码
+  * @prama[in]:string srcFileTxt->.txt格式的源图片路径文件; imgPaths->源图片路径列表
+  * @prama[in]:decodeScale->配准阶段解码缩放倍数,大于1时直接以1/2、1/4、1/8分辨率解码,原图在拼接时按需加载
+  * @prama[in]:memBudget->解码缓存的字节预算,0为不限
   */
-imgProcess::imgProcess(string srcFileTxt)
+imgProcess::imgProcess()
+{
+	imgProcess::store = make_shared<imgStore>();
+	imgProcess::imgNum = 0;
+	imgProcess::decodeScale = 1;
+	imgProcess::memBudget = 0;
+	imgProcess::seamMode = SEAMMODE_DP;
+	imgProcess::gainMode = GAINMODE_IMAGE;
+	imgProcess::motionMode = MOTIONMODE_AUTO;
+	imgProcess::projMode = PROJMODE_PLANE;
+	imgProcess::focal = 0;
+	imgProcess::keyPtBudget = 0;
+	imgProcess::guidedRadius = 0;
+}
+
+imgProcess::imgProcess(string srcFileTxt, int decodeScale, size_t memBudget)
 {
 	ifstream file(srcFileTxt);
 	string img_name;
 	while (getline(file, img_name))
 	{
-		Mat tempRGBImg = imread(img_name, 1);
-		imgProcess::RGBImgs.push_back(tempRGBImg);
-		Mat tempGrayImg;
-		cvtColor(tempRGBImg, tempGrayImg, COLOR_RGB2GRAY);
-		imgProcess::GrayImgs.push_back(tempGrayImg);
+		if (!img_name.empty() && img_name.back() == '\r')	img_name.pop_back();
+		if (!img_name.empty())	imgProcess::imgPaths.push_back(img_name);
 	}
-	imgProcess::imgNum = imgProcess::RGBImgs.size();
-	imgProcess::RGBImgs[0] = imgProcess::imgGammaProcess(imgProcess::RGBImgs[0], 0.9);
+	imgProcess::loadImgs(decodeScale, memBudget);
+}
+
+imgProcess::imgProcess(const vector<string>& imgPaths, int decodeScale, size_t memBudget)
+{
+	imgProcess::imgPaths = imgPaths;
+	imgProcess::loadImgs(decodeScale, memBudget);
+}
+
+/*
+ * @breif:取原分辨率彩色图、配准用彩色图与配准用灰度图,未缓存时按需解码,可多线程调用
+ * @prama[in]:idx->图片序号
+ * @note:返回的图像与缓存共用数据,被淘汰后调用者持有的图像仍然有效
+ * @retval:图片,读取失败时为空
+ */
+Mat imgProcess::getRGBImg(int idx)
+{
+	return imgProcess::store->get(idx, STORE_VARIANT_RGB);
+}
+
+Mat imgProcess::getRegImg(int idx)
+{
+	return imgProcess::store->get(idx, STORE_VARIANT_REG);
+}
+
+Mat imgProcess::getGrayImg(int idx)
+{
+	return imgProcess::store->get(idx, STORE_VARIANT_GRAY);
+}
+
+/*
+ * @breif:取原分辨率尺寸,已解码过彩色图时不再解码
+ * @prama[in]:idx->图片序号
+ * @retval:尺寸 .pix,读取失败时为空
+ */
+Size imgProcess::getImgSize(int idx)
+{
+	return imgProcess::store->imgSize(idx);
+}
+
+/*
+ * @breif:图片文件是否存在且未发生解码失败
+ * @prama[in]:idx->图片序号
+ * @retval:true->可用
+ */
+bool imgProcess::imgValid(int idx)
+{
+	return imgProcess::store->isValid(idx);
+}
+
+/*
+ * @breif:通知缓存在后台解码稍后要用的图片
+ * @prama[in]:idx->图片序号;variant->STORE_VARIANT_*
+ * @retval:None
+ */
+void imgProcess::prefetchImg(int idx, int variant)
+{
+	imgProcess::store->prefetch(idx, variant);
+}
+
+/*
+ * @breif:释放某幅图片的全部缓存,再次取用时重新解码
+ * @prama[in]:idx->图片序号
+ * @retval:None
+ */
+void imgProcess::releaseImg(int idx)
+{
+	imgProcess::store->release(idx);
 }
 
 /*
@@ -54,7 +134,7 @@ void imgProcess::showSrcImg(int mode)
 		for (int i = 0; i < imgProcess::imgNum; i++)
 		{
 			string tempWinName = getFormatStr("彩色图片%d", i+1);
-			imshow(tempWinName, imgProcess::RGBImgs[i]);
+			MOSAIC_SHOW(tempWinName, imgProcess::getRegImg(i));
 		}
 	}
 	else
@@ -62,7 +142,7 @@ void imgProcess::showSrcImg(int mode)
 		for (int i = 0; i < imgProcess::imgNum; i++)
 		{
 			string tempWinName = getFormatStr("灰度图片%d", i + 1);
-			imshow(tempWinName, imgProcess::GrayImgs[i]);
+			MOSAIC_SHOW(tempWinName, imgProcess::getGrayImg(i));
 		}
 	}
 }
@@ -73,17 +153,136 @@ void imgProcess::showSrcImg(int mode)
  * @retval:dstImg->拼接后的图像
  */
 Mat imgProcess::imgMosaic(Mat& leftImg, Mat& rightImg, int debug)
+{
+	Mat dstImg;
+	imgProcess::imgMosaic(leftImg, rightImg, dstImg, debug);
+	return dstImg;
+}
+
+/*
+ * @breif:图像拼接,写入给定缓冲,尺寸不变时复用其内存
+ * @prama[in]:leftImg->左拼接图像; rightImg->右拼接图像; dstImg->输出缓冲; debug->调试模式
+ * @retval:None
+ */
+void imgProcess::imgMosaic(Mat& leftImg, Mat& rightImg, Mat& dstImg, int debug)
+{
+	validMask rightMask;
+	rightMask.setRect(rightImg.size(), Rect(0, 0, rightImg.cols, rightImg.rows));
+	imgProcess::imgMosaic(leftImg, rightImg, rightMask, dstImg, nullptr, debug);
+}
+
+/*
+ * @breif:按右图有效像素掩码拼接,左图整行写出,右图只写出左图以外的有效区间,无效处置0
+ * @prama[in]:leftImg->左拼接图像; rightImg->右拼接图像; rightMask->右图有效像素掩码; dstImg->输出缓冲
+ * @prama[in]:dstMask->输出的拼接图有效像素掩码(为空则不输出); debug->调试模式
+ * @retval:None
+ */
+void imgProcess::imgMosaic(Mat& leftImg, Mat& rightImg, const validMask& rightMask, Mat& dstImg, validMask* dstMask, int debug)
 {
 	//创建拼接后的图,需提前计算图的大小
 	int dstWidth = cmpMax(leftImg.cols, rightImg.cols);		// 取最宽长度为拼接图的宽度
 	int dstHeight = cmpMax(leftImg.rows, rightImg.rows);		// 取最高长度为拼接图的长度
 
-	Mat dstImg(dstHeight, dstWidth, CV_8UC3);
-	dstImg.setTo(0);
-	rightImg.copyTo(dstImg(Rect(0, 0, rightImg.cols, rightImg.rows)));
-	leftImg.copyTo(dstImg(Rect(0, 0, leftImg.cols, leftImg.rows)));
-	if (debug)			imshow("imgProcess::imgMosaic", dstImg);
-	return dstImg;
+	dstImg.create(dstHeight, dstWidth, CV_8UC3);
+	if (dstMask != nullptr)	dstMask->reset(Size(dstWidth, dstHeight));
+
+	// 拷贝时经查找表施加增益,右图被左图覆盖的部分不写出;整图增益时查找表只建一次
+	// 每个像素只写一次:左图、右图有效区间直接写出,仅区间之间的空隙置0
+	uchar lutLeft[256], lutRight[256];
+	float curGainLeft = -1, curGainRight = -1;
+	for (int i = 0; i < dstHeight; i++)
+	{
+		uchar* rowAddrDst = dstImg.ptr<uchar>(i);
+		int leftCols = (i < leftImg.rows) ? leftImg.cols : 0;
+		if (leftCols > 0)
+		{
+			float gain = imgProcess::rowGain(imgProcess::gainsLeft, i, leftImg.rows);
+			if (gain != curGainLeft)	imgProcess::buildGainLUT(curGainLeft = gain, lutLeft);
+			const uchar* rowAddrLeft = leftImg.ptr<uchar>(i);
+			for (int k = 0; k < leftCols * 3; k++)	rowAddrDst[k] = lutLeft[rowAddrLeft[k]];
+			if (dstMask != nullptr)	dstMask->addRun(0, leftCols);
+		}
+
+		int col = leftCols;										// 已写出的列
+		int runNum = (i < rightImg.rows) ? rightMask.runNum(i) : 0;
+		const validMask::row_run* rowRun = rightMask.rowRuns(i);
+		const uchar* rowAddrRight = (runNum > 0) ? rightImg.ptr<uchar>(i) : nullptr;
+		for (int r = 0; r < runNum; r++)
+		{
+			int begin = cmpMax(rowRun[r].begin, leftCols), end = cmpMin(rowRun[r].end, rightImg.cols);
+			if (begin >= end)	continue;
+			float gain = imgProcess::rowGain(imgProcess::gainsRight, i, rightImg.rows);
+			if (gain != curGainRight)	imgProcess::buildGainLUT(curGainRight = gain, lutRight);
+			memset(rowAddrDst + col * 3, 0, (begin - col) * 3);
+			for (int k = begin * 3; k < end * 3; k++)	rowAddrDst[k] = lutRight[rowAddrRight[k]];
+			if (dstMask != nullptr)	dstMask->addRun(begin, end);
+			col = end;
+		}
+		memset(rowAddrDst + col * 3, 0, (dstWidth - col) * 3);
+		if (dstMask != nullptr)	dstMask->closeRow();
+	}
+	if (debug)			MOSAIC_SHOW("imgProcess::imgMosaic", dstImg);
+}
+
+/*
+ * @breif:曝光补偿,在重叠区下采样网格上统计左右图平均亮度,最小二乘求解左右图增益
+ * @prama[in]:leftImg->左拼接图像(整幅有效); rightImg->映射后的右图像; rightMask->右图的有效像素掩码
+ * @prama[in]:start,end->重叠区域左右边界
+ * @note:仅估计增益,不修改图像;增益由imgMosaic与seamOpt_*在写出拼接图时施加;只在rightMask的区间内采样,真实的黑色像素也参与统计
+ * @retval:None
+ */
+void imgProcess::calGain(Mat& leftImg, Mat& rightImg, const validMask& rightMask, int start, int end)
+{
+	imgProcess::gainsLeft.clear();
+	imgProcess::gainsRight.clear();
+	if (imgProcess::gainMode == GAINMODE_NONE)	return;
+
+	// 在下采样网格上按行块累计两图均有效处的平均亮度,左图整幅有效,右图只取掩码区间
+	int blocks = (imgProcess::gainMode == GAINMODE_BLOCK) ? GAIN_BLOCKS : 1;
+	int rows = cmpMin(leftImg.rows, rightImg.rows);
+	start = cmpMax(start, 0);
+	end = cmpMin(end, cmpMin(leftImg.cols, rightImg.cols));
+	vector<double> sumLeft(blocks, 0), sumRight(blocks, 0);
+	vector<int> sampleNum(blocks, 0);
+	for (int i = 0; i < rows; i += GAIN_GRID)
+	{
+		const uchar* rowAddrLeft = leftImg.ptr<uchar>(i);
+		const uchar* rowAddrRight = rightImg.ptr<uchar>(i);
+		int b = i * blocks / rows;
+		const validMask::row_run* rowRun = rightMask.rowRuns(i);
+		for (int r = 0; r < rightMask.runNum(i); r++)
+		{
+			// 网格列为start + k*GAIN_GRID,从区间内的第一个网格列开始
+			int begin = cmpMax(rowRun[r].begin, start), runEnd = cmpMin(rowRun[r].end, end);
+			if (begin >= runEnd)	continue;
+			begin = start + (begin - start + GAIN_GRID - 1) / GAIN_GRID * GAIN_GRID;
+			for (int j = begin; j < runEnd; j += GAIN_GRID)
+			{
+				const uchar* l = rowAddrLeft + j * 3;
+				const uchar* p = rowAddrRight + j * 3;
+				sumLeft[b] += (l[0] + l[1] + l[2]) / 3.0;
+				sumRight[b] += (p[0] + p[1] + p[2]) / 3.0;
+				sampleNum[b]++;
+			}
+		}
+	}
+
+	// 每块求解 min (gL*Il - gR*Ir)^2/σN^2 + ((1-gL)^2 + (1-gR)^2)/σg^2 的2x2正规方程
+	double invN = 1.0 / (GAIN_SIGMAN * GAIN_SIGMAN), invG = 1.0 / (GAIN_SIGMAG * GAIN_SIGMAG);
+	imgProcess::gainsLeft.assign(blocks, 1.0f);
+	imgProcess::gainsRight.assign(blocks, 1.0f);
+	for (int b = 0; b < blocks; b++)
+	{
+		if (sampleNum[b] < GAIN_MINSAMPLES)	continue;
+		double Il = sumLeft[b] / sampleNum[b], Ir = sumRight[b] / sampleNum[b];
+		Mat A = (Mat_<double>(2, 2) << Il * Il * invN + invG, -Il * Ir * invN,
+			-Il * Ir * invN, Ir * Ir * invN + invG);
+		Mat B = (Mat_<double>(2, 1) << invG, invG);
+		Mat gains;
+		if (!solve(A, B, gains))	continue;
+		imgProcess::gainsLeft[b] = (float)gains.at<double>(0);
+		imgProcess::gainsRight[b] = (float)gains.at<double>(1);
+	}
 }
 
 /*
@@ -95,9 +294,7 @@ Mat imgProcess::imgCanonical(const Mat srcImg, int height, int width)
 {
 	Mat dstImg(height, width, CV_8UC3, Scalar(0, 0, 0));			//创建一个全黑的图片
 	Mat imageROI = dstImg(Rect(0, 0, srcImg.cols, srcImg.rows));
-	Mat mask;
-	cvtColor(srcImg, mask, COLOR_RGB2GRAY);
-	srcImg.copyTo(imageROI, mask);									//将原图叠加到ROI
+	srcImg.copyTo(imageROI);										//将原图拷贝到ROI,原图中的黑色像素与底色相同,无需掩码
 	return dstImg;
 }
 
@@ -121,31 +318,84 @@ Mat imgProcess::imgGammaProcess(Mat& srcImg, double gamma)
 
 /*
  * @breif:拼接处优化，采用alpha优化方法
- * @prama[in]:leftImg->左拼接图像; rightImg->右拼接图像; dstImg->拼接后图像——优化对象;
+ * @prama[in]:leftImg->左拼接图像; rightImg->右拼接图像; rightMask->右图有效像素掩码; dstImg->拼接后图像——优化对象;
  * @prama[in]:start->优化区域起点;end->优化区域终点;debug->调试模式
  * @retval:None
  */
-void imgProcess::seamOpt_alpha(Mat& leftImg, Mat& rightImg, Mat& dstImg, int start, int end,int debug)
+void imgProcess::seamOpt_alpha(Mat& leftImg, Mat& rightImg, const validMask& rightMask, Mat& dstImg, int start, int end,
+	int debug)
 {
     double processWidth = end - start;              // 优化处理区域，即重叠区域宽度  
-    double alpha = 1;								// 左图leftImg中像素的权重
-    for (int i = 0; i < dstImg.rows; i++)
+	int rows = cmpMin(cmpMin(leftImg.rows, rightImg.rows), dstImg.rows);
+    for (int i = 0; i < rows; i++)
     {
+		// 只处理右图有效区间与重叠区[start,左图宽度)的交集,其余像素imgMosaic已写出带增益的左图
+		int runNum = rightMask.runNum(i);
+		if (runNum == 0)	continue;
+		const validMask::row_run* rowRun = rightMask.rowRuns(i);
         uchar* rowAddrLeft = leftImg.ptr<uchar>(i);	// 获取图像第i行的首地址
         uchar* rowAddrRight = rightImg.ptr<uchar>(i);
         uchar* rowAddrDst = dstImg.ptr<uchar>(i);
-        for (int j = start; j < leftImg.cols; j++)
-        {
-            // 如果遇到右图中无像素的黑点，则完全拷贝左图像素
-            if (rowAddrRight[j * 3] == 0 && rowAddrRight[j * 3 + 1] == 0 && rowAddrRight[j * 3 + 2] == 0)  alpha = 1;
-			// 左图中像素的权重，与当前处理点距重叠区域左边界的距离成正比
-            else	alpha = (processWidth - (j - start)) / processWidth; 
-			rowAddrDst[j * 3] = rowAddrLeft[j * 3] * alpha + rowAddrRight[j * 3] * (1 - alpha);
-			rowAddrDst[j * 3 + 1] = rowAddrLeft[j * 3 + 1] * alpha + rowAddrRight[j * 3 + 1] * (1 - alpha);
-			rowAddrDst[j * 3 + 2] = rowAddrLeft[j * 3 + 2] * alpha + rowAddrRight[j * 3 + 2] * (1 - alpha);
-        }
-		if (debug)		imshow("imgProcess::seamOpt_alpha", dstImg);
+		double gainLeft = imgProcess::rowGain(imgProcess::gainsLeft, i, leftImg.rows);
+		double gainRight = imgProcess::rowGain(imgProcess::gainsRight, i, rightImg.rows);
+		for (int r = 0; r < runNum; r++)
+		{
+			int runEnd = cmpMin(rowRun[r].end, leftImg.cols);
+			for (int j = cmpMax(rowRun[r].begin, cmpMax(start, 0)); j < runEnd; j++)
+			{
+				// 左图中像素的权重，与当前处理点距重叠区域左边界的距离成正比
+				double alpha = (processWidth - (j - start)) / processWidth;
+				double wl = alpha * gainLeft, wr = (1 - alpha) * gainRight;
+				rowAddrDst[j * 3] = saturate_cast<uchar>(rowAddrLeft[j * 3] * wl + rowAddrRight[j * 3] * wr);
+				rowAddrDst[j * 3 + 1] = saturate_cast<uchar>(rowAddrLeft[j * 3 + 1] * wl + rowAddrRight[j * 3 + 1] * wr);
+				rowAddrDst[j * 3 + 2] = saturate_cast<uchar>(rowAddrLeft[j * 3 + 2] * wl + rowAddrRight[j * 3 + 2] * wr);
+			}
+		}
     }
+	if (debug)		MOSAIC_SHOW("imgProcess::seamOpt_alpha", dstImg);
+}
+
+/*
+ * @breif:拼接处优化，沿最优拼接缝取像素，仅在拼接缝两侧小范围内羽化
+ * @prama[in]:leftImg->左拼接图像; rightImg->右拼接图像; rightMask->右图有效像素掩码; dstImg->拼接后图像——优化对象;
+ * @prama[in]:seamMask->重叠带掩码(255取左图);start->重叠带起点;featherWidth->羽化宽度;debug->调试模式
+ * @retval:None
+ */
+void imgProcess::seamOpt_mask(Mat& leftImg, Mat& rightImg, const validMask& rightMask, Mat& dstImg, Mat& seamMask, int start,
+	int featherWidth, int debug)
+{
+	// 掩码横向均值滤波得到左图权重，拼接缝处由1渐变到0
+	Mat alphaMap;
+	seamMask.convertTo(alphaMap, CV_32F, 1.0 / 255);
+	if (featherWidth > 1)	blur(alphaMap, alphaMap, Size(featherWidth, 1), Point(-1, -1), BORDER_REPLICATE);
+
+	int rows = cmpMin(cmpMin(alphaMap.rows, leftImg.rows), cmpMin(rightImg.rows, dstImg.rows));
+	for (int i = 0; i < rows; i++)
+	{
+		// 只处理右图有效区间与重叠带的交集,右图无像素处imgMosaic已写出带增益的左图
+		int runNum = rightMask.runNum(i);
+		if (runNum == 0)	continue;
+		const validMask::row_run* rowRun = rightMask.rowRuns(i);
+		uchar* rowAddrLeft = leftImg.ptr<uchar>(i);
+		uchar* rowAddrRight = rightImg.ptr<uchar>(i);
+		uchar* rowAddrDst = dstImg.ptr<uchar>(i);
+		float* rowAddrAlpha = alphaMap.ptr<float>(i);
+		float gainLeft = imgProcess::rowGain(imgProcess::gainsLeft, i, leftImg.rows);
+		float gainRight = imgProcess::rowGain(imgProcess::gainsRight, i, rightImg.rows);
+		for (int r = 0; r < runNum; r++)
+		{
+			int runEnd = cmpMin(rowRun[r].end, start + alphaMap.cols);
+			for (int j = cmpMax(rowRun[r].begin, start); j < runEnd; j++)
+			{
+				float alpha = rowAddrAlpha[j - start];
+				float wl = alpha * gainLeft, wr = (1 - alpha) * gainRight;
+				rowAddrDst[j * 3] = saturate_cast<uchar>(rowAddrLeft[j * 3] * wl + rowAddrRight[j * 3] * wr);
+				rowAddrDst[j * 3 + 1] = saturate_cast<uchar>(rowAddrLeft[j * 3 + 1] * wl + rowAddrRight[j * 3 + 1] * wr);
+				rowAddrDst[j * 3 + 2] = saturate_cast<uchar>(rowAddrLeft[j * 3 + 2] * wl + rowAddrRight[j * 3 + 2] * wr);
+			}
+		}
+	}
+	if (debug)		MOSAIC_SHOW("imgProcess::seamOpt_mask", dstImg);
 }
 
 /*
@@ -187,7 +437,7 @@ void imgProcess::seamOpt_laplace(Mat leftImg, Mat rightImg, Mat& dstImg, float t
 	// 融合图像重建
 	dstImg = imgProcess::imgLaplaceBlend(imgHighest, blendLaplacePyr);
 	dstImg.convertTo(dstImg, CV_8UC3);
-	if (debug == DEBUGMODE_SHOW)	imshow("imgProcess::seamOpt_laplace", dstImg);
+	if (debug == DEBUGMODE_SHOW)	MOSAIC_SHOW("imgProcess::seamOpt_laplace", dstImg);
 }
 /*-----------------------------------------------------------------------------------*/
 
@@ -274,4 +524,59 @@ Mat imgProcess::imgLaplaceBlend(Mat& imgHighest, vector<Mat> blendLp)
 	}
 	return dstImg;
 }
+
+/*
+ * @breif:取某一行的增益,分块增益在块中心之间线性插值
+ * @prama[in]:gains->各行块增益;row->行号;rows->图像行数
+ * @retval:该行增益,未估计时为1
+ */
+float imgProcess::rowGain(const vector<float>& gains, int row, int rows)
+{
+	if (gains.empty())		return 1.0f;
+	if (gains.size() == 1)	return gains[0];
+	int blocks = (int)gains.size();
+	float pos = (row + 0.5f) * blocks / rows - 0.5f;
+	int b0 = cmpMin(cmpMax((int)floor(pos), 0), blocks - 1);
+	int b1 = cmpMin(b0 + 1, blocks - 1);
+	float t = min(max(pos - b0, 0.0f), 1.0f);
+	return gains[b0] * (1 - t) + gains[b1] * t;
+}
+
+/*
+ * @breif:由增益生成查找表
+ * @prama[in]:gain->增益;lut->输出的256项查找表
+ * @retval:None
+ */
+void imgProcess::buildGainLUT(float gain, uchar* lut)
+{
+	for (int i = 0; i < 256; i++)	lut[i] = saturate_cast<uchar>(i * gain);
+}
+
+/*
+ * @breif:按imgPaths建立解码缓存,预算不限时在线程池上并行解码全部图片
+ * @prama[in]:decodeScale->配准阶段解码缩放倍数;memBudget->解码缓存的字节预算
+ * @retval:None
+ */
+void imgProcess::loadImgs(int decodeScale, size_t memBudget)
+{
+	imgProcess::seamMode = SEAMMODE_DP;
+	imgProcess::gainMode = GAINMODE_IMAGE;
+	imgProcess::motionMode = MOTIONMODE_AUTO;
+	imgProcess::projMode = PROJMODE_PLANE;
+	imgProcess::focal = 0;
+	imgProcess::keyPtBudget = 0;
+	imgProcess::guidedRadius = 0;
+	imgProcess::decodeScale = (decodeScale == 2 || decodeScale == 4 || decodeScale == 8) ? decodeScale : 1;
+	imgProcess::memBudget = memBudget;
+	imgProcess::imgNum = imgProcess::imgPaths.size();
+	imgProcess::store = make_shared<imgStore>(memBudget);
+	imgProcess::store->open(imgProcess::imgPaths, imgProcess::decodeScale);
+
+	// 有预算时只检查文件是否存在,峰值内存由预算而非图片数量决定
+	if (memBudget == 0)	imgProcess::store->loadAll();
+	for (int i = 0; i < imgProcess::imgNum; i++)
+	{
+		if (!imgProcess::imgValid(i))	cout << "imgProcess::loadImgs 图片读取失败:" << imgProcess::imgPaths[i] << endl;
+	}
+}
 /*-----------------------------------------------------------------------------------*/
\ No newline at end of file
@@ -17,10 +17,16 @@
  * -----------------------------------------------------------------------------
  ******************************************************************************/
 #include <opencv2/imgproc/imgproc.hpp>
+#include <opencv2/imgcodecs.hpp>
+#ifndef MOSAIC_HEADLESS
 #include <opencv2/highgui/highgui.hpp>
+#endif
 #include "publicElement.h"
+#include "imgStore.h"
+#include "validMask.h"
 #include <iostream>
 #include <fstream>
+#include <memory>
 using namespace cv;
 using namespace std;
 
@@ -31,6 +37,12 @@ using namespace std;
 #define SHOWMODE_RGB			   1							// ɫģʽ
 #define PYRWIDTH				  736							// ͼԭͼƬ
 #define PYRHEIGHT				  240							// 
+#define SEAMFEATHER				    8							// ƴӷ𻯿 .pix
+#define GAIN_GRID				    8							// ƵĲ .pix
+#define GAIN_BLOCKS				    8							// ֿп
+#define GAIN_SIGMAN			     10.0							// ǿı׼
+#define GAIN_SIGMAG			      0.1							// (=1)ı׼
+#define GAIN_MINSAMPLES			   16							// Ч
 /*-----------------------------------------------------------------------------------*/
 
 #pragma once
@@ -40,17 +52,68 @@ using namespace std;
 class imgProcess
 {
 public:
-	vector<Mat> RGBImgs;							// ͼƬ(RGB)
-	vector<Mat> GrayImgs;							// ͼƬ(Ҷ)
+	vector<string> imgPaths;						// ͼƬ·
+	shared_ptr<imgStore> store;						// ԭͼ׼ͼҶͼĽ뻺,Ŀ
 	int imgNum;										// ͼƬ
+	int decodeScale;								// ׼׶νű,1248
+	size_t memBudget;								// 뻺ֽԤ,0Ϊҹʱȫ׼ͼ
+	int seamMode;									// ƴӷŻģʽ,SEAMMODE_ALPHA/DP/GRAPHCUT
+	int gainMode;									// عⲹģʽ,GAINMODE_NONE/IMAGE/BLOCK
+	int motionMode;									// ˶ģ,MOTIONMODE_*,ĬϰGRICԶѡ
+	int projMode;									// ͶӰģʽ,PROJMODE_*
+	double focal;									// ͶӰ .pix(ԭֱ),0ʾȡͼ
+	int keyPtBudget;								// ÿͼ,0Ϊ
+	float guidedRadius;								// ƥļ뾶 .pix(׼ֱ),0Ϊƥ
+	vector<float> gainsLeft, gainsRight;			// ͼп,ƴںʱʩ
 
 public:
 	/*
-	 * @breif:캯,·µĲɫӦҶͼƬ
-	 * @prama[in]:string srcFileTxt->.txtʽԴͼƬ·ļ
+	 * @breif:캯,Ԥ㲻ʱ̳߳ϲн·µͼƬ,ֻǼ·,ȡʱ
+	 * @prama[in]:string srcFileTxt->.txtʽԴͼƬ·ļ; imgPaths->ԴͼƬ·б
+	 * @prama[in]:decodeScale->׼׶νű,1ʱֱ1/21/41/8ֱʽ,ԭͼƴʱ
+	 * @prama[in]:memBudget->뻺ֽԤ,0Ϊ
 	 */
 	imgProcess();
-	imgProcess(string srcFileTxt);
+	imgProcess(string srcFileTxt, int decodeScale = 1, size_t memBudget = 0);
+	imgProcess(const vector<string>& imgPaths, int decodeScale = 1, size_t memBudget = 0);
+
+	/*
+	 * @breif:ȡԭֱʲɫͼ׼òɫͼ׼ûҶͼ,δʱ,ɶ̵߳
+	 * @prama[in]:idx->ͼƬ
+	 * @note:صͼ뻺湲,̭߳еͼȻЧ
+	 * @retval:ͼƬ,ȡʧʱΪ
+	 */
+	Mat getRGBImg(int idx);
+	Mat getRegImg(int idx);
+	Mat getGrayImg(int idx);
+
+	/*
+	 * @breif:ȡԭֱʳߴ,ѽɫͼʱٽ
+	 * @prama[in]:idx->ͼƬ
+	 * @retval:ߴ .pix,ȡʧʱΪ
+	 */
+	Size getImgSize(int idx);
+
+	/*
+	 * @breif:ͼƬļǷδʧ
+	 * @prama[in]:idx->ͼƬ
+	 * @retval:true->
+	 */
+	bool imgValid(int idx);
+
+	/*
+	 * @breif:֪ͨں̨ԺҪõͼƬ
+	 * @prama[in]:idx->ͼƬ;variant->STORE_VARIANT_*
+	 * @retval:None
+	 */
+	void prefetchImg(int idx, int variant);
+
+	/*
+	 * @breif:ͷĳͼƬȫ,ٴȡʱ½
+	 * @prama[in]:idx->ͼƬ
+	 * @retval:None
+	 */
+	void releaseImg(int idx);
 
 	/*
 	 * @breif:ԭͼʾ
@@ -66,6 +129,31 @@ public:
 	 */
 	Mat imgMosaic(Mat& leftImg, Mat& rightImg, int debug = DEBUGMODE_NORMAL);
 
+	/*
+	 * @breif:ͼƴ,д,ߴ粻ʱڴ
+	 * @prama[in]:leftImg->ƴͼ; rightImg->ƴͼ; dstImg->; debug->ģʽ
+	 * @retval:None
+	 */
+	void imgMosaic(Mat& leftImg, Mat& rightImg, Mat& dstImg, int debug = DEBUGMODE_NORMAL);
+
+	/*
+	 * @breif:ͼЧƴ,ͼд,ͼֻдͼЧ,Ч0
+	 * @prama[in]:leftImg->ƴͼ; rightImg->ƴͼ; rightMask->ͼЧ; dstImg->
+	 * @prama[in]:dstMask->ƴͼЧ(Ϊ); debug->ģʽ
+	 * @retval:None
+	 */
+	void imgMosaic(Mat& leftImg, Mat& rightImg, const validMask& rightMask, Mat& dstImg, validMask* dstMask = nullptr,
+		int debug = DEBUGMODE_NORMAL);
+
+	/*
+	 * @breif:عⲹ,ص²ͳͼƽ,Сͼ
+	 * @prama[in]:leftImg->ƴͼ(Ч); rightImg->ӳͼ; rightMask->ͼЧ
+	 * @prama[in]:start,end->صұ߽
+	 * @note:,޸ͼ;imgMosaicseamOpt_*дƴͼʱʩ;ֻrightMaskڲ,ʵĺɫҲͳ
+	 * @retval:None
+	 */
+	void calGain(Mat& leftImg, Mat& rightImg, const validMask& rightMask, int start, int end);
+
 	/*
 	 * @breif:ͼ淶ĳСԭͼĲúɫ
 	 * @prama[in]:srcImg->ԭͼ; height,width->淶Ŀ;
@@ -83,11 +171,21 @@ public:
 
 	/*
 	 * @breif:ƴӴŻalphaŻ
-	 * @prama[in]:leftImg->ƴͼ; rightImg->ƴͼ; dstImg->ƴӺͼ񡪡Ż; 
+	 * @prama[in]:leftImg->ƴͼ; rightImg->ƴͼ; rightMask->ͼЧ; dstImg->ƴӺͼ񡪡Ż; 
 	 * @prama[in]:start->Ż;end->Żյ;debug->ģʽ
 	 * @retval:None
 	 */
-	void seamOpt_alpha(Mat& leftImg, Mat& rightImg,Mat& dstImg, int start, int end, int debug = DEBUGMODE_NORMAL);
+	void seamOpt_alpha(Mat& leftImg, Mat& rightImg, const validMask& rightMask, Mat& dstImg, int start, int end,
+		int debug = DEBUGMODE_NORMAL);
+
+	/*
+	 * @breif:ƴӴŻƴӷȡأƴӷСΧ
+	 * @prama[in]:leftImg->ƴͼ; rightImg->ƴͼ; rightMask->ͼЧ; dstImg->ƴӺͼ񡪡Ż;
+	 * @prama[in]:seamMask->ص(255ȡͼ);start->ص;featherWidth->𻯿;debug->ģʽ
+	 * @retval:None
+	 */
+	void seamOpt_mask(Mat& leftImg, Mat& rightImg, const validMask& rightMask, Mat& dstImg, Mat& seamMask, int start,
+		int featherWidth = SEAMFEATHER, int debug = DEBUGMODE_NORMAL);
 
 	/*
 	 * @breif:ƴӴŻLaplaceŻ
@@ -128,6 +226,27 @@ private:
 	 * @retval:dstImg->ںϵͼ
 	 */
 	Mat imgLaplaceBlend(Mat& imgHighest, vector<Mat> blendLp);
+
+	/*
+	 * @breif:ȡĳһе,ֿڿ֮Բֵ
+	 * @prama[in]:gains->п;row->к;rows->ͼ
+	 * @retval:,δʱΪ1
+	 */
+	float rowGain(const vector<float>& gains, int row, int rows);
+
+	/*
+	 * @breif:ɲұ
+	 * @prama[in]:gain->;lut->256ұ
+	 * @retval:None
+	 */
+	void buildGainLUT(float gain, uchar* lut);
+
+	/*
+	 * @breif:imgPaths뻺,Ԥ㲻ʱ̳߳ϲнȫͼƬ
+	 * @prama[in]:decodeScale->׼׶νű;memBudget->뻺ֽԤ
+	 * @retval:None
+	 */
+	void loadImgs(int decodeScale, size_t memBudget);
 };
 
 #endif // !PREPROCESS_H
@@ -0,0 +1,380 @@
+/*******************************************************************************
+ *
+ * \file    imgStore.cpp
+ * \brief   ͼ⣺¼ͼ·ߴ磬ֽԤLRU棬̨߳Ԥȡ
+ * \author  agent
+ * \version 1.0
+ * \date    2026-10-19
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * -----------------------------------------------------------------------------
+ * ļ޸ʷ
+ * <ʱ>       | <汾>  | <>         |
+ * 2026-10-19  | v1.0    | agent          |
+ * -----------------------------------------------------------------------------
+ ******************************************************************************/
+#include "imgStore.h"
+
+/*===================================================================================*/
+/******************************* к *********************************************/
+/*===================================================================================*/
+
+/*
+ * @breif:졢,ʱֹͣԤȡ߳
+ * @prama[in]:budgetBytes->ֽԤ,0Ϊ
+ */
+imgStore::imgStore(size_t budgetBytes)
+{
+	imgStore::decodeScale = 1;
+	imgStore::budgetBytes = budgetBytes;
+	imgStore::stats = {};
+	imgStore::stopping = false;
+}
+
+imgStore::~imgStore()
+{
+	{
+		lock_guard<mutex> lock(imgStore::storeMutex);
+		imgStore::stopping = true;
+	}
+	imgStore::prefetchCond.notify_all();
+	if (imgStore::prefetchThread.joinable())	imgStore::prefetchThread.join();
+}
+
+/*
+ * @breif:ǼͼƬ·ȡļС,
+ * @prama[in]:paths->ͼƬ·; decodeScale->׼ͼĽű
+ * @retval:None
+ */
+void imgStore::open(const vector<string>& paths, int decodeScale)
+{
+	lock_guard<mutex> lock(imgStore::storeMutex);
+	imgStore::decodeScale = (decodeScale == 2 || decodeScale == 4 || decodeScale == 8) ? decodeScale : 1;
+	imgStore::metas.assign(paths.size(), img_meta());
+	for (size_t i = 0; i < paths.size(); i++)
+	{
+		ifstream file(paths[i], ios::binary | ios::ate);
+		imgStore::metas[i].path = paths[i];
+		imgStore::metas[i].fileBytes = file.is_open() ? (size_t)file.tellg() : 0;
+		imgStore::metas[i].broken = false;
+	}
+	imgStore::entries.assign(paths.size() * STORE_VARIANTNUM, cache_entry());
+	imgStore::lru.clear();
+	imgStore::prefetchQueue.clear();
+	imgStore::stats = {};
+}
+
+/*
+ * @breif:̳߳ϲнȫͼƬ׼ͼ,Ԥ㲻ʱһ
+ * @prama[in]:None
+ * @retval:ɹͼƬ
+ */
+int imgStore::loadAll()
+{
+	int imgNum = (int)imgStore::metas.size();
+	vector<uchar> loaded(imgNum, 0);
+	parallel_for_(Range(0, imgNum), [&](const Range& range)
+	{
+		for (int i = range.start; i < range.end; i++)	loaded[i] = !imgStore::get(i, STORE_VARIANT_REG).empty();
+	});
+	return (int)count(loaded.begin(), loaded.end(), 1);
+}
+
+/*
+ * @breif:ȡһͼĳֽ,δʱڵ߳̽,ɶ̵߳
+ * @prama[in]:idx->ͼƬ; variant->STORE_VARIANT_*
+ * @retval:ͼ,ļڻʧʱΪ
+ */
+Mat imgStore::get(int idx, int variant)
+{
+	if (idx < 0 || idx >= (int)imgStore::metas.size())	return Mat();
+	return imgStore::load(imgStore::keyOf(idx, variant), false);
+}
+
+/*
+ * @breif:ȡԭֱʳߴ,δɫͼʱȽ׼ͼ
+ * @prama[in]:idx->ͼƬ
+ * @retval:ߴ .pix,ȡʧʱΪ
+ */
+Size imgStore::imgSize(int idx)
+{
+	if (idx < 0 || idx >= (int)imgStore::metas.size())	return Size();
+	{
+		lock_guard<mutex> lock(imgStore::storeMutex);
+		if (!imgStore::metas[idx].size.empty())	return imgStore::metas[idx].size;
+	}
+	imgStore::get(idx, STORE_VARIANT_REG);
+	lock_guard<mutex> lock(imgStore::storeMutex);
+	return imgStore::metas[idx].size;
+}
+
+/*
+ * @breif:ͼƬļǷδʧ
+ * @prama[in]:idx->ͼƬ
+ * @retval:true->
+ */
+bool imgStore::isValid(int idx)
+{
+	if (idx < 0 || idx >= (int)imgStore::metas.size())	return false;
+	lock_guard<mutex> lock(imgStore::storeMutex);
+	return imgStore::metas[idx].fileBytes > 0 && !imgStore::metas[idx].broken;
+}
+
+/*
+ * @breif:̨߳ԤȽ,ѻڽ
+ * @prama[in]:idx->ͼƬ; variant->STORE_VARIANT_*
+ * @retval:None
+ */
+void imgStore::prefetch(int idx, int variant)
+{
+	if (idx < 0 || idx >= (int)imgStore::metas.size())	return;
+	int key = imgStore::keyOf(idx, variant);
+	lock_guard<mutex> lock(imgStore::storeMutex);
+	const cache_entry& entry = imgStore::entries[key];
+	if (entry.resident || entry.loading || imgStore::metas[idx].broken || imgStore::metas[idx].fileBytes == 0)	return;
+	if (find(imgStore::prefetchQueue.begin(), imgStore::prefetchQueue.end(), key) != imgStore::prefetchQueue.end())	return;
+	// Խľֵ,ʱȶ
+	if (imgStore::prefetchQueue.size() >= STORE_PREFETCHDEPTH)	imgStore::prefetchQueue.pop_front();
+	imgStore::prefetchQueue.push_back(key);
+	if (!imgStore::prefetchThread.joinable())	imgStore::prefetchThread = thread(&imgStore::prefetchWorker, this);
+	imgStore::prefetchCond.notify_one();
+}
+
+/*
+ * @breif:ͷһͼȫ
+ * @prama[in]:idx->ͼƬ
+ * @retval:None
+ */
+void imgStore::release(int idx)
+{
+	if (idx < 0 || idx >= (int)imgStore::metas.size())	return;
+	lock_guard<mutex> lock(imgStore::storeMutex);
+	for (int variant = 0; variant < STORE_VARIANTNUM; variant++)
+	{
+		int key = idx * STORE_VARIANTNUM + variant;
+		if (imgStore::entries[key].resident)	imgStore::evict(key);
+	}
+}
+
+/*
+ * @breif:òɫͼı任(ͶӰ),ѻĲɫͼ任,Ҷͼͷź󰴱任׼ͼ
+ * @prama[in]:transform->任,Ϊͼԭֱʵű
+ * @note:Ӧڲȡ֮ǰ
+ * @retval:None
+ */
+void imgStore::setTransform(function<void(Mat&, int)> transform)
+{
+	lock_guard<mutex> lock(imgStore::storeMutex);
+	imgStore::transform = transform;
+	for (size_t key = 0; key < imgStore::entries.size(); key++)
+	{
+		cache_entry& entry = imgStore::entries[key];
+		if (!entry.resident)	continue;
+		int idx = (int)key / STORE_VARIANTNUM, variant = (int)key % STORE_VARIANTNUM;
+		if (variant == STORE_VARIANT_GRAY)
+		{
+			imgStore::evict((int)key);
+			continue;
+		}
+		int scale = (variant == STORE_VARIANT_RGB) ? 1 : imgStore::decodeScale;
+		if (transform)	transform(entry.img, scale);
+		imgStore::stats.residentBytes -= entry.bytes;
+		entry.bytes = entry.img.total() * entry.img.elemSize();
+		imgStore::stats.residentBytes += entry.bytes;
+		imgStore::stats.peakBytes = max(imgStore::stats.peakBytes, imgStore::stats.residentBytes);
+		imgStore::metas[idx].size = entry.img.size() * scale;
+	}
+}
+
+/*
+ * @breif:ͳ
+ * @prama[in]:None
+ * @retval:ͳƽ
+ */
+imgStore::store_stats imgStore::getStats()
+{
+	lock_guard<mutex> lock(imgStore::storeMutex);
+	return imgStore::stats;
+}
+/*-----------------------------------------------------------------------------------*/
+
+
+/*===================================================================================*/
+/******************************* ˽к *********************************************/
+/*===================================================================================*/
+
+/*
+ * @breif:ͼƬͶӦĻ,űΪ1ʱ׼ͼԭͼһ
+ * @prama[in]:idx->ͼƬ; variant->STORE_VARIANT_*
+ * @retval:
+ */
+int imgStore::keyOf(int idx, int variant) const
+{
+	if (variant == STORE_VARIANT_REG && imgStore::decodeScale == 1)	variant = STORE_VARIANT_RGB;
+	return idx * STORE_VARIANTNUM + variant;
+}
+
+/*
+ * @breif:ȡ,δʱ뻺;ͬһ߳̽ʱȴ
+ * @prama[in]:key->; isPrefetch->ǷԤȡ̵߳,ԤȡҲȡ˳
+ * @retval:ͼ
+ */
+Mat imgStore::load(int key, bool isPrefetch)
+{
+	int idx = key / STORE_VARIANTNUM;
+	unique_lock<mutex> lock(imgStore::storeMutex);
+	while (true)
+	{
+		cache_entry& entry = imgStore::entries[key];
+		if (entry.resident)
+		{
+			// ѻԤȡȡ˳
+			if (isPrefetch)	return entry.img;
+			imgStore::lru.splice(imgStore::lru.begin(), imgStore::lru, entry.lruPos);
+			imgStore::stats.hitNum++;
+			if (entry.prefetched)	imgStore::stats.prefetchHitNum++;
+			entry.prefetched = false;
+			return entry.img;
+		}
+		if (imgStore::metas[idx].broken || imgStore::metas[idx].fileBytes == 0)	return Mat();
+		if (!entry.loading)	break;
+		imgStore::loadedCond.wait(lock);
+	}
+
+	// ʱ,ȡòӰ
+	imgStore::entries[key].loading = true;
+	if (isPrefetch)	imgStore::stats.prefetchNum++;
+	else			imgStore::stats.missNum++;
+	lock.unlock();
+	Mat img;
+	try
+	{
+		img = imgStore::decode(key, isPrefetch);
+	}
+	catch (...)
+	{
+		lock.lock();
+		imgStore::entries[key].loading = false;
+		imgStore::loadedCond.notify_all();
+		throw;
+	}
+	lock.lock();
+	cache_entry& entry = imgStore::entries[key];
+	entry.loading = false;
+	if (img.empty())
+	{
+		if (!imgStore::metas[idx].broken)	MOSAIC_LOG_WARN("imgStore::load ͼƬʧ:" << imgStore::metas[idx].path);
+		imgStore::metas[idx].broken = true;
+	}
+	else
+	{
+		imgStore::insert(key, img);
+		entry.prefetched = isPrefetch && entry.resident;
+	}
+	imgStore::loadedCond.notify_all();
+	return img;
+}
+
+/*
+ * @breif:뻺Ӧͼ,Ҷͼ׼ͼת,ɫͼʩӱ任³ߴ
+ * @prama[in]:key->; isPrefetch->ǷԤȡ̵߳
+ * @retval:ͼ,ʧʱΪ
+ */
+Mat imgStore::decode(int key, bool isPrefetch)
+{
+	int idx = key / STORE_VARIANTNUM, variant = key % STORE_VARIANTNUM;
+	if (variant == STORE_VARIANT_GRAY)
+	{
+		Mat regImg = imgStore::load(imgStore::keyOf(idx, STORE_VARIANT_REG), isPrefetch), grayImg;
+		if (!regImg.empty())	cvtColor(regImg, grayImg, COLOR_RGB2GRAY);
+		return grayImg;
+	}
+
+	// ű1ʱʹIMREAD_REDUCED_COLOR_*ֱڽʱ
+	int scale = (variant == STORE_VARIANT_RGB) ? 1 : imgStore::decodeScale;
+	int flag = IMREAD_COLOR;
+	if (scale == 2)			flag = IMREAD_REDUCED_COLOR_2;
+	else if (scale == 4)	flag = IMREAD_REDUCED_COLOR_4;
+	else if (scale == 8)	flag = IMREAD_REDUCED_COLOR_8;
+	unique_lock<mutex> lock(imgStore::storeMutex);
+	string path = imgStore::metas[idx].path;
+	function<void(Mat&, int)> transform = imgStore::transform;
+	lock.unlock();
+	Mat img = imread(path, flag);
+	if (img.empty())	return img;
+	if (transform)	transform(img, scale);
+
+	// ԭͼߴ,ֱʽʱscale-1
+	lock.lock();
+	if (scale == 1 || imgStore::metas[idx].size.empty())	imgStore::metas[idx].size = img.size() * scale;
+	return img;
+}
+
+/*
+ * @breif:뻺,ԤʱLRUβ̭;Ԥʱ,storeMutex
+ * @prama[in]:key->; img->ͼ
+ * @retval:None
+ */
+void imgStore::insert(int key, const Mat& img)
+{
+	size_t bytes = img.total() * img.elemSize();
+	if (imgStore::budgetBytes > 0 && bytes > imgStore::budgetBytes)	return;
+	while (imgStore::budgetBytes > 0 && imgStore::stats.residentBytes + bytes > imgStore::budgetBytes && !imgStore::lru.empty())
+	{
+		imgStore::evict(imgStore::lru.back());
+		imgStore::stats.evictNum++;
+	}
+	cache_entry& entry = imgStore::entries[key];
+	entry.img = img;
+	entry.bytes = bytes;
+	entry.resident = true;
+	imgStore::lru.push_front(key);
+	entry.lruPos = imgStore::lru.begin();
+	imgStore::stats.residentBytes += bytes;
+	imgStore::stats.peakBytes = max(imgStore::stats.peakBytes, imgStore::stats.residentBytes);
+}
+
+/*
+ * @breif:Ƴ,storeMutex
+ * @prama[in]:key->
+ * @retval:None
+ */
+void imgStore::evict(int key)
+{
+	cache_entry& entry = imgStore::entries[key];
+	imgStore::lru.erase(entry.lruPos);
+	imgStore::stats.residentBytes -= entry.bytes;
+	entry.img.release();
+	entry.bytes = 0;
+	entry.resident = false;
+	entry.prefetched = false;
+}
+
+/*
+ * @breif:Ԥȡ߳,˳ֱֹͣ
+ * @prama[in]:None
+ * @retval:None
+ */
+void imgStore::prefetchWorker()
+{
+	unique_lock<mutex> lock(imgStore::storeMutex);
+	while (true)
+	{
+		imgStore::prefetchCond.wait(lock, [&]() { return imgStore::stopping || !imgStore::prefetchQueue.empty(); });
+		if (imgStore::stopping)	return;
+		int key = imgStore::prefetchQueue.front();
+		imgStore::prefetchQueue.pop_front();
+		lock.unlock();
+		// ԤȡʧܲӰ,ȡʱڵ߳ԲõͬĽ
+		try
+		{
+			imgStore::load(key, true);
+		}
+		catch (const exception& e)
+		{
+			MOSAIC_LOG_WARN("imgStore::prefetchWorker Ԥȡʧ:" << e.what());
+		}
+		lock.lock();
+	}
+}
@@ -0,0 +1,216 @@
+/*******************************************************************************
+ *
+ * \file    imgStore.h
+ * \brief   ͼ⣺¼ͼ·ߴ磬ֽԤLRU棬̨߳Ԥȡ
+ * \author  agent
+ * \version 1.0
+ * \date    2026-10-19
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * -----------------------------------------------------------------------------
+ * ļ޸ʷ
+ * <ʱ>       | <汾>  | <>         |
+ * 2026-10-19  | v1.0    | agent          |
+ * -----------------------------------------------------------------------------
+ ******************************************************************************/
+#include <opencv2/imgproc/imgproc.hpp>
+#include <opencv2/imgcodecs.hpp>
+#include "publicElement.h"
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <list>
+#include <deque>
+#include <algorithm>
+#include <string>
+#include <functional>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+using namespace cv;
+using namespace std;
+
+/*===================================================================================*/
+/******************************** 궨 *********************************************/
+/*===================================================================================*/
+#define STORE_VARIANT_RGB			0							// ԭֱʲɫͼ
+#define STORE_VARIANT_REG			1							// ׼ֱʲɫͼ,ʱֱӽ
+#define STORE_VARIANT_GRAY			2							// ׼ֱʻҶͼ,׼ͼת
+#define STORE_VARIANTNUM			3							// ÿͼĻ
+#define STORE_PREFETCHDEPTH			4							// Ԥȡ,ʱ
+/*-----------------------------------------------------------------------------------*/
+
+#pragma once
+#ifndef IMGSTORE_H
+#define IMGSTORE_H
+
+/*
+ * ÿͼֽռһ,ȡ˳,Ԥʱδõһ̭
+ * ȡ÷Matͷ,ֻ̭ͷſڵ,߳еͼͷǰȻЧ,
+ * ˷ֵڴΪԤϵͬʱеͼͬһ߳ͬʱȡʱֻһΡ
+ */
+class imgStore
+{
+public:
+	typedef struct
+	{
+		string path;								// ͼƬ·
+		size_t fileBytes;							// ļֽ,0ʾļ
+		Size size;									// ԭֱʳߴ .pix,״νõ,ֱʽʱ׼ͼߴ绻
+		bool broken;								// ʧ,֮ȡֱӷؿͼ
+	}img_meta;
+
+	typedef struct
+	{
+		size_t hitNum;								// д
+		size_t missNum;								// δ(ͬ)
+		size_t evictNum;							// ̭
+		size_t prefetchNum;							// Ԥȡ
+		size_t prefetchHitNum;						// ԤȡȡõĴ
+		size_t residentBytes;						// ǰֽ
+		size_t peakBytes;							// ֵֽ
+	}store_stats;
+
+	vector<img_meta> metas;							// ͼ·ߴ
+	int decodeScale;								// ׼ͼĽű,1248
+	size_t budgetBytes;								// ֽԤ,0Ϊ
+
+public:
+	/*
+	 * @breif:졢,ʱֹͣԤȡ߳
+	 * @prama[in]:budgetBytes->ֽԤ,0Ϊ
+	 */
+	imgStore(size_t budgetBytes = 0);
+	~imgStore();
+
+	/*
+	 * @breif:ǼͼƬ·ȡļС,
+	 * @prama[in]:paths->ͼƬ·; decodeScale->׼ͼĽű
+	 * @retval:None
+	 */
+	void open(const vector<string>& paths, int decodeScale);
+
+	/*
+	 * @breif:̳߳ϲнȫͼƬ׼ͼ,Ԥ㲻ʱһ
+	 * @prama[in]:None
+	 * @retval:ɹͼƬ
+	 */
+	int loadAll();
+
+	/*
+	 * @breif:ȡһͼĳֽ,δʱڵ߳̽,ɶ̵߳
+	 * @prama[in]:idx->ͼƬ; variant->STORE_VARIANT_*
+	 * @retval:ͼ,ļڻʧʱΪ
+	 */
+	Mat get(int idx, int variant);
+
+	/*
+	 * @breif:ȡԭֱʳߴ,δɫͼʱȽ׼ͼ
+	 * @prama[in]:idx->ͼƬ
+	 * @retval:ߴ .pix,ȡʧʱΪ
+	 */
+	Size imgSize(int idx);
+
+	/*
+	 * @breif:ͼƬļǷδʧ
+	 * @prama[in]:idx->ͼƬ
+	 * @retval:true->
+	 */
+	bool isValid(int idx);
+
+	/*
+	 * @breif:̨߳ԤȽ,ѻڽ
+	 * @prama[in]:idx->ͼƬ; variant->STORE_VARIANT_*
+	 * @retval:None
+	 */
+	void prefetch(int idx, int variant);
+
+	/*
+	 * @breif:ͷһͼȫ
+	 * @prama[in]:idx->ͼƬ
+	 * @retval:None
+	 */
+	void release(int idx);
+
+	/*
+	 * @breif:òɫͼı任(ͶӰ),ѻĲɫͼ任,Ҷͼͷź󰴱任׼ͼ
+	 * @prama[in]:transform->任,Ϊͼԭֱʵű
+	 * @note:Ӧڲȡ֮ǰ
+	 * @retval:None
+	 */
+	void setTransform(function<void(Mat&, int)> transform);
+
+	/*
+	 * @breif:ͳ
+	 * @prama[in]:None
+	 * @retval:ͳƽ
+	 */
+	store_stats getStats();
+
+private:
+	typedef struct
+	{
+		Mat img;									// ͼ
+		size_t bytes;								// ͼֽ
+		bool resident;								// Ƿڻ
+		bool loading;								// Ƿڽ
+		bool prefetched;							// Ԥȡδȡ
+		list<int>::iterator lruPos;					// LRUеλ
+	}cache_entry;
+
+	vector<cache_entry> entries;					// idx*STORE_VARIANTNUM+variant
+	list<int> lru;									// ,ͷΪȡ
+	function<void(Mat&, int)> transform;			// ɫͼı任
+	store_stats stats;								// ͳ
+	mutex storeMutex;								// LRUͳ
+	condition_variable loadedCond;					// ĳ
+	deque<int> prefetchQueue;						// ԤȡĻ
+	condition_variable prefetchCond;				// Ԥȡзǿջֹͣ
+	thread prefetchThread;							// Ԥȡ߳,״Ԥȡʱ
+	bool stopping;									// ֪ͨԤȡ߳˳
+
+	/*
+	 * @breif:ͼƬͶӦĻ,űΪ1ʱ׼ͼԭͼһ
+	 * @prama[in]:idx->ͼƬ; variant->STORE_VARIANT_*
+	 * @retval:
+	 */
+	int keyOf(int idx, int variant) const;
+
+	/*
+	 * @breif:ȡ,δʱ뻺;ͬһ߳̽ʱȴ
+	 * @prama[in]:key->; isPrefetch->ǷԤȡ̵߳,ԤȡҲȡ˳
+	 * @retval:ͼ
+	 */
+	Mat load(int key, bool isPrefetch);
+
+	/*
+	 * @breif:뻺Ӧͼ,Ҷͼ׼ͼת,ɫͼʩӱ任³ߴ
+	 * @prama[in]:key->; isPrefetch->ǷԤȡ̵߳
+	 * @retval:ͼ,ʧʱΪ
+	 */
+	Mat decode(int key, bool isPrefetch);
+
+	/*
+	 * @breif:뻺,ԤʱLRUβ̭;Ԥʱ,storeMutex
+	 * @prama[in]:key->; img->ͼ
+	 * @retval:None
+	 */
+	void insert(int key, const Mat& img);
+
+	/*
+	 * @breif:Ƴ,storeMutex
+	 * @prama[in]:key->
+	 * @retval:None
+	 */
+	void evict(int key);
+
+	/*
+	 * @breif:Ԥȡ߳,˳ֱֹͣ
+	 * @prama[in]:None
+	 * @retval:None
+	 */
+	void prefetchWorker();
+};
+
+#endif // !IMGSTORE_H
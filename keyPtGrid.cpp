@@ -0,0 +1,126 @@
+/*******************************************************************************
+ *
+ * \file    keyPtGrid.cpp
+ * \brief   ؼռ񣺰꽫ؼͰֻλڽеĵ㣬ƥʹ
+ * \author  agent
+ * \version 1.0
+ * \date    2026-10-19
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * -----------------------------------------------------------------------------
+ * ļ޸ʷ
+ * <ʱ>       | <汾>  | <>         |
+ * 2026-10-19  | v1.0    | agent          |
+ * -----------------------------------------------------------------------------
+ ******************************************************************************/
+#include "keyPtGrid.h"
+
+/*===================================================================================*/
+/******************************* к *********************************************/
+/*===================================================================================*/
+
+/*
+ * @breif:캯
+ */
+keyPtGrid::keyPtGrid()
+{
+	keyPtGrid::cellSize = GRID_MINCELL;
+	keyPtGrid::origin = Point2f(0, 0);
+	keyPtGrid::gridCols = keyPtGrid::gridRows = 0;
+}
+
+/*
+ * @breif:ؼͰ
+ * @prama[in]:keyPoint->ؼ; cellSize->߳ .pix,СGRID_MINCELLʱȡGRID_MINCELL
+ * @retval:None
+ */
+void keyPtGrid::build(const vector<KeyPoint>& keyPoint, float cellSize)
+{
+	keyPtGrid::cellSize = max(cellSize, (float)GRID_MINCELL);
+	keyPtGrid::points.resize(keyPoint.size());
+	float minX = 0, minY = 0, maxX = 0, maxY = 0;
+	for (size_t i = 0; i < keyPoint.size(); i++)
+	{
+		const Point2f& p = keyPoint[i].pt;
+		keyPtGrid::points[i] = p;
+		if (i == 0 || p.x < minX)	minX = p.x;
+		if (i == 0 || p.y < minY)	minY = p.y;
+		if (i == 0 || p.x > maxX)	maxX = p.x;
+		if (i == 0 || p.y > maxY)	maxY = p.y;
+	}
+	keyPtGrid::origin = Point2f(minX, minY);
+	keyPtGrid::gridCols = (int)((maxX - minX) / keyPtGrid::cellSize) + 1;
+	keyPtGrid::gridRows = (int)((maxY - minY) / keyPtGrid::cellSize) + 1;
+
+	// һ,ǰ׺͵õ,ڶ
+	int cellNum = keyPtGrid::gridCols * keyPtGrid::gridRows;
+	keyPtGrid::cellStart.assign(cellNum + 1, 0);
+	vector<int> pointCell(keyPoint.size());
+	for (size_t i = 0; i < keyPoint.size(); i++)
+	{
+		pointCell[i] = keyPtGrid::cellRow(keyPtGrid::points[i].y) * keyPtGrid::gridCols + keyPtGrid::cellCol(keyPtGrid::points[i].x);
+		keyPtGrid::cellStart[pointCell[i] + 1]++;
+	}
+	for (int c = 0; c < cellNum; c++)	keyPtGrid::cellStart[c + 1] += keyPtGrid::cellStart[c];
+	vector<int> fillPos(keyPtGrid::cellStart.begin(), keyPtGrid::cellStart.end() - 1);
+	keyPtGrid::cellItems.resize(keyPoint.size());
+	for (size_t i = 0; i < keyPoint.size(); i++)	keyPtGrid::cellItems[fillPos[pointCell[i]]++] = (int)i;
+}
+
+/*
+ * @breif:λþ벻뾶Ĺؼ
+ * @prama[in]:center->λ; radius->뾶 .pix; candidates->Ĺؼ,
+ * @retval:None
+ */
+void keyPtGrid::query(Point2f center, float radius, vector<int>& candidates) const
+{
+	candidates.clear();
+	if (keyPtGrid::cellItems.empty())	return;
+	// Χཻʱֱӷ,ضϺԵ
+	if (center.x + radius < keyPtGrid::origin.x || center.y + radius < keyPtGrid::origin.y ||
+		center.x - radius > keyPtGrid::origin.x + keyPtGrid::gridCols * keyPtGrid::cellSize ||
+		center.y - radius > keyPtGrid::origin.y + keyPtGrid::gridRows * keyPtGrid::cellSize)
+		return;
+
+	float radiusSqr = radius * radius;
+	int colBegin = keyPtGrid::cellCol(center.x - radius), colEnd = keyPtGrid::cellCol(center.x + radius);
+	int rowBegin = keyPtGrid::cellRow(center.y - radius), rowEnd = keyPtGrid::cellRow(center.y + radius);
+	for (int r = rowBegin; r <= rowEnd; r++)
+	{
+		for (int c = colBegin; c <= colEnd; c++)
+		{
+			int cell = r * keyPtGrid::gridCols + c;
+			for (int k = keyPtGrid::cellStart[cell]; k < keyPtGrid::cellStart[cell + 1]; k++)
+			{
+				int idx = keyPtGrid::cellItems[k];
+				Point2f d = keyPtGrid::points[idx] - center;
+				if (d.x * d.x + d.y * d.y <= radiusSqr)	candidates.push_back(idx);
+			}
+		}
+	}
+}
+/*-----------------------------------------------------------------------------------*/
+
+
+/*===================================================================================*/
+/******************************* ˽к *********************************************/
+/*===================================================================================*/
+
+/*
+ * @breif:ڸк,ʱضϵԵ
+ * @prama[in]:x,y->
+ * @retval:кšк
+ */
+int keyPtGrid::cellCol(float x) const
+{
+	int col = (int)floor((x - keyPtGrid::origin.x) / keyPtGrid::cellSize);
+	return cmpMin(cmpMax(col, 0), keyPtGrid::gridCols - 1);
+}
+
+int keyPtGrid::cellRow(float y) const
+{
+	int row = (int)floor((y - keyPtGrid::origin.y) / keyPtGrid::cellSize);
+	return cmpMin(cmpMax(row, 0), keyPtGrid::gridRows - 1);
+}
+/*-----------------------------------------------------------------------------------*/
@@ -0,0 +1,79 @@
+/*******************************************************************************
+ *
+ * \file    keyPtGrid.h
+ * \brief   ؼռ񣺰꽫ؼͰֻλڽеĵ㣬ƥʹ
+ * \author  agent
+ * \version 1.0
+ * \date    2026-10-19
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * -----------------------------------------------------------------------------
+ * ļ޸ʷ
+ * <ʱ>       | <汾>  | <>         |
+ * 2026-10-19  | v1.0    | agent          |
+ * -----------------------------------------------------------------------------
+ ******************************************************************************/
+#include <opencv2/core.hpp>
+#include <opencv2/features2d.hpp>
+#include "publicElement.h"
+#include <vector>
+using namespace cv;
+using namespace std;
+
+/*===================================================================================*/
+/******************************** 궨 *********************************************/
+/*===================================================================================*/
+#define GRID_MINCELL				4							// С߳ .pix
+/*-----------------------------------------------------------------------------------*/
+
+#pragma once
+#ifndef KEYPTGRID_H
+#define KEYPTGRID_H
+
+/*
+ * ĵ(cellStart[c]cellStart[c+1]),ֻ,ʱڴ档
+ * 񸲸ȫؼİΧ,߳ͨȡ뾶,һֻ3x3
+ */
+class keyPtGrid
+{
+public:
+	float cellSize;									// ߳ .pix
+	Point2f origin;									// Ͻ
+	int gridCols, gridRows;							// 
+
+public:
+	/*
+	 * @breif:캯
+	 */
+	keyPtGrid();
+
+	/*
+	 * @breif:ؼͰ
+	 * @prama[in]:keyPoint->ؼ; cellSize->߳ .pix,СGRID_MINCELLʱȡGRID_MINCELL
+	 * @retval:None
+	 */
+	void build(const vector<KeyPoint>& keyPoint, float cellSize);
+
+	/*
+	 * @breif:λþ벻뾶Ĺؼ
+	 * @prama[in]:center->λ; radius->뾶 .pix; candidates->Ĺؼ,
+	 * @retval:None
+	 */
+	void query(Point2f center, float radius, vector<int>& candidates) const;
+
+private:
+	vector<int> cellStart;							// ׸cellItemsеλ,+1
+	vector<int> cellItems;							// еĹؼ
+	vector<Point2f> points;							// ؼ,ʱȷжϾ
+
+	/*
+	 * @breif:ڸк,ʱضϵԵ
+	 * @prama[in]:x,y->
+	 * @retval:кšк
+	 */
+	int cellCol(float x) const;
+	int cellRow(float y) const;
+};
+
+#endif // !KEYPTGRID_H
@@ -22,6 +22,15 @@
 
 int main(int argc, char* argv[])
 {
+    // 大块Mat内存经内存池复用,连续拼接时不反复向系统申请
+    matPool::install();
+
+    // 带参数时进入批处理模式,可在无界面的渲染节点上运行
+    if (argc > 1)   return batchMosaic(argc, argv);
+#ifdef MOSAIC_HEADLESS
+    printBatchUsage();
+    return 1;
+#else
     imgProcess imgProcessHandle("src\\imgfile.txt");        //加载图片
     Mat tempImgMosaic, tempImgHomo, dstImg;
 
@@ -29,7 +38,7 @@ int main(int argc, char* argv[])
 
     while (true)
     {
-        cout << "请输入图像拼接的模式：1-SIFT, 2-ORB, 3-BRISK, 4-SURF, 0-QUIT" << endl;
+        cout << "请输入图像拼接的模式：1-SIFT, 2-ORB, 3-BRISK, 4-SURF, 5-渐进式(SIFT), 6-无序(SIFT), 0-QUIT" << endl;
         cin >> mode;
 
         if (mode == 1)
@@ -39,12 +48,16 @@ int main(int argc, char* argv[])
             /*===================================================================================*/
             /******************************** 基于SIFT的图像拼接 ************************************/
             /*===================================================================================*/
-            tempImgMosaic = imageMosaic(imgProcessHandle, imgProcessHandle.RGBImgs[1],
-                imgProcessHandle.RGBImgs[2], SIFTDETECT, MATCHMODE_MINMAX, DEBUGMODE_SHOW);
-            tempImgHomo = imageMosaic(imgProcessHandle, imgProcessHandle.RGBImgs[0],
-                tempImgMosaic, SIFTDETECT, MATCHMODE_MINMAX, DEBUGMODE_GETHOMO);
-            tempImgMosaic = imageMosaic(imgProcessHandle, imgProcessHandle.RGBImgs[0],
-                tempImgMosaic, SIFTDETECT, MATCHMODE_MINMAX, DEBUGMODE_SHOW);
+            validMask mosaicMask;                           // 已拼接部分的有效像素掩码
+            tempImgMosaic = imageMosaic(imgProcessHandle, imgProcessHandle.getRGBImg(1),
+                imgProcessHandle.getRGBImg(2), SIFTDETECT, MATCHMODE_MINMAX, DEBUGMODE_SHOW,
+                nullptr, nullptr, nullptr, &mosaicMask);
+            tempImgHomo = imageMosaic(imgProcessHandle, imgProcessHandle.getRGBImg(0),
+                tempImgMosaic, SIFTDETECT, MATCHMODE_MINMAX, DEBUGMODE_GETHOMO,
+                nullptr, nullptr, nullptr, &mosaicMask);
+            tempImgMosaic = imageMosaic(imgProcessHandle, imgProcessHandle.getRGBImg(0),
+                tempImgMosaic, SIFTDETECT, MATCHMODE_MINMAX, DEBUGMODE_SHOW,
+                nullptr, nullptr, nullptr, &mosaicMask);
             imgProcessHandle.seamOpt_laplace(tempImgHomo, tempImgMosaic, dstImg, 0.35, DEBUGMODE_NORMAL);
 
             imshow("图像拼接", dstImg);
@@ -57,12 +70,16 @@ int main(int argc, char* argv[])
             /*===================================================================================*/
             /******************************** 基于ORB的图像拼接 ************************************/
             /*===================================================================================*/
-            tempImgMosaic = imageMosaic(imgProcessHandle, imgProcessHandle.RGBImgs[1],
-                imgProcessHandle.RGBImgs[2], ORBDETECT, MATCHMODE_MINMAX, DEBUGMODE_SHOW);
-            tempImgHomo = imageMosaic(imgProcessHandle, imgProcessHandle.RGBImgs[0],
-                tempImgMosaic, ORBDETECT, MATCHMODE_MINMAX, DEBUGMODE_GETHOMO);
-            tempImgMosaic = imageMosaic(imgProcessHandle, imgProcessHandle.RGBImgs[0],
-                tempImgMosaic, ORBDETECT, MATCHMODE_MINMAX, DEBUGMODE_SHOW);
+            validMask mosaicMask;                           // 已拼接部分的有效像素掩码
+            tempImgMosaic = imageMosaic(imgProcessHandle, imgProcessHandle.getRGBImg(1),
+                imgProcessHandle.getRGBImg(2), ORBDETECT, MATCHMODE_MINMAX, DEBUGMODE_SHOW,
+                nullptr, nullptr, nullptr, &mosaicMask);
+            tempImgHomo = imageMosaic(imgProcessHandle, imgProcessHandle.getRGBImg(0),
+                tempImgMosaic, ORBDETECT, MATCHMODE_MINMAX, DEBUGMODE_GETHOMO,
+                nullptr, nullptr, nullptr, &mosaicMask);
+            tempImgMosaic = imageMosaic(imgProcessHandle, imgProcessHandle.getRGBImg(0),
+                tempImgMosaic, ORBDETECT, MATCHMODE_MINMAX, DEBUGMODE_SHOW,
+                nullptr, nullptr, nullptr, &mosaicMask);
             imgProcessHandle.seamOpt_laplace(tempImgHomo, tempImgMosaic, dstImg, 0.35, DEBUGMODE_NORMAL);
             /*-----------------------------------------------------------------------------------*/
 
@@ -76,12 +93,16 @@ int main(int argc, char* argv[])
             /*===================================================================================*/
             /******************************** 基于BRISK的图像拼接 **********************************/
             /*===================================================================================*/
-            tempImgMosaic = imageMosaic(imgProcessHandle, imgProcessHandle.RGBImgs[1],
-                imgProcessHandle.RGBImgs[2], BRISKDETECT, MATCHMODE_MINMAX, DEBUGMODE_SHOW);
-            tempImgHomo = imageMosaic(imgProcessHandle, imgProcessHandle.RGBImgs[0],
-                tempImgMosaic, BRISKDETECT, MATCHMODE_MINMAX, DEBUGMODE_GETHOMO);
-            tempImgMosaic = imageMosaic(imgProcessHandle, imgProcessHandle.RGBImgs[0],
-                tempImgMosaic, BRISKDETECT, MATCHMODE_MINMAX, DEBUGMODE_SHOW);
+            validMask mosaicMask;                           // 已拼接部分的有效像素掩码
+            tempImgMosaic = imageMosaic(imgProcessHandle, imgProcessHandle.getRGBImg(1),
+                imgProcessHandle.getRGBImg(2), BRISKDETECT, MATCHMODE_MINMAX, DEBUGMODE_SHOW,
+                nullptr, nullptr, nullptr, &mosaicMask);
+            tempImgHomo = imageMosaic(imgProcessHandle, imgProcessHandle.getRGBImg(0),
+                tempImgMosaic, BRISKDETECT, MATCHMODE_MINMAX, DEBUGMODE_GETHOMO,
+                nullptr, nullptr, nullptr, &mosaicMask);
+            tempImgMosaic = imageMosaic(imgProcessHandle, imgProcessHandle.getRGBImg(0),
+                tempImgMosaic, BRISKDETECT, MATCHMODE_MINMAX, DEBUGMODE_SHOW,
+                nullptr, nullptr, nullptr, &mosaicMask);
             imgProcessHandle.seamOpt_laplace(tempImgHomo, tempImgMosaic, dstImg, 0.35, DEBUGMODE_NORMAL);
             /*-----------------------------------------------------------------------------------*/
 
@@ -95,17 +116,74 @@ int main(int argc, char* argv[])
             /*===================================================================================*/
             /******************************** 基于SURF的图像拼接 ************************************/
             /*===================================================================================*/
-            tempImgMosaic = imageMosaic(imgProcessHandle, imgProcessHandle.RGBImgs[1],
-                imgProcessHandle.RGBImgs[2], SURFDETECT, MATCHMODE_MINMAX, DEBUGMODE_SHOW);
-            tempImgHomo = imageMosaic(imgProcessHandle, imgProcessHandle.RGBImgs[0],
-                tempImgMosaic, SURFDETECT, MATCHMODE_MINMAX, DEBUGMODE_GETHOMO);
-            tempImgMosaic = imageMosaic(imgProcessHandle, imgProcessHandle.RGBImgs[0],
-                tempImgMosaic, SURFDETECT, MATCHMODE_MINMAX, DEBUGMODE_SHOW);
+            validMask mosaicMask;                           // 已拼接部分的有效像素掩码
+            tempImgMosaic = imageMosaic(imgProcessHandle, imgProcessHandle.getRGBImg(1),
+                imgProcessHandle.getRGBImg(2), SURFDETECT, MATCHMODE_MINMAX, DEBUGMODE_SHOW,
+                nullptr, nullptr, nullptr, &mosaicMask);
+            tempImgHomo = imageMosaic(imgProcessHandle, imgProcessHandle.getRGBImg(0),
+                tempImgMosaic, SURFDETECT, MATCHMODE_MINMAX, DEBUGMODE_GETHOMO,
+                nullptr, nullptr, nullptr, &mosaicMask);
+            tempImgMosaic = imageMosaic(imgProcessHandle, imgProcessHandle.getRGBImg(0),
+                tempImgMosaic, SURFDETECT, MATCHMODE_MINMAX, DEBUGMODE_SHOW,
+                nullptr, nullptr, nullptr, &mosaicMask);
             imgProcessHandle.seamOpt_laplace(tempImgHomo, tempImgMosaic, dstImg, 0.35, DEBUGMODE_NORMAL);
 
             imshow("图像拼接", dstImg);
             waitKey(0);
         }
+        else if (mode == 5)
+        {
+            cout << "渐进式图像拼接结果如下 :" << endl;
+
+            /*===================================================================================*/
+            /******************************** 先预览后精修的图像拼接 *********************************/
+            /*===================================================================================*/
+            // 精修瓦片在后台线程回调,经加锁队列交给本线程按预览比例贴回
+            mutex tileMutex;
+            vector<pair<Rect, Mat>> tileQueue;
+            double previewScale = 0;
+            future<bool> refined = imageMosaicProgressive(imgProcessHandle, SIFTDETECT, MATCHMODE_MINMAX,
+                "mosaic_cache.bin", "mosaic_progressive.tif",
+                [&](const Mat& previewImg, double scale) { dstImg = previewImg.clone(); previewScale = scale; },
+                [&](Rect tileRect, const Mat& tileImg)
+                {
+                    lock_guard<mutex> lock(tileMutex);
+                    tileQueue.emplace_back(tileRect, tileImg.clone());
+                });
+            if (!dstImg.empty())    imshow("图像拼接", dstImg);
+            while (refined.wait_for(chrono::milliseconds(30)) != future_status::ready)
+            {
+                vector<pair<Rect, Mat>> tiles;
+                {
+                    lock_guard<mutex> lock(tileMutex);
+                    tiles.swap(tileQueue);
+                }
+                for (auto& tile : tiles)
+                {
+                    if (dstImg.empty())     break;
+                    Size scaledSize(cmpMax(cvRound(tile.first.width * previewScale), 1), cmpMax(cvRound(tile.first.height * previewScale), 1));
+                    Rect dstRect(Point(cvRound(tile.first.x * previewScale), cvRound(tile.first.y * previewScale)), scaledSize);
+                    Rect validRect = dstRect & Rect(0, 0, dstImg.cols, dstImg.rows);
+                    if (validRect.empty())  continue;
+                    Mat scaledTile;
+                    resize(tile.second, scaledTile, scaledSize, 0, 0, INTER_AREA);
+                    scaledTile(validRect - dstRect.tl()).copyTo(dstImg(validRect));
+                }
+                if (!dstImg.empty())    imshow("图像拼接", dstImg);
+                waitKey(1);
+            }
+            cout << (refined.get() ? "精修完成,结果已写入mosaic_progressive.tif" : "精修失败") << endl;
+            waitKey(0);
+        }
+        else if (mode == 6)
+        {
+            /*===================================================================================*/
+            /****************************** 基于SIFT的无序图像集拼接 ********************************/
+            /*===================================================================================*/
+            bool success = imageMosaicUnordered(imgProcessHandle, SIFTDETECT, MATCHMODE_ANN,
+                "mosaic_cache.bin", "mosaic_unordered.tif");
+            cout << (success ? "拼接完成,结果已写入mosaic_unordered.tif" : "无序拼接失败") << endl;
+        }
         else if (mode == 0)
             break;
         else
@@ -113,6 +191,7 @@ int main(int argc, char* argv[])
     }
 
     return 0;
+#endif
 }
 
 
@@ -20,99 +20,1296 @@
 #include "homoEstimation.h"
 #include "featureDesc.h"
 #include "featureMatch.h"
+#include "mosaicPipeline.h"
+#include "tiledCanvas.h"
+#include "rigCalib.h"
+#include "seamFinder.h"
+#include "mosaicStats.h"
+#include "mosaicWorkspace.h"
+#include "matPool.h"
+#include "projWarper.h"
+#include "bundleAdjust.h"
+#include "vocabTree.h"
+#include "stageExecutor.h"
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <chrono>
+#include <sstream>
+#include <future>
+#include <functional>
+
+/*===================================================================================*/
+/******************************** 궨 *********************************************/
+/*===================================================================================*/
+#define PREVIEW_IMGWIDTH          320                   // ʽԤÿͼ׼ӳĿ .pix
+#define PREVIEW_KEYPOINTS         300                   // ʽԤÿͼORB
+/*-----------------------------------------------------------------------------------*/
 
 #pragma once
 #ifndef MAIN_H
 #define MAIN_H
 
+/*
+ * @breif:⡢ƥ(Ҷͼ)
+ * @prama[in]:grayImgLeft->ƴͼĻҶͼ;grayImgRight->ƴͼĻҶͼ;detectMode->ģʽ;matchType->ƥ
+ * @prama[in]:keyPtLeft,keyPtRight->ҹؼ;goodMatchPt->ƥ
+ * @prama[in]:goodPtLeft,goodPtRight->ƥ
+ * @prama[in]:stats->ͳ,¼⡢ƥʱ㡢ƥ(Ϊͳ)
+ * @prama[in]:keyPtBudget->ÿͼ,0Ϊ
+ * @prama[in]:guidedRadius->ƥļ뾶 .pix,0Ϊƥ
+ * @retval:None
+ */
+inline void featureRegister_Gray(Mat& grayImgLeft, Mat& grayImgRight, int detectMode, int matchType, vector<KeyPoint>& keyPtLeft,
+    vector<KeyPoint>& keyPtRight, vector<DMatch>& goodMatchPt, vector<Point2f>& goodPtLeft, vector<Point2f>& goodPtRight,
+    mosaicStats* stats = nullptr, int keyPtBudget = 0, float guidedRadius = 0)
+{
+    // ƥֵˮڱȷ
+    bool isKnown = pipelineDispatch(detectMode, matchType, [&](auto pipeline)
+    {
+        pipeline.featureRegister(grayImgLeft, grayImgRight, keyPtLeft, keyPtRight, goodMatchPt, goodPtLeft, goodPtRight, stats,
+            keyPtBudget, guidedRadius);
+    });
+    if (!isKnown)   MOSAIC_LOG_ERROR("featureRegister_Gray δ֪ļģʽ:" << detectMode);
+}
+
+/*
+ * @breif:⡢ƥ
+ * @prama[in]:leftImg->ƴӵͼ;rightImg->ƴӵͼ;detectMode->ģʽ;matchType->ƥ
+ * @prama[in]:keyPtLeft,keyPtRight->ҹؼ;goodMatchPt->ƥ
+ * @prama[in]:goodPtLeft,goodPtRight->ƥ
+ * @prama[in]:stats->ͳ(Ϊͳ);keyPtBudget->ÿͼ,0Ϊ
+ * @prama[in]:guidedRadius->ƥļ뾶 .pix,0Ϊƥ
+ * @retval:None
+ */
+inline void featureRegister(Mat& leftImg, Mat& rightImg, int detectMode, int matchType, vector<KeyPoint>& keyPtLeft,
+    vector<KeyPoint>& keyPtRight, vector<DMatch>& goodMatchPt, vector<Point2f>& goodPtLeft, vector<Point2f>& goodPtRight,
+    mosaicStats* stats = nullptr, int keyPtBudget = 0, float guidedRadius = 0)
+{
+    Mat grayImgLeft, grayImgRight;                          // Ҷͼ
+    auto timeBegin = chrono::steady_clock::now();
+    cvtColor(leftImg, grayImgLeft, COLOR_RGB2GRAY);
+    cvtColor(rightImg, grayImgRight, COLOR_RGB2GRAY);
+    if (stats != nullptr)   stats->grayMs += mosaicStats::elapsedMs(timeBegin);
+    featureRegister_Gray(grayImgLeft, grayImgRight, detectMode, matchType, keyPtLeft, keyPtRight, goodMatchPt,
+        goodPtLeft, goodPtRight, stats, keyPtBudget, guidedRadius);
+}
+
+/*
+ * @breif:ͼƬ׼,ʹþл׼ֱʻҶͼ,ƥ㻻㵽ԭֱ
+ * @prama[in]:handle->ͼ;leftIdx,rightIdx->ͼ;detectMode->ģʽ;matchType->ƥ
+ * @prama[in]:keyPtLeft,keyPtRight->ҹؼ(׼ֱ);goodMatchPt->ƥ
+ * @prama[in]:goodPtLeft,goodPtRight->ƥ(ԭֱ)
+ * @prama[in]:stats->ͳ(Ϊͳ)
+ * @retval:None
+ */
+inline void featureRegister(imgProcess& handle, int leftIdx, int rightIdx, int detectMode, int matchType, vector<KeyPoint>& keyPtLeft,
+    vector<KeyPoint>& keyPtRight, vector<DMatch>& goodMatchPt, vector<Point2f>& goodPtLeft, vector<Point2f>& goodPtRight,
+    mosaicStats* stats = nullptr)
+{
+    // Ҷͼ״ηʱɾɲ,ʱҶȻ
+    auto timeBegin = chrono::steady_clock::now();
+    Mat grayImgLeft = handle.getGrayImg(leftIdx);
+    Mat grayImgRight = handle.getGrayImg(rightIdx);
+    if (stats != nullptr)   stats->grayMs += mosaicStats::elapsedMs(timeBegin);
+    featureRegister_Gray(grayImgLeft, grayImgRight, detectMode, matchType, keyPtLeft, keyPtRight, goodMatchPt,
+        goodPtLeft, goodPtRight, stats, handle.keyPtBudget, handle.guidedRadius);
+    if (handle.decodeScale == 1) return;
+    for (Point2f& p : goodPtLeft)   p *= (float)handle.decodeScale;
+    for (Point2f& p : goodPtRight)  p *= (float)handle.decodeScale;
+}
+
+/*
+ * @breif:ͼӳ䵽ͼϵعⲹƴ
+ * @prama[in]:handle->ͼ;leftImg->ƴӵͼ;imgMapByHomo->ӳ䵽ͼϵͼ
+ * @prama[in]:mapMask->ӳͼЧ,ƴֻе
+ * @prama[in]:dstImg->ƴӽ,ߴ粻ʱڴ
+ * @prama[in]:leftBound->ӳͼ߽;rightCols->ͼԭ;debug->ģʽ
+ * @prama[in]:dstMask->ƴӽЧ(Ϊ)
+ * @retval:None
+ */
+inline void imageBlend(imgProcess& handle, Mat& leftImg, Mat& imgMapByHomo, const validMask& mapMask, Mat& dstImg, int leftBound,
+    int rightCols, int debug = DEBUGMODE_SHOW, validMask* dstMask = nullptr)
+{
+    handle.calGain(leftImg, imgMapByHomo, mapMask, leftBound, leftImg.cols);
+    handle.imgMosaic(leftImg, imgMapByHomo, mapMask, dstImg, dstMask);
+    if (debug == DEBUGMODE_GETMOSAIC)   return;
+    if (handle.seamMode == SEAMMODE_ALPHA)
+    {
+        handle.seamOpt_alpha(leftImg, imgMapByHomo, mapMask, dstImg, leftBound, rightCols);
+        return;
+    }
+    // صƴӷ,ƴӷСΧ
+    int seamStart = cmpMax(leftBound, 0);
+    seamFinder seamHandle(handle.seamMode);
+    Mat seamMask = seamHandle.findSeam(leftImg, imgMapByHomo, mapMask, seamStart, leftImg.cols);
+    handle.seamOpt_mask(leftImg, imgMapByHomo, mapMask, dstImg, seamMask, seamStart);
+}
+
+/*
+ * @breif:֪Ӧʱͼӳ䡢ƴ
+ * @prama[in]:handle->ͼ;leftImg->ƴӵͼ;rightImg->ƴӵͼ;
+ * @prama[in]:H->ͼͼĵӦ;mapSize->ӳͼƬС;leftBound->ӳͼ߽
+ * @prama[in]:debug->ģʽ
+ * @prama[in]:mapCache->Ӧӳ,̶λ¿֡(ΪÿֱwarpPerspective)
+ * @prama[in]:stats->ͳ,¼ӳںϺʱ(Ϊͳ)
+ * @prama[in]:workspace->ƴӹ,ӳͼдп֡(Ϊÿ½)
+ * @prama[in]:rightMask->ΪͼЧ,ߴͼ(δֵ)ʱΪЧ;ںϺдΪƴӽ,
+ *            ֻȡӳͼʱд,ƴʱͬһ뼴(ΪͼЧҲ)
+ * @retval:mosaicImg->leftImgrightImgƴӶɵͼ,ʹùʱ´ʹͬһƴǰЧ
+ */
+inline Mat imageMosaicByHomo(imgProcess handle, Mat leftImg, Mat rightImg, Mat H, Size mapSize, int leftBound,
+    int debug = DEBUGMODE_SHOW, warpMapCache* mapCache = nullptr, mosaicStats* stats = nullptr,
+    mosaicWorkspace* workspace = nullptr, validMask* rightMask = nullptr)
+{
+    /*===================================================================================*/
+    /************************************ Ӧӳ *****************************************/
+    /*===================================================================================*/
+    homoEst homographyMap;
+    mosaicWorkspace localWorkspace;
+    mosaicWorkspace& ws = (workspace == nullptr) ? localWorkspace : *workspace;
+    const validMask* srcMask = (rightMask == nullptr || rightMask->size != rightImg.size()) ? nullptr : rightMask;
+    auto timeBegin = chrono::steady_clock::now();
+    if (mapCache == nullptr)    homographyMap.imgMapByHomo(rightImg, H, mapSize, ws.imgMapByHomo, ws.mapMask, srcMask);
+    else                        homographyMap.imgMapByHomo(rightImg, H, mapSize, *mapCache, ws.imgMapByHomo, ws.mapMask, srcMask);
+    if (stats != nullptr)   stats->warpMs += mosaicStats::elapsedMs(timeBegin);
+    if (debug == DEBUGMODE_GETHOMO)  return ws.imgMapByHomo;
+    /*-----------------------------------------------------------------------------------*/
+
+
+    /*===================================================================================*/
+    /************************************ ͼ׼ ***********************************/
+    /*===================================================================================*/
+    timeBegin = chrono::steady_clock::now();
+    imageBlend(handle, leftImg, ws.imgMapByHomo, ws.mapMask, ws.dstImg, leftBound, rightImg.cols, debug, rightMask);
+    if (stats != nullptr)   stats->blendMs += mosaicStats::elapsedMs(timeBegin);
+    return ws.dstImg;
+    /*-----------------------------------------------------------------------------------*/
+}
+
 /*
  * @breif:ͼƴ
  * @prama[in]:handle->ͼ;leftImg->ƴӵͼ;rightImg->ƴӵͼ;
  * @prama[in]:detectMode->ģʽ(SIFTORBBRISK)
  * @prama[in]:matchType->ƥ(minmax㷨low's㷨)
  * @prama[in]:debug->ģʽ
- * @retval:mosaicImg->leftImgrightImgƴӶɵͼ
+ * @prama[in]:mapCache->Ӧӳ,̶λ¿֡(ΪÿֱwarpPerspective)
+ * @prama[in]:stats->ͳ,ǰõtag(ΪֻдѴ򿪵ͳļ)
+ * @prama[in]:workspace->ƴӹ,Ҷͼƥ㡢ӳͼ֡(Ϊÿ½)
+ * @prama[in]:rightMask->ͼЧ,ںϺдΪƴӽ,imageMosaicByHomo(ΪͼЧ)
+ * @retval:mosaicImg->leftImgrightImgƴӶɵͼ,ʹùʱ´ʹͬһƴǰЧ
  */
-Mat imageMosaic(imgProcess handle, Mat leftImg, Mat rightImg,int detectMode, int matchType, int debug = DEBUGMODE_SHOW)
+inline Mat imageMosaic(imgProcess handle, Mat leftImg, Mat rightImg,int detectMode, int matchType, int debug = DEBUGMODE_SHOW,
+    warpMapCache* mapCache = nullptr, mosaicStats* stats = nullptr, mosaicWorkspace* workspace = nullptr,
+    validMask* rightMask = nullptr)
 {
     /*===================================================================================*/
     /******************************** Դ **************************************/
     /*===================================================================================*/
-    featureDesc featureDescHandle;                          // 
-    featureMatch featureMatchHandle;                        // ƥ
     MatSize imgSize = rightImg.size;                        // ƴͼߴ
-    vector<KeyPoint> keyPtRight, keyPtLeft;                 // ؼ
-    Mat imgDescRight, imgDescLeft;                          // 
-    vector<DMatch> goodMatchPt;                             // ƥ
-    vector<Point2f> goodPtLeft, goodPtRight;                // ƥ
-    Mat grayImgLeft, grayImgRight;                          // Ҷͼ
-    cvtColor(leftImg, grayImgLeft, COLOR_RGB2GRAY);
-    cvtColor(rightImg, grayImgRight, COLOR_RGB2GRAY);
+    mosaicWorkspace localWorkspace;                         // δʱʱ
+    mosaicWorkspace& ws = (workspace == nullptr) ? localWorkspace : *workspace;
+    ws.clear();
+    vector<KeyPoint>& keyPtRight = ws.keyPtRight;           // ؼ
+    vector<KeyPoint>& keyPtLeft = ws.keyPtLeft;
+    vector<DMatch>& goodMatchPt = ws.goodMatchPt;           // ƥ
+    vector<Point2f>& goodPtLeft = ws.goodPtLeft;            // ƥ
+    vector<Point2f>& goodPtRight = ws.goodPtRight;
+    mosaicStats runStats;                                   // ͳ
+    runStats.tag = (stats == nullptr) ? "" : stats->tag;
+    runStats.leftSize = leftImg.size();
+    runStats.rightSize = rightImg.size();
+    runStats.begin();
+
+    // ӳڸֱ䵥Ӧ,⡢ƥRANSAC,ÿWARPCACHE_RECHECK֡׼һ
+    if (mapCache != nullptr && debug != DEBUGMODE_GETMATCH && mapCache->reuse(rightImg.size()))
+    {
+        homoEst homographyMap(vector<Point2f>(), vector<Point2f>(), rightImg.size());
+        homographyMap.H = mapCache->H.clone();
+        homographyMap.calTransBound();
+        Mat dstImg = imageMosaicByHomo(handle, leftImg, rightImg, homographyMap.H, mapCache->roi.size(),
+            homographyMap.leftBound, debug, mapCache, &runStats, &ws, rightMask);
+        runStats.end();
+        if (stats != nullptr)   *stats = runStats;
+        return dstImg;
+    }
     /*-----------------------------------------------------------------------------------*/
 
 
     /*===================================================================================*/
     /******************************** ⡢ƥ ***********************************/
     /*===================================================================================*/
-    if (detectMode == SIFTDETECT)
+    auto timeBegin = chrono::steady_clock::now();
+    cvtColor(leftImg, ws.grayImgLeft, COLOR_RGB2GRAY);
+    cvtColor(rightImg, ws.grayImgRight, COLOR_RGB2GRAY);
+    runStats.grayMs = mosaicStats::elapsedMs(timeBegin);
+    featureRegister_Gray(ws.grayImgLeft, ws.grayImgRight, detectMode, matchType, keyPtLeft, keyPtRight, goodMatchPt,
+        goodPtLeft, goodPtRight, &runStats, handle.keyPtBudget, handle.guidedRadius);
+
+    if (debug == DEBUGMODE_GETMATCH)
     {
-        featureDescHandle.getFeatureDesc_SIFT(grayImgLeft, keyPtLeft, imgDescLeft);
-        featureDescHandle.getFeatureDesc_SIFT(grayImgRight, keyPtRight, imgDescRight);
-        goodMatchPt = featureMatchHandle.featureMatch_MinMax(imgDescLeft, imgDescRight, 2, MATCHMODE_NORML2);
+        Mat imgMatch;
+        drawMatches(leftImg, keyPtLeft, rightImg, keyPtRight, goodMatchPt, imgMatch, Scalar(0, 255, 255));
+        return imgMatch;
     }
-    else if (detectMode == SURFDETECT)
+    /*-----------------------------------------------------------------------------------*/
+
+
+    /*===================================================================================*/
+    /************************************ ӦԹ ***************************************/
+    /*===================================================================================*/
+    timeBegin = chrono::steady_clock::now();
+    homoEst homographyMap(goodPtRight, goodPtLeft, imgSize);         // ͼΪ׼,ͼӳ䵽ͼ
+    homographyMap.motionMode = handle.motionMode;
+    pipelineDispatch(detectMode, matchType, [&](auto pipeline) { pipeline.homoEstimate(homographyMap); });
+    Size mapSize = Size(homographyMap.rightBound, imgSize[0]);       // ӳͼƬС
+    runStats.ransacMs = mosaicStats::elapsedMs(timeBegin);
+    runStats.ransacIters = homographyMap.ransacIters;
+    runStats.inlierNum = homographyMap.inlierNum;
+    runStats.motionModel = homographyMap.motionModel;
+    if (mapCache != nullptr)    mapCache->reuseNum = 0;
+    /*-----------------------------------------------------------------------------------*/
+
+    Mat dstImg = imageMosaicByHomo(handle, leftImg, rightImg, homographyMap.H, mapSize, homographyMap.leftBound, debug,
+        mapCache, &runStats, &ws, rightMask);
+    runStats.end();
+    if (stats != nullptr)   *stats = runStats;
+    return dstImg;
+}
+
+/*
+ * @breif:ͼƬƴ,׼ڽֱʻҶͼ,ƴʱԭֱͼ
+ * @prama[in]:handle->ͼ;leftIdx,rightIdx->ͼ
+ * @prama[in]:detectMode->ģʽ(SIFTORBBRISK);matchType->ƥ(minmax㷨low's㷨)
+ * @prama[in]:debug->ģʽ
+ * @prama[in]:stats->ͳ,ǰõtag(ΪֻдѴ򿪵ͳļ)
+ * @retval:mosaicImg->ͼƴӶɵͼ
+ */
+inline Mat imageMosaic(imgProcess& handle, int leftIdx, int rightIdx, int detectMode, int matchType, int debug = DEBUGMODE_SHOW,
+    mosaicStats* stats = nullptr)
+{
+    vector<KeyPoint> keyPtRight, keyPtLeft;                 // ؼ
+    vector<DMatch> goodMatchPt;                             // ƥ
+    vector<Point2f> goodPtLeft, goodPtRight;                // ƥ
+    mosaicStats runStats;                                   // ͳ
+    runStats.tag = (stats == nullptr) ? "" : stats->tag;
+    runStats.begin();
+    featureRegister(handle, leftIdx, rightIdx, detectMode, matchType, keyPtLeft, keyPtRight, goodMatchPt, goodPtLeft, goodPtRight,
+        &runStats);
+    if (debug == DEBUGMODE_GETMATCH)
     {
-        featureDescHandle.getFeatureDesc_SURF(grayImgLeft, keyPtLeft, imgDescLeft);
-        featureDescHandle.getFeatureDesc_SURF(grayImgRight, keyPtRight, imgDescRight);
-        goodMatchPt = featureMatchHandle.featureMatch_MinMax(imgDescLeft, imgDescRight, 2, MATCHMODE_NORML2);
+        Mat imgMatch;
+        drawMatches(handle.getRegImg(leftIdx), keyPtLeft, handle.getRegImg(rightIdx), keyPtRight, goodMatchPt, imgMatch,
+            Scalar(0, 255, 255));
+        return imgMatch;
     }
-    else if (detectMode == ORBDETECT)
+
+    Mat leftImg = handle.getRGBImg(leftIdx);
+    Mat rightImg = handle.getRGBImg(rightIdx);
+    runStats.leftSize = leftImg.size();
+    runStats.rightSize = rightImg.size();
+    auto timeBegin = chrono::steady_clock::now();
+    homoEst homographyMap(goodPtRight, goodPtLeft, rightImg.size());   // ͼΪ׼,ͼӳ䵽ͼ
+    homographyMap.motionMode = handle.motionMode;
+    pipelineDispatch(detectMode, matchType, [&](auto pipeline) { pipeline.homoEstimate(homographyMap); });
+    Size mapSize = Size(homographyMap.rightBound, rightImg.rows);      // ӳͼƬС
+    runStats.ransacMs = mosaicStats::elapsedMs(timeBegin);
+    runStats.ransacIters = homographyMap.ransacIters;
+    runStats.inlierNum = homographyMap.inlierNum;
+    runStats.motionModel = homographyMap.motionModel;
+    Mat dstImg = imageMosaicByHomo(handle, leftImg, rightImg, homographyMap.H, mapSize, homographyMap.leftBound, debug,
+        nullptr, &runStats);
+    runStats.end();
+    if (stats != nullptr)   *stats = runStats;
+    return dstImg;
+}
+
+/*
+ * @breif:̶λ궨,ܱ궨и֡ƥ,ƴӶԹƲϸӦ
+ * @prama[in]:calibFrames->궨,ÿ֡Ϊеĸͼ;calib->ı궨
+ * @prama[in]:detectMode->ģʽ(SIFTORBBRISK);matchType->ƥ(minmax㷨low's㷨)
+ * @prama[in]:calibFile->궨ļ·,Ϊ;debug->ģʽ
+ * @note:ƴ˳mainͬ,Ҳͼʼƴ,kƴӶԵͼǰkƴӶԵĽ
+ * @retval:true->궨ɹ; false->궨ʧ
+ */
+inline bool rigCalibrate(imgProcess& handle, vector<vector<Mat>>& calibFrames, rigCalib& calib, int detectMode, int matchType,
+    string calibFile = "", int debug = DEBUGMODE_SHOW)
+{
+    if (calibFrames.empty() || calibFrames[0].size() < 2)    return false;
+    int camNum = (int)calibFrames[0].size();
+    vector<Mat> mosaicImgs(calibFrames.size());
+    vector<validMask> mosaicMasks(calibFrames.size());     // ֡ƴӲֵЧ
+    for (size_t f = 0; f < calibFrames.size(); f++)   mosaicImgs[f] = calibFrames[f][camNum - 1];
+
+    for (int pairIdx = 0; pairIdx < camNum - 1; pairIdx++)
     {
-        featureDescHandle.getFeatureDesc_ORB(grayImgLeft, keyPtLeft, imgDescLeft);
-        featureDescHandle.getFeatureDesc_ORB(grayImgRight, keyPtRight, imgDescRight);
-        if (matchType)
-            goodMatchPt = featureMatchHandle.featureMatch_MinMax(imgDescLeft, imgDescRight, 2.4, MATCHMODE_HAMMING);
-        else
-            goodMatchPt = featureMatchHandle.featureMatch_Lows(imgDescLeft, imgDescRight, 0.5, MATCHMODE_HAMMING);
+        int leftIdx = camNum - 2 - pairIdx;
+        for (size_t f = 0; f < calibFrames.size(); f++)
+        {
+            vector<KeyPoint> keyPtRight, keyPtLeft;
+            vector<DMatch> goodMatchPt;
+            vector<Point2f> goodPtLeft, goodPtRight;
+            featureRegister(calibFrames[f][leftIdx], mosaicImgs[f], detectMode, matchType,
+                keyPtLeft, keyPtRight, goodMatchPt, goodPtLeft, goodPtRight);
+            calib.addCalibFrame(pairIdx, goodPtLeft, goodPtRight, mosaicImgs[f].size());
+        }
+        if (!calib.calibratePair(pairIdx))  return false;
+
+        // ñ궨һƴӶԵͼ
+        rigCalib::pair_calib& pairCalib = calib.pairs[pairIdx];
+        for (size_t f = 0; f < calibFrames.size(); f++)
+            mosaicImgs[f] = imageMosaicByHomo(handle, calibFrames[f][leftIdx], mosaicImgs[f], pairCalib.H,
+                pairCalib.mapSize, pairCalib.leftBound, debug, &calib.mapCaches[pairIdx], nullptr, nullptr,
+                &mosaicMasks[f]);
     }
-    else if (detectMode == BRISKDETECT)
+    return calibFile.empty() || calib.save(calibFile);
+}
+
+/*
+ * @breif:̶λƴ,ֱʹñ궨ĵӦӳں,ÿ֡һϡƯƼ
+ * @prama[in]:handle->ͼ;frameImgs->ǰ֡еĸͼ;calib->궨
+ * @prama[in]:frameIdx->֡;detectModematchType->Ưƺ¹ʹõļģʽƥ;debug->ģʽ
+ * @retval:mosaicImg->ƴͼ
+ */
+inline Mat imageMosaicRig(imgProcess handle, vector<Mat>& frameImgs, rigCalib& calib, int frameIdx, int detectMode, int matchType,
+    int debug = DEBUGMODE_SHOW)
+{
+    int camNum = (int)frameImgs.size();
+    Mat mosaicImg = frameImgs[camNum - 1];
+    validMask mosaicMask;                                   // ƴӲֵЧ
+    for (int pairIdx = 0; pairIdx < camNum - 1; pairIdx++)
     {
-        featureDescHandle.getFeatureDesc_BRISK(grayImgLeft, keyPtLeft, imgDescLeft);
-        featureDescHandle.getFeatureDesc_BRISK(grayImgRight, keyPtRight, imgDescRight);
-        goodMatchPt = featureMatchHandle.featureMatch_MinMax(imgDescLeft, imgDescRight, 2.3, MATCHMODE_HAMMING);
+        Mat& leftImg = frameImgs[camNum - 2 - pairIdx];
+        if (calib.needCheck(frameIdx) && calib.isDrifted(pairIdx, calib.checkDrift(pairIdx, leftImg, mosaicImg)))
+        {
+            vector<KeyPoint> keyPtRight, keyPtLeft;
+            vector<DMatch> goodMatchPt;
+            vector<Point2f> goodPtLeft, goodPtRight;
+            featureRegister(leftImg, mosaicImg, detectMode, matchType, keyPtLeft, keyPtRight, goodMatchPt, goodPtLeft, goodPtRight,
+                nullptr, handle.keyPtBudget, handle.guidedRadius);
+            calib.updatePair(pairIdx, goodPtLeft, goodPtRight, mosaicImg.size());
+        }
+        rigCalib::pair_calib& pairCalib = calib.pairs[pairIdx];
+        mosaicImg = imageMosaicByHomo(handle, leftImg, mosaicImg, pairCalib.H, pairCalib.mapSize, pairCalib.leftBound,
+            debug, &calib.mapCaches[pairIdx], nullptr, &calib.workspaces[pairIdx], &mosaicMask);
     }
-    featureMatchHandle.getGoodPt(goodMatchPt, keyPtRight, keyPtLeft, goodPtRight, goodPtLeft);
-    //++++
+    return mosaicImg;
+}
 
-    if (debug == DEBUGMODE_GETMATCH)
+/*
+ * @breif:ͼοͼĵӦ㻭Χ
+ * @prama[in]:imgSizes->ͼߴ;homoToRef->ͼοͼĵӦ,Ϊյͼ
+ * @prama[in]:shift->Ĳοͼ굽ƽ
+ * @retval:ߴ
+ */
+inline Size calCanvasSize(const vector<Size>& imgSizes, const vector<Mat>& homoToRef, Mat& shift)
+{
+    float minX = 0, minY = 0, maxX = 0, maxY = 0;
+    for (size_t i = 0; i < imgSizes.size(); i++)
     {
-        Mat imgMatch;
-        drawMatches(leftImg, keyPtLeft, rightImg, keyPtRight, goodMatchPt, imgMatch, Scalar(0, 255, 255));
-        return imgMatch;
+        if (homoToRef[i].empty())   continue;
+        vector<Point2f> srcCorners = { Point2f(0, 0), Point2f((float)imgSizes[i].width, 0),
+            Point2f(0, (float)imgSizes[i].height), Point2f((float)imgSizes[i].width, (float)imgSizes[i].height) };
+        vector<Point2f> dstCorners;
+        perspectiveTransform(srcCorners, dstCorners, homoToRef[i]);
+        for (const Point2f& p : dstCorners)
+        {
+            minX = min(minX, p.x);  maxX = max(maxX, p.x);
+            minY = min(minY, p.y);  maxY = max(maxY, p.y);
+        }
+    }
+    shift = (Mat_<double>(3, 3) << 1, 0, -floor(minX), 0, 1, -floor(minY), 0, 0, 1);
+    return Size((int)ceil(maxX - floor(minX)), (int)ceil(maxY - floor(minY)));
+}
+
+/*
+ * @breif:ͼοͼĵӦ㻭Χ,Ƭͼӳں,TIFFʽ
+ * @prama[in]:handle->ͼ;homoToRef->ͼοͼĵӦ,Ϊյͼƴ
+ * @prama[in]:cacheFile->Ƭļ·;dstFile->TIFFļ·
+ * @retval:true->ƴӳɹ; false->ʧ
+ */
+inline bool mosaicTiledCanvas(imgProcess& handle, const vector<Mat>& homoToRef, string cacheFile, string dstFile)
+{
+    // ֱʽʱԭͼߴ׼ͼߴ绻,decodeScale-1
+    vector<Size> imgSizes(handle.imgNum);
+    for (int i = 0; i < handle.imgNum; i++) if (!homoToRef[i].empty())  imgSizes[i] = handle.getImgSize(i);
+    Mat shift;
+    Size canvasSize = calCanvasSize(imgSizes, homoToRef, shift);
+
+    tiledCanvas canvas;
+    if (!canvas.create(cacheFile, canvasSize.width, canvasSize.height))   return false;
+    for (int i = 0; i < handle.imgNum; i++)
+    {
+        if (homoToRef[i].empty())   continue;
+        // ӳ䵱ǰͼʱ̨һ,ͬʱפԭֱͼ
+        for (int next = i + 1; next < handle.imgNum; next++)
+        {
+            if (homoToRef[next].empty())    continue;
+            handle.prefetchImg(next, STORE_VARIANT_RGB);
+            break;
+        }
+        canvas.addImage(handle.getRGBImg(i), shift * homoToRef[i]);
+        handle.releaseImg(i);
     }
+    imgStore::store_stats storeStats = handle.store->getStats();
+    MOSAIC_LOG_INFO("mosaicTiledCanvas 뻺 :" << storeStats.hitNum << " :" << storeStats.missNum << " Ԥȡ:"
+        << storeStats.prefetchHitNum << "/" << storeStats.prefetchNum << " ֵ:" << storeStats.peakBytes / 1048576 << "MB");
+    return canvas.writeTiff(dstFile);
+}
+
+/*
+ * @breif:ҵ˳ԹƵӦ,۳˵õͼһͼĵӦ
+ * @prama[in]:handle->ͼ,ҵ˳Ŵƴͼ
+ * @prama[in]:detectMode->ģʽ(SIFTORBBRISK);matchType->ƥ(minmax㷨low's㷨)
+ * @prama[in]:refine->ǷڼһƴӶڵȫֹƽ,۳˵Ư
+ * @retval:homoToRef->ͼһͼĵӦ
+ */
+inline vector<Mat> estimateHomoChain(imgProcess& handle, int detectMode, int matchType, bool refine = true)
+{
+    vector<Mat> homoToRef(handle.imgNum);                       // ͼһͼĵӦ
+    bundleAdjust adjuster;
+    homoToRef[0] = Mat::eye(3, 3, CV_64F);
+    for (int i = 1; i < handle.imgNum; i++)
+    {
+        // 1ƴӶԸֵ,2ƴӶԽص㹻ʱΪƽıջԼ
+        for (int step = 1; step <= (refine ? 2 : 1) && step <= i; step++)
+        {
+            vector<KeyPoint> keyPtRight, keyPtLeft;
+            vector<DMatch> goodMatchPt;
+            vector<Point2f> goodPtLeft, goodPtRight, inlierLeft, inlierRight;
+            if (step == 1)  handle.prefetchImg(i + 1, STORE_VARIANT_GRAY);
+            featureRegister(handle, i - step, i, detectMode, matchType, keyPtLeft, keyPtRight, goodMatchPt, goodPtLeft, goodPtRight);
+            if (step > 1 && goodPtLeft.size() < BA_MINPAIRPTS)  continue;
+            Size imgSize = handle.getImgSize(i);
+            homoEst homographyMap(goodPtRight, goodPtLeft, imgSize);
+            homographyMap.findHomography_Base();
+            if (step == 1)  homoToRef[i] = homoToRef[i - 1] * homographyMap.H;
+            if (step > 1 && homographyMap.inlierNum < BA_MINPAIRPTS)    continue;
+            for (size_t idx : homographyMap.inliers)
+            {
+                inlierLeft.push_back(goodPtLeft[idx]);
+                inlierRight.push_back(goodPtRight[idx]);
+            }
+            adjuster.addPair(i - step, i, inlierLeft, inlierRight);
+        }
+    }
+    if (refine && handle.imgNum > 2)
+    {
+        adjuster.homoToRef = homoToRef;
+        if (adjuster.optimize())
+        {
+            homoToRef = adjuster.homoToRef;
+            MOSAIC_LOG_INFO("estimateHomoChain ȫƽ :" << adjuster.iters << " PCG:" << adjuster.pcgIters
+                << " :" << adjuster.initRms << "->" << adjuster.finalRms);
+        }
+    }
+    return homoToRef;
+}
+
+/*
+ * @breif:ͼƴ,Ƭӳں,TIFFʽ
+ * @prama[in]:handle->ͼ,ҵ˳Ŵƴͼ
+ * @prama[in]:detectMode->ģʽ(SIFTORBBRISK);matchType->ƥ(minmax㷨low's㷨)
+ * @prama[in]:cacheFile->Ƭļ·;dstFile->TIFFļ·
+ * @prama[in]:refine->ǷڼһƴӶڵȫֹƽ,۳˵Ư
+ * @retval:true->ƴӳɹ; false->ƴʧ
+ */
+inline bool imageMosaicTiled(imgProcess& handle, int detectMode, int matchType, string cacheFile, string dstFile, bool refine = true)
+{
+    return mosaicTiledCanvas(handle, estimateHomoChain(handle, detectMode, matchType, refine), cacheFile, dstFile);
+}
+
+/*
+ * @breif:ͼƴ:ͼһ,ʻΪÿͼɸѡtopKѡ,ֻԺѡƥRANSAC;
+ *        ڵ㹻ƴӶԹɵͼֵ,ȫֹƽ,δοͼͨͼƴ
+ * @prama[in]:handle->ͼ,ͼ˳
+ * @prama[in]:detectMode->ģʽ(SIFTORBBRISK);matchType->ƥ(minmax㷨low's㷨)
+ * @prama[in]:cacheFile->Ƭļ·;dstFile->TIFFļ·
+ * @prama[in]:topK->ÿͼĺѡƴӶ
+ * @retval:true->ƴӳɹ; false->ģʽЧʵ乹ʧܻ޿ƴӶ
+ */
+inline bool imageMosaicUnordered(imgProcess& handle, int detectMode, int matchType, string cacheFile, string dstFile,
+    int topK = VOCAB_TOPK)
+{
+    /*===================================================================================*/
+    /************************************  ***********************************/
+    /*===================================================================================*/
+    int imgNum = handle.imgNum;
+    vector<vector<KeyPoint>> keyPts(imgNum);
+    vector<Mat> descs(imgNum);
+    vector<Size> imgSizes(imgNum);
+    bool isKnown = pipelineDispatch(detectMode, matchType, [&](auto pipeline)
+    {
+        for (int i = 0; i < imgNum; i++)
+        {
+            handle.prefetchImg(i + 1, STORE_VARIANT_GRAY);
+            Mat grayImg = handle.getGrayImg(i);
+            pipeline.detect(grayImg, keyPts[i], descs[i], handle.keyPtBudget);
+        }
+    });
+    if (!isKnown)
+    {
+        MOSAIC_LOG_ERROR("imageMosaicUnordered δ֪ļģʽ:" << detectMode);
+        return false;
+    }
+    for (int i = 0; i < imgNum; i++)    imgSizes[i] = handle.getImgSize(i);
+
+    vocabTree vocab;
+    if (!vocab.train(descs))    return false;
+    for (int i = 0; i < imgNum; i++)    vocab.addImage(i, descs[i]);
+    vocab.build();
+    vector<pair<int, int>> candidates = vocab.candidatePairs(topK);
+    MOSAIC_LOG_INFO("imageMosaicUnordered ѡƴӶ:" << candidates.size() << "/" << imgNum * (imgNum - 1) / 2);
     /*-----------------------------------------------------------------------------------*/
 
 
     /*===================================================================================*/
-    /************************************ ӦԹ ***************************************/
+    /************************************ ѡƥRANSAC ******************************/
     /*===================================================================================*/
-    homoEst homographyMap(goodPtRight, goodPtLeft, imgSize);         // ͼΪ׼,ͼӳ䵽ͼ
-    homographyMap.findHomography_Base();    //++++change++++
-    homographyMap.calTransBound();
-    Size mapSize = Size(homographyMap.rightBound, imgSize[0]);       // ӳͼƬС
-    Mat imgMapByHomo = homographyMap.imgMapByHomo(rightImg, homographyMap.H, mapSize);
-    if (debug == DEBUGMODE_GETHOMO)  return imgMapByHomo;
+    // ڵ㲻ĺѡڵΪ,Ϊͼı
+    vector<bundleAdjust::pair_match> edges(candidates.size());
+    vector<Mat> edgeHomo(candidates.size());                    // idx_2idx_1ĵӦ
+    vector<vector<DMatch>> edgeMatches(candidates.size());      // queryIdxӦidx_1
+    vector<vector<int>> partnerEdges(imgNum);                   // ԸͼΪidx_1ĺѡ
+    for (int c = 0; c < (int)candidates.size(); c++)    partnerEdges[candidates[c].first].push_back(c);
+    pipelineDispatch(detectMode, matchType, [&](auto pipeline)
+    {
+        // ͬһͼȫѡһƥ,ѯֻһ
+        for (int i = 0; i < imgNum; i++)
+        {
+            if (partnerEdges[i].empty())    continue;
+            vector<Mat> partnerDescs;
+            for (int c : partnerEdges[i])   partnerDescs.push_back(descs[candidates[c].second]);
+            vector<vector<DMatch>> partnerMatches = pipeline.descMatchBatch(descs[i], partnerDescs);
+            for (size_t k = 0; k < partnerEdges[i].size(); k++) edgeMatches[partnerEdges[i][k]].swap(partnerMatches[k]);
+        }
+    });
+    parallel_for_(Range(0, (int)candidates.size()), [&](const Range& range)
+    {
+        for (int c = range.start; c < range.end; c++)
+        {
+            int idx_1 = candidates[c].first, idx_2 = candidates[c].second;
+            vector<Point2f> goodPt_1, goodPt_2;
+            for (const DMatch& m : edgeMatches[c])
+            {
+                goodPt_1.push_back(keyPts[idx_1][m.queryIdx].pt * (float)handle.decodeScale);
+                goodPt_2.push_back(keyPts[idx_2][m.trainIdx].pt * (float)handle.decodeScale);
+            }
+            bundleAdjust::pair_match& edge = edges[c];
+            edge.idx_1 = idx_1;
+            edge.idx_2 = idx_2;
+            if (goodPt_1.size() < BA_MINPAIRPTS)   continue;
+            homoEst homographyMap(goodPt_2, goodPt_1, imgSizes[idx_2]);
+            homographyMap.findHomography_Base();
+            if (homographyMap.inlierNum < BA_MINPAIRPTS || homographyMap.H.empty())  continue;
+            for (size_t idx : homographyMap.inliers)
+            {
+                edge.pt_1.push_back(goodPt_1[idx]);
+                edge.pt_2.push_back(goodPt_2[idx]);
+            }
+            edgeHomo[c] = homographyMap.H;
+        }
+    });
     /*-----------------------------------------------------------------------------------*/
 
 
     /*===================================================================================*/
-    /************************************ ͼ׼ ***********************************/
+    /************************************ ֵȫƽ *****************************/
     /*===================================================================================*/
-    Mat dstImg = handle.imgMosaic(leftImg, imgMapByHomo);
-    if (debug == DEBUGMODE_GETMOSAIC)   return dstImg;
-    handle.seamOpt_alpha(leftImg, imgMapByHomo, dstImg, homographyMap.leftBound, imgSize[1]);
-    if(debug==DEBUGMODE_SHOW)           return dstImg;
+    // ڵͼΪο,ڵı߹ȴݵӦ
+    vector<vector<int>> adjEdges(imgNum);
+    vector<size_t> inlierSum(imgNum, 0);
+    for (int e = 0; e < (int)edges.size(); e++)
+    {
+        if (edges[e].pt_1.empty())  continue;
+        adjEdges[edges[e].idx_1].push_back(e);
+        adjEdges[edges[e].idx_2].push_back(e);
+        inlierSum[edges[e].idx_1] += edges[e].pt_1.size();
+        inlierSum[edges[e].idx_2] += edges[e].pt_1.size();
+    }
+    int refIdx = (int)(max_element(inlierSum.begin(), inlierSum.end()) - inlierSum.begin());
+    if (inlierSum[refIdx] == 0)
+    {
+        MOSAIC_LOG_ERROR("imageMosaicUnordered ڵ㹻ƴӶ");
+        return false;
+    }
+    vector<Mat> homoToRef(imgNum);
+    homoToRef[refIdx] = Mat::eye(3, 3, CV_64F);
+    vector<int> visitQueue(1, refIdx);
+    for (size_t head = 0; head < visitQueue.size(); head++)
+    {
+        int cur = visitQueue[head];
+        vector<int>& curEdges = adjEdges[cur];
+        sort(curEdges.begin(), curEdges.end(), [&](int a, int b) { return edges[a].pt_1.size() > edges[b].pt_1.size(); });
+        for (int e : curEdges)
+        {
+            int next = (edges[e].idx_1 == cur) ? edges[e].idx_2 : edges[e].idx_1;
+            if (!homoToRef[next].empty())   continue;
+            homoToRef[next] = homoToRef[cur] * ((edges[e].idx_1 == cur) ? edgeHomo[e] : Mat(edgeHomo[e].inv()));
+            visitQueue.push_back(next);
+        }
+    }
+    if ((int)visitQueue.size() < imgNum)
+        MOSAIC_LOG_WARN("imageMosaicUnordered " << imgNum - (int)visitQueue.size() << "ͼδοͼͨ,ƴ");
+
+    bundleAdjust adjuster;
+    adjuster.refIdx = refIdx;
+    adjuster.homoToRef = homoToRef;
+    for (int i = 0; i < imgNum; i++)    if (homoToRef[i].empty())   adjuster.homoToRef[i] = Mat::eye(3, 3, CV_64F);
+    for (const bundleAdjust::pair_match& edge : edges)
+        if (!homoToRef[edge.idx_1].empty() && !homoToRef[edge.idx_2].empty())
+            adjuster.addPair(edge.idx_1, edge.idx_2, edge.pt_1, edge.pt_2);
+    if (adjuster.optimize())
+    {
+        for (int i = 0; i < imgNum; i++)    if (!homoToRef[i].empty())  homoToRef[i] = adjuster.homoToRef[i];
+        MOSAIC_LOG_INFO("imageMosaicUnordered ȫƽ :" << adjuster.iters << " :" << adjuster.initRms
+            << "->" << adjuster.finalRms);
+    }
     /*-----------------------------------------------------------------------------------*/
+
+    return mosaicTiledCanvas(handle, homoToRef, cacheFile, dstFile);
+}
+
+/*
+ * @breif:Ԥ:ͼС̶,ͼһORBͼƥ䲢۳˵Ӧ,
+ *        ӳ䵽Ԥ,صͼֱӸ
+ * @prama[in]:handle->ͼ,ҵ˳Ŵƴͼ
+ * @prama[in]:previewImg->Ԥͼ;scale->Ԥͼԭֱʵű
+ * @prama[in]:imgWidth->ԤÿͼĿ .pix
+ * @retval:true->Ԥɹ; false->ƥ㲻ͼ
+ */
+inline bool mosaicPreview(imgProcess& handle, Mat& previewImg, double& scale, int imgWidth = PREVIEW_IMGWIDTH)
+{
+    int imgNum = handle.imgNum;
+    if (imgNum < 1)  return false;
+    double regScale = min(1.0, (double)imgWidth / handle.getRegImg(0).cols);
+    scale = regScale / handle.decodeScale;
+
+    vector<Mat> smallImgs(imgNum), smallGrays(imgNum), descs(imgNum);
+    vector<vector<KeyPoint>> keyPts(imgNum);
+    vector<Mat> homoToRef(imgNum);
+    homoToRef[0] = Mat::eye(3, 3, CV_64F);
+    bool matched = true;
+    pipelineDispatch(ORBDETECT, MATCHMODE_MINMAX, [&](auto pipeline)
+    {
+        parallel_for_(Range(0, imgNum), [&](const Range& range)
+        {
+            for (int i = range.start; i < range.end; i++)
+            {
+                resize(handle.getRegImg(i), smallImgs[i], Size(), regScale, regScale, INTER_AREA);
+                cvtColor(smallImgs[i], smallGrays[i], COLOR_RGB2GRAY);
+                pipeline.detect(smallGrays[i], keyPts[i], descs[i], PREVIEW_KEYPOINTS);
+            }
+        });
+        for (int i = 1; i < imgNum && matched; i++)
+        {
+            vector<DMatch> goodMatchPt = pipeline.descMatch(descs[i - 1], descs[i]);
+            bool leftQuery = descs[i - 1].rows <= descs[i].rows;
+            vector<Point2f> goodPtLeft, goodPtRight;
+            for (const DMatch& m : goodMatchPt)
+            {
+                goodPtLeft.push_back(keyPts[i - 1][leftQuery ? m.queryIdx : m.trainIdx].pt);
+                goodPtRight.push_back(keyPts[i][leftQuery ? m.trainIdx : m.queryIdx].pt);
+            }
+            if (goodPtLeft.size() < 4)
+            {
+                matched = false;
+                break;
+            }
+            homoEst homographyMap(goodPtRight, goodPtLeft, smallImgs[i].size());
+            homographyMap.findHomography_Base();
+            homoToRef[i] = homoToRef[i - 1] * homographyMap.H;
+        }
+    });
+    if (!matched)   return false;
+
+    vector<Size> imgSizes(imgNum);
+    for (int i = 0; i < imgNum; i++)    imgSizes[i] = smallImgs[i].size();
+    Mat shift;
+    Size canvasSize = calCanvasSize(imgSizes, homoToRef, shift);
+    previewImg = Mat::zeros(canvasSize, CV_8UC3);
+    for (int i = imgNum - 1; i >= 0; i--)
+        warpPerspective(smallImgs[i], previewImg, shift * homoToRef[i], canvasSize, INTER_NEAREST, BORDER_TRANSPARENT);
+    return true;
+}
+
+/*
+ * @breif:ʽƴ:ڵ߳ɵͷֱԤص,ں̨߳Լģʽȫֱ׼ȫƽ,
+ *        Ƭӳں,ÿһƬص,TIFF
+ * @prama[in]:handle->ͼ,ҵ˳Ŵƴͼ,ǰ뱣ЧҲ߳ʹ
+ * @prama[in]:detectMode->ģʽ(SIFTORBBRISK);matchType->ƥ(minmax㷨low's㷨)
+ * @prama[in]:cacheFile->Ƭļ·;dstFile->TIFFļ·,Ϊ
+ * @prama[in]:onPreview->Ԥص(Ԥͼ,Ԥͼԭֱʵű),ڵ߳е
+ * @prama[in]:onTile->Ƭص(Ƭڻе,Ƭͼ),ں̨߳е,Ƭͼ豣ʱӦ
+ * @note:Ԥ뾫޷ֱ׼,߻ĶӦϵֻǽ
+ * @retval:޽,true->; false->ʧ
+ */
+inline future<bool> imageMosaicProgressive(imgProcess& handle, int detectMode, int matchType, string cacheFile, string dstFile,
+    function<void(const Mat&, double)> onPreview, function<void(Rect, const Mat&)> onTile)
+{
+    auto timeBegin = chrono::steady_clock::now();
+    Mat previewImg;
+    double scale = 0;
+    if (!mosaicPreview(handle, previewImg, scale))   MOSAIC_LOG_WARN("imageMosaicProgressive Ԥ׼ʧ,޽");
+    else
+    {
+        MOSAIC_LOG_INFO("imageMosaicProgressive Ԥʱ:" << mosaicStats::elapsedMs(timeBegin) << "ms");
+        if (onPreview)  onPreview(previewImg, scale);
+    }
+
+    return async(launch::async, [&handle, detectMode, matchType, cacheFile, dstFile, onTile]()
+    {
+        vector<Mat> homoToRef = estimateHomoChain(handle, detectMode, matchType);
+        vector<Mat> rgbImgs(handle.imgNum);
+        vector<Size> imgSizes(handle.imgNum);
+        for (int i = 0; i < handle.imgNum; i++)
+        {
+            rgbImgs[i] = handle.getRGBImg(i);
+            imgSizes[i] = rgbImgs[i].size();
+        }
+        Mat shift;
+        Size canvasSize = calCanvasSize(imgSizes, homoToRef, shift);
+
+        // ƬΪѭ,ȫԭֱͼͬʱפ,ܾڴԤ
+        tiledCanvas canvas;
+        if (!canvas.create(cacheFile, canvasSize.width, canvasSize.height))   return false;
+        vector<Mat> canvasHomo(handle.imgNum);
+        for (int i = 0; i < handle.imgNum; i++) canvasHomo[i] = shift * homoToRef[i];
+        canvas.addImagesByTile(rgbImgs, canvasHomo, onTile);
+        return dstFile.empty() || canvas.writeTiff(dstFile);
+    });
+}
+
+/*===================================================================================*/
+/************************************ ƴ ***************************************/
+/*===================================================================================*/
+typedef struct
+{
+    string dstFile;                                         // ƴӽ·
+    vector<string> imgPaths;                                // еĴƴͼƬ
+}batch_set;
+
+typedef struct
+{
+    int detectMode;                                         // ģʽ
+    int matchType;                                          // ƥ
+    int seamMode;                                           // ƴӷŻģʽ
+    int motionMode;                                         // ˶ģ
+    int projMode;                                           // ͶӰģʽ
+    double focal;                                           // ͶӰ .pix,0ʾȡͼ
+    int keyPtBudget;                                        // ÿͼ,0Ϊ
+    double matchMs;                                         // ͼƥʱԤ .ms,0ʱ任keyPtBudget
+    float guidedRadius;                                     // ƥļ뾶 .pix,0Ϊƥ
+    double memBudgetMB;                                     // ÿͼƬ뻺Ԥ .MB,0ΪҶͼʱȫ
+    int threads;                                            // OpenCV̳߳߳,0ΪĬ
+    int inflight;                                           // ͬʱͼƬ
+    int pipelineDepth;                                      // ˮģʽļ,0Ϊ鲢
+    string statsFile;                                       // ͳ·(JSON),Ϊ
+    int unorderedTopK;                                      // 0ʱͼƴ,Ϊÿͼĺѡ,0Ϊ˳ƴ
+    bool tiled;                                             // ǷƬƴӳͼ,BigTIFFд
+    string calibFile;                                       // ̶λģʽ:嵥֡궨дı궨ļ,Ϊ򲻱궨
+    string rigFile;                                         // ̶λģʽ:ȡı궨ļ,Ϊʹ
+}batch_option;
+
+typedef struct
+{
+    int setIdx;                                             // ͼƬ
+    shared_ptr<imgProcess> handle;                          // ͼ,ںϺͷ
+    vector<Mat> homo;                                       // iΪi+1ͼiͼĵӦ
+    Mat dstImg;                                             // ƴӽ,ͷ
+    vector<uchar> encoded;                                  // Ľļ
+    chrono::steady_clock::time_point begin;                 // ˮߵʱ
+}batch_job;
+
+/*
+ * @breif:ӡģʽ÷
+ * @prama[in]:None
+ * @retval:None
+ */
+inline void printBatchUsage()
+{
+    cout << "÷: ImageMosaic <manifest> [--detector sift|orb|brisk|surf] [--match minmax|lows|ann]" << endl
+        << "                   [--blend alpha|dp|graphcut] [--threads N] [--inflight N] [--stats file.jsonl]" << endl
+        << "                   [--motion auto|translation|similarity|affine|homography]" << endl
+        << "                   [--projection plane|cylinder|sphere] [--focal F] [--keypoints N] [--match-ms T]" << endl
+        << "                   [--guided radius] [--pipeline depth] [--mem-budget MB] [--unordered topK]" << endl
+        << "                   [--calibrate rig.yml | --rig rig.yml] [--tiled]" << endl
+        << "manifestÿΪһ: <ļ> <ͼƬ1> <ͼƬ2> ...(), #ͷΪע" << endl
+        << "--match annSIFTSURFHNSWƥ,--unorderedʱÿͼֻһ" << endl
+        << "--unorderedʱͼƬ˳,ʻѡƴӶ,TIFFд,ʹˮģʽ" << endl
+        << "--tiledƬƴӳͼ(纽),--mem-budgetƽ뻺,TIFFд,ʹˮģʽ" << endl
+        << "--calibrate/--rigΪ̶λģʽ:ÿΪһ֡ͼƬ,ȫ֡궨дȡ궨ļ," << endl
+        << "    ֮嵥˳֡Ա궨ĵӦӳں,ÿ" << RIGCALIB_INTERVAL << "֡ƯƼ" << endl;
+}
+
+/*
+ * @breif:в
+ * @prama[in]:argc,argv->в;manifestFile->嵥ļ·;option->ѡ
+ * @retval:true->ɹ; false->
+ */
+inline bool parseBatchArgs(int argc, char* argv[], string& manifestFile, batch_option& option)
+{
+    option = { SIFTDETECT, MATCHMODE_MINMAX, SEAMMODE_DP, MOTIONMODE_AUTO, PROJMODE_PLANE, 0, 0, 0, 0, 0, 0,
+        (int)max(1u, thread::hardware_concurrency()), 0, "", 0, false, "", "" };
+    for (int i = 1; i < argc; i++)
+    {
+        string arg = argv[i];
+        if (arg.compare(0, 2, "--") != 0)
+        {
+            manifestFile = arg;
+            continue;
+        }
+        if (arg == "--tiled")
+        {
+            option.tiled = true;
+            continue;
+        }
+        if (i + 1 >= argc)  return false;
+        string value = argv[++i];
+        if (arg == "--detector")
+        {
+            if (value == "sift")        option.detectMode = SIFTDETECT;
+            else if (value == "orb")    option.detectMode = ORBDETECT;
+            else if (value == "brisk")  option.detectMode = BRISKDETECT;
+            else if (value == "surf")   option.detectMode = SURFDETECT;
+            else return false;
+        }
+        else if (arg == "--match")
+        {
+            if (value == "minmax")      option.matchType = MATCHMODE_MINMAX;
+            else if (value == "lows")   option.matchType = MATCHMODE_LOWS;
+            else if (value == "ann")    option.matchType = MATCHMODE_ANN;
+            else return false;
+        }
+        else if (arg == "--blend")
+        {
+            if (value == "alpha")           option.seamMode = SEAMMODE_ALPHA;
+            else if (value == "dp")         option.seamMode = SEAMMODE_DP;
+            else if (value == "graphcut")   option.seamMode = SEAMMODE_GRAPHCUT;
+            else return false;
+        }
+        else if (arg == "--motion")
+        {
+            if (value == "auto")                option.motionMode = MOTIONMODE_AUTO;
+            else if (value == "translation")    option.motionMode = MOTIONMODE_TRANSLATION;
+            else if (value == "similarity")     option.motionMode = MOTIONMODE_SIMILARITY;
+            else if (value == "affine")         option.motionMode = MOTIONMODE_AFFINE;
+            else if (value == "homography")     option.motionMode = MOTIONMODE_HOMOGRAPHY;
+            else return false;
+        }
+        else if (arg == "--projection")
+        {
+            if (value == "plane")           option.projMode = PROJMODE_PLANE;
+            else if (value == "cylinder")   option.projMode = PROJMODE_CYLINDER;
+            else if (value == "sphere")     option.projMode = PROJMODE_SPHERE;
+            else return false;
+        }
+        else if (arg == "--focal")      option.focal = atof(value.c_str());
+        else if (arg == "--keypoints")  option.keyPtBudget = cmpMax(atoi(value.c_str()), 0);
+        else if (arg == "--match-ms")   option.matchMs = atof(value.c_str());
+        else if (arg == "--guided")     option.guidedRadius = max((float)atof(value.c_str()), 0.0f);
+        else if (arg == "--mem-budget") option.memBudgetMB = max(atof(value.c_str()), 0.0);
+        else if (arg == "--threads")    option.threads = atoi(value.c_str());
+        else if (arg == "--inflight")   option.inflight = cmpMax(atoi(value.c_str()), 1);
+        else if (arg == "--pipeline")   option.pipelineDepth = cmpMax(atoi(value.c_str()), 0);
+        else if (arg == "--stats")      option.statsFile = value;
+        else if (arg == "--unordered")  option.unorderedTopK = cmpMax(atoi(value.c_str()), 0);
+        else if (arg == "--calibrate")  option.calibFile = value;
+        else if (arg == "--rig")        option.rigFile = value;
+        else return false;
+    }
+    // ʱԤ㰴ͻΪ
+    if (option.matchMs > 0)
+        option.keyPtBudget = featureDesc::budgetFromLatency(option.matchMs,
+            option.detectMode == ORBDETECT || option.detectMode == BRISKDETECT);
+    return !manifestFile.empty();
+}
+
+/*
+ * @breif:ȡ嵥
+ * @prama[in]:manifestFile->嵥ļ·;sets->ͼƬ
+ * @retval:true->ȡɹ; false->ļ޷
+ */
+inline bool loadManifest(string manifestFile, vector<batch_set>& sets)
+{
+    ifstream file(manifestFile);
+    if (!file.is_open())    return false;
+    string line;
+    while (getline(file, line))
+    {
+        if (line.empty() || line[0] == '#')    continue;
+        istringstream lineStream(line);
+        batch_set set;
+        string imgPath;
+        if (!(lineStream >> set.dstFile))   continue;
+        while (lineStream >> imgPath)   set.imgPaths.push_back(imgPath);
+        sets.push_back(set);
+    }
+    return true;
+}
+
+/*
+ * @breif:ͶӰģʽѸͼͶӰ,ӳߴڽڹ
+ * @prama[in]:handle->ͼ,ѻԭͼ׼ͼͶӰ,֮ͼڽʱͶӰ
+ * @note:ͶӰתͼֻƽ,ӳǳ
+ * @retval:None
+ */
+inline void projectImgs(imgProcess& handle)
+{
+    if (handle.projMode == PROJMODE_PLANE)  return;
+    int projMode = handle.projMode;
+    double focal = handle.focal;
+    handle.store->setTransform([projMode, focal](Mat& img, int scale)
+    {
+        // ఴԭֱʸ,δָʱȡԭͼ
+        double scaledFocal = (focal > 0) ? focal / scale : img.cols;
+        Mat projImg;
+        projWarper::get(projMode, scaledFocal, img.size())->apply(img, projImg);
+        img = projImg;
+    });
+}
+
+/*
+ * @breif:ѡͼ,ͼƬǷȫȡɹ
+ * @prama[in]:handle->ͼ;option->ѡ
+ * @retval:true->ȫȡɹ; false->ͼƬȡʧ
+ */
+inline bool applyBatchOption(imgProcess& handle, const batch_option& option)
+{
+    handle.seamMode = option.seamMode;
+    handle.motionMode = option.motionMode;
+    handle.projMode = option.projMode;
+    handle.focal = option.focal;
+    handle.keyPtBudget = option.keyPtBudget;
+    handle.guidedRadius = option.guidedRadius;
+    bool loaded = handle.imgNum >= 2;
+    for (int i = 0; i < handle.imgNum; i++)  loaded = loaded && handle.imgValid(i);
+    return loaded;
+}
+
+/*
+ * @breif:ƴһͼƬ,뽻ģʽͬ,Ҳͼʼƴ
+ * @prama[in]:handle->ͼƬͼ;detectMode->ģʽ;matchType->ƥ
+ * @prama[in]:tag->ͳƱʶ,ÿƴӵͳƼ¼"tag#ͼ"
+ * @retval:mosaicImg->ƴӽ
+ */
+inline Mat mosaicSet(imgProcess& handle, int detectMode, int matchType, string tag = "")
+{
+    projectImgs(handle);
+    Mat mosaicImg = handle.getRGBImg(handle.imgNum - 1);
+    validMask mosaicMask;                                   // ƴӲֵЧ
+    for (int i = handle.imgNum - 2; i >= 0; i--)
+    {
+        mosaicStats stats;
+        stats.tag = tag + "#" + to_string(i);
+        handle.prefetchImg(i - 1, STORE_VARIANT_RGB);
+        mosaicImg = imageMosaic(handle, handle.getRGBImg(i), mosaicImg, detectMode, matchType, DEBUGMODE_NORMAL, nullptr, &stats,
+            nullptr, &mosaicMask);
+    }
+    return mosaicImg;
+}
+
+/*
+ * @breif:ˮ,ͼ׼ӳںϡɶִ߳,н,
+ *        k+1׼ʱkͬʱں,嵥˳д
+ * @prama[in]:sets->ͼƬ;option->ѡ,pipelineDepthΪ,inflightΪ׼ںϼ߳
+ * @prama[in]:latency->ĸӳ .ms;failNum->ʧ;imgDone->ɹƴӵͼƬ
+ * @note:׼ԭͼ֮,ƴʱƴλڵi+1ͼϵ,䵥Ӧi+1ͼiͼĵӦ
+ * @retval:None
+ */
+inline void batchPipeline(vector<batch_set>& sets, const batch_option& option, vector<double>& latency, atomic<int>& failNum,
+    atomic<int>& imgDone)
+{
+    stageExecutor<batch_job> executor(option.pipelineDepth);
+    int ioWorkers = cmpMax(option.inflight / 2, 1);
+    executor.addStage("decode", ioWorkers, [&](batch_job& job, string& errorInfo)
+    {
+        job.handle = make_shared<imgProcess>(sets[job.setIdx].imgPaths, 1, (size_t)(option.memBudgetMB * 1048576));
+        imgProcess& handle = *job.handle;
+        if (!applyBatchOption(handle, option))
+        {
+            errorInfo = "ͼƬȡʧ";
+            return false;
+        }
+        projectImgs(handle);
+        for (int i = 0; i < handle.imgNum; i++)  handle.getGrayImg(i);
+        return true;
+    });
+    executor.addStage("register", option.inflight, [&](batch_job& job, string& errorInfo)
+    {
+        imgProcess& handle = *job.handle;
+        job.homo.resize(handle.imgNum - 1);
+        for (int i = 0; i + 1 < handle.imgNum; i++)
+        {
+            vector<KeyPoint> keyPtLeft, keyPtRight;
+            vector<DMatch> goodMatchPt;
+            vector<Point2f> goodPtLeft, goodPtRight;
+            featureRegister(handle, i, i + 1, option.detectMode, option.matchType, keyPtLeft, keyPtRight, goodMatchPt,
+                goodPtLeft, goodPtRight);
+            // ƥڵ㲻ʱӦΪ,ϳɽ׶޷ʹ,ڴʧ
+            if (goodPtLeft.size() < 4)
+            {
+                errorInfo = "ƥ㲻";
+                return false;
+            }
+            homoEst homographyMap(goodPtRight, goodPtLeft, handle.getImgSize(i + 1));
+            homographyMap.motionMode = handle.motionMode;
+            pipelineDispatch(option.detectMode, option.matchType, [&](auto pipeline) { pipeline.homoEstimate(homographyMap); });
+            if (homographyMap.H.empty() || homographyMap.inlierNum < 4)
+            {
+                errorInfo = "ƥ㲻";
+                return false;
+            }
+            job.homo[i] = homographyMap.H;
+        }
+        return true;
+    });
+    executor.addStage("compose", option.inflight, [&](batch_job& job, string& errorInfo)
+    {
+        imgProcess& handle = *job.handle;
+        Mat mosaicImg = handle.getRGBImg(handle.imgNum - 1);
+        validMask mosaicMask;
+        for (int i = handle.imgNum - 2; i >= 0; i--)
+        {
+            homoEst homographyMap(vector<Point2f>(), vector<Point2f>(), mosaicImg.size());
+            homographyMap.H = job.homo[i];
+            homographyMap.calTransBound();
+            mosaicImg = imageMosaicByHomo(handle, handle.getRGBImg(i), mosaicImg, job.homo[i],
+                Size(homographyMap.rightBound, mosaicImg.rows), homographyMap.leftBound, DEBUGMODE_NORMAL, nullptr, nullptr,
+                nullptr, &mosaicMask);
+        }
+        job.dstImg = mosaicImg;
+        job.handle.reset();
+        return !job.dstImg.empty();
+    });
+    executor.addStage("encode", ioWorkers, [&](batch_job& job, string& errorInfo)
+    {
+        string& dstFile = sets[job.setIdx].dstFile;
+        size_t extPos = dstFile.rfind('.');
+        bool success = extPos != string::npos && imencode(dstFile.substr(extPos), job.dstImg, job.encoded);
+        job.dstImg.release();
+        if (!success)   errorInfo = "ʧ";
+        return success;
+    });
+
+    int setIdx = 0;
+    executor.run([&](batch_job& job)
+    {
+        if (setIdx >= (int)sets.size())  return false;
+        job.setIdx = setIdx++;
+        job.begin = chrono::steady_clock::now();
+        return true;
+    },
+    [&](batch_job& job, const string& stageError)
+    {
+        int k = job.setIdx;
+        string errorInfo = stageError;
+        if (errorInfo.empty())
+        {
+            ofstream file(sets[k].dstFile, ios::binary);
+            if (!file.write((const char*)job.encoded.data(), job.encoded.size()))  errorInfo = "дʧ";
+        }
+        bool success = errorInfo.empty();
+        latency[k] = chrono::duration<double, milli>(chrono::steady_clock::now() - job.begin).count();
+        if (success)    imgDone += (int)sets[k].imgPaths.size();
+        else            failNum++;
+        cout << getFormatStr("[%d/%d] %s %d %.1fms ", k + 1, (int)sets.size(), sets[k].dstFile.c_str(),
+            (int)sets[k].imgPaths.size(), latency[k]) << (success ? "ɹ" : "ʧ:" + errorInfo) << endl;
+    });
+    executor.printReport();
+}
+
+/*
+ * @breif:̶λ:嵥ÿΪͬһʱ̸ҵͼƬ,嵥˳֡;calibFileʱȫ֡궨,
+ *        ȡrigFile;֮֡Ա궨ĵӦӳں,ÿ֡ƯƼ,Ưʱ¹ƸƴӶ
+ * @prama[in]:sets->֡ͼƬ;option->ѡ
+ * @prama[in]:latency->ĸ֡ӳ .ms;failNum->ʧ֡;imgDone->ɹƴӵͼƬ
+ * @note:궨֡ȫפڴ,궨ȡ֡;ӳ빤֡,֡д
+ * @retval:true->궨; false->궨ʧܻ궨ļ޷ȡ
+ */
+inline bool batchRig(vector<batch_set>& sets, const batch_option& option, vector<double>& latency, atomic<int>& failNum,
+    atomic<int>& imgDone)
+{
+    auto loadFrame = [&](int k, vector<Mat>& frameImgs) -> shared_ptr<imgProcess>
+    {
+        shared_ptr<imgProcess> handle = make_shared<imgProcess>(sets[k].imgPaths, 1, (size_t)(option.memBudgetMB * 1048576));
+        if (!applyBatchOption(*handle, option))  return nullptr;
+        frameImgs.resize(handle->imgNum);
+        for (int i = 0; i < handle->imgNum; i++) frameImgs[i] = handle->getRGBImg(i);
+        return handle;
+    };
+
+    rigCalib calib;
+    if (!option.calibFile.empty())
+    {
+        vector<vector<Mat>> calibFrames;
+        shared_ptr<imgProcess> calibHandle;
+        for (int k = 0; k < (int)sets.size(); k++)
+        {
+            vector<Mat> frameImgs;
+            shared_ptr<imgProcess> handle = loadFrame(k, frameImgs);
+            if (handle == nullptr || (!calibFrames.empty() && frameImgs.size() != calibFrames[0].size()))
+            {
+                MOSAIC_LOG_WARN("batchRig 궨֡ͼƬ㡢ȡʧܻһ,궨:" << sets[k].dstFile);
+                continue;
+            }
+            if (calibHandle == nullptr) calibHandle = handle;
+            calibFrames.push_back(frameImgs);
+        }
+        if (calibHandle == nullptr || !rigCalibrate(*calibHandle, calibFrames, calib, option.detectMode, option.matchType,
+            option.calibFile, DEBUGMODE_NORMAL))
+        {
+            MOSAIC_LOG_ERROR("batchRig 궨ʧܻ޷д궨ļ:" << option.calibFile);
+            return false;
+        }
+    }
+    else if (!calib.load(option.rigFile))
+    {
+        MOSAIC_LOG_ERROR("batchRig ޷ȡ궨ļ:" << option.rigFile);
+        return false;
+    }
+
+    int camNum = (int)calib.pairs.size() + 1;
+    for (int k = 0; k < (int)sets.size(); k++)
+    {
+        auto setBegin = chrono::steady_clock::now();
+        bool success = false;
+        string errorInfo;
+        try
+        {
+            vector<Mat> frameImgs;
+            shared_ptr<imgProcess> handle = loadFrame(k, frameImgs);
+            if (handle == nullptr)                      errorInfo = "ͼƬȡʧ";
+            else if ((int)frameImgs.size() != camNum)   errorInfo = "궨һ";
+            else
+            {
+                Mat dstImg = imageMosaicRig(*handle, frameImgs, calib, k, option.detectMode, option.matchType, DEBUGMODE_NORMAL);
+                success = !dstImg.empty() && imwrite(sets[k].dstFile, dstImg);
+                if (!success)   errorInfo = "дʧ";
+            }
+        }
+        catch (const exception& e)
+        {
+            errorInfo = e.what();
+        }
+        catch (...)
+        {
+            errorInfo = "δ֪쳣";
+        }
+        latency[k] = chrono::duration<double, milli>(chrono::steady_clock::now() - setBegin).count();
+        if (success)    imgDone += (int)sets[k].imgPaths.size();
+        else            failNum++;
+        cout << getFormatStr("[%d/%d] %s %d %.1fms ", k + 1, (int)sets.size(), sets[k].dstFile.c_str(),
+            (int)sets[k].imgPaths.size(), latency[k]) << (success ? "ɹ" : "ʧ:" + errorInfo) << endl;
+    }
+    return true;
+}
+
+/*
+ * @breif:ƴ,嵥еĸͼƬ޲ͬʱ򰴼ˮ,д̲ͳ
+ * @prama[in]:argc,argv->в
+ * @retval:0->ȫɹ; 1->ʧܵͼƬ
+ */
+inline int batchMosaic(int argc, char* argv[])
+{
+    string manifestFile;
+    batch_option option;
+    vector<batch_set> sets;
+    if (!parseBatchArgs(argc, argv, manifestFile, option))
+    {
+        printBatchUsage();
+        return 1;
+    }
+    if (!loadManifest(manifestFile, sets))
+    {
+        cout << "batchMosaic ޷嵥ļ:" << manifestFile << endl;
+        return 1;
+    }
+    if (option.threads > 0)  setNumThreads(option.threads);
+    if (!option.statsFile.empty() && !mosaicStats::openSink(option.statsFile))
+    {
+        cout << "batchMosaic ޷дͳļ:" << option.statsFile << endl;
+        return 1;
+    }
+
+    atomic<int> nextSet(0), failNum(0), imgDone(0);
+    mutex printLock;
+    vector<double> latency(sets.size(), 0);
+    auto timeBegin = chrono::steady_clock::now();
+    auto worker = [&]()
+    {
+        for (int k = nextSet++; k < (int)sets.size(); k = nextSet++)
+        {
+            auto setBegin = chrono::steady_clock::now();
+            bool success = false;
+            string errorInfo;
+            try
+            {
+                imgProcess handle(sets[k].imgPaths, 1, (size_t)(option.memBudgetMB * 1048576));
+                if (!applyBatchOption(handle, option))  errorInfo = "ͼƬȡʧ";
+                else if (option.unorderedTopK > 0)
+                {
+                    projectImgs(handle);
+                    success = imageMosaicUnordered(handle, option.detectMode, option.matchType, sets[k].dstFile + ".cache",
+                        sets[k].dstFile, option.unorderedTopK);
+                    if (!success)   errorInfo = "޿ƴӶԻдʧ";
+                }
+                else if (option.tiled)
+                {
+                    projectImgs(handle);
+                    success = imageMosaicTiled(handle, option.detectMode, option.matchType, sets[k].dstFile + ".cache",
+                        sets[k].dstFile);
+                    if (!success)   errorInfo = "Ƭдʧ";
+                }
+                else
+                {
+                    Mat dstImg = mosaicSet(handle, option.detectMode, option.matchType, sets[k].dstFile);
+                    success = !dstImg.empty() && imwrite(sets[k].dstFile, dstImg);
+                    if (!success)   errorInfo = "дʧ";
+                }
+            }
+            // ʧ(ƥ㲻㵼OpenCVڴ治)Ӱ
+            catch (const cv::Exception& e)
+            {
+                errorInfo = e.what();
+            }
+            catch (const exception& e)
+            {
+                errorInfo = e.what();
+            }
+            catch (...)
+            {
+                errorInfo = "δ֪쳣";
+            }
+            latency[k] = chrono::duration<double, milli>(chrono::steady_clock::now() - setBegin).count();
+            if (success)    imgDone += (int)sets[k].imgPaths.size();
+            else            failNum++;
+
+            lock_guard<mutex> lock(printLock);
+            cout << getFormatStr("[%d/%d] %s %d %.1fms ", k + 1, (int)sets.size(), sets[k].dstFile.c_str(),
+                (int)sets[k].imgPaths.size(), latency[k]) << (success ? "ɹ" : "ʧ:" + errorInfo) << endl;
+        }
+    };
+    vector<thread> workers;
+    if (!option.calibFile.empty() || !option.rigFile.empty())
+    {
+        if (!batchRig(sets, option, latency, failNum, imgDone))  failNum = (int)sets.size();
+    }
+    else if (option.pipelineDepth > 0 && option.unorderedTopK == 0 && !option.tiled)
+        batchPipeline(sets, option, latency, failNum, imgDone);
+    else for (int i = 0; i < cmpMin(option.inflight, (int)sets.size()); i++)   workers.emplace_back(worker);
+    for (thread& t : workers)   t.join();
+    mosaicStats::closeSink();
+
+    double totalTime = chrono::duration<double>(chrono::steady_clock::now() - timeBegin).count();
+    double maxLatency = sets.empty() ? 0 : *max_element(latency.begin(), latency.end());
+    double meanLatency = 0;
+    for (double t : latency)    meanLatency += t;
+    meanLatency = sets.empty() ? 0 : meanLatency / sets.size();
+    cout << getFormatStr("%d, ʧ%d, ܺʱ%.2fs, ƽӳ%.1fms, ӳ%.1fms, %.2f/s",
+        (int)sets.size(), (int)failNum, totalTime, meanLatency, maxLatency, totalTime > 0 ? imgDone / totalTime : 0.0) << endl;
+    return failNum == 0 ? 0 : 1;
 }
+/*-----------------------------------------------------------------------------------*/
 
 #endif // !MAIN_H
@@ -0,0 +1,172 @@
+/*******************************************************************************
+ *
+ * \file    matPool.cpp
+ * \brief   ּڴأߴ缶𻺴Matڴ棬װΪĬϷ̬²ϵͳ
+ * \author  agent
+ * \version 1.0
+ * \date    2026-10-19
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * -----------------------------------------------------------------------------
+ * ļ޸ʷ
+ * <ʱ>       | <汾>  | <>         |
+ * 2026-10-19  | v1.0    | agent          |
+ * -----------------------------------------------------------------------------
+ ******************************************************************************/
+#include "matPool.h"
+
+/*===================================================================================*/
+/******************************* к *********************************************/
+/*===================================================================================*/
+
+/*
+ * @breif:캯
+ * @prama[in]:minBytes->ڴصС;maxCached->п
+ */
+matPool::matPool(size_t minBytes, size_t maxCached)
+{
+	matPool::minBytes = minBytes;
+	matPool::maxCached = maxCached;
+	matPool::stats = { 0, 0, 0, 0 };
+}
+
+matPool::~matPool()
+{
+	matPool::trim();
+}
+
+/*
+ * @breif:MatAllocatorӿ,鰴ߴ缶ӻȡ,ͷʱŻػ
+ */
+UMatData* matPool::allocate(int dims, const int* sizes, int type, void* data, size_t* step, AccessFlag flags,
+	UMatUsageFlags usageFlags) const
+{
+	// ⲿС齻ĬϷ
+	size_t total = CV_ELEM_SIZE(type);
+	for (int i = 0; i < dims; i++)	total *= sizes[i];
+	if (data != NULL || total < matPool::minBytes)
+		return Mat::getStdAllocator()->allocate(dims, sizes, type, data, step, flags, usageFlags);
+
+	// ĬϷͬ洢
+	if (step != NULL)
+	{
+		size_t rowStep = CV_ELEM_SIZE(type);
+		for (int i = dims - 1; i >= 0; i--)
+		{
+			step[i] = rowStep;
+			rowStep *= sizes[i];
+		}
+	}
+
+	size_t blockSize = matPool::classSize(total);
+	uchar* block = NULL;
+	{
+		lock_guard<mutex> lock(matPool::poolMutex);
+		vector<uchar*>& blocks = matPool::freeBlocks[blockSize];
+		if (!blocks.empty())
+		{
+			block = blocks.back();
+			blocks.pop_back();
+			matPool::stats.cachedBytes -= blockSize;
+			matPool::stats.hitNum++;
+		}
+		else
+		{
+			matPool::stats.missNum++;
+			matPool::stats.missBytes += blockSize;
+		}
+	}
+	if (block == NULL)	block = (uchar*)fastMalloc(blockSize);
+
+	UMatData* u = new UMatData(this);
+	u->data = u->origdata = block;
+	u->size = total;
+	return u;
+}
+
+bool matPool::allocate(UMatData* data, AccessFlag accessFlags, UMatUsageFlags usageFlags) const
+{
+	return data != NULL;
+}
+
+void matPool::deallocate(UMatData* data) const
+{
+	if (data == NULL)	return;
+	size_t blockSize = matPool::classSize(data->size);
+	bool cached = false;
+	{
+		lock_guard<mutex> lock(matPool::poolMutex);
+		if (matPool::stats.cachedBytes + blockSize <= matPool::maxCached)
+		{
+			matPool::freeBlocks[blockSize].push_back(data->origdata);
+			matPool::stats.cachedBytes += blockSize;
+			cached = true;
+		}
+	}
+	if (!cached)	fastFree(data->origdata);
+	delete data;
+}
+
+/*
+ * @breif:ͷȫĿп
+ * @prama[in]:None
+ * @retval:None
+ */
+void matPool::trim()
+{
+	lock_guard<mutex> lock(matPool::poolMutex);
+	for (auto& blocks : matPool::freeBlocks)
+		for (uchar* block : blocks.second)	fastFree(block);
+	matPool::freeBlocks.clear();
+	matPool::stats.cachedBytes = 0;
+}
+
+/*
+ * @breif:ȡСδ뻺ͳ
+ * @prama[in]:None
+ * @retval:ͳƽ
+ */
+matPool::pool_stats matPool::getStats()
+{
+	lock_guard<mutex> lock(matPool::poolMutex);
+	return matPool::stats;
+}
+
+/*
+ * @breif:ΨһڴزװΪMatĬϷ,ظ÷ͬһʵ
+ * @note:Ӧ״ʹmosaicStats֮ǰ,ͳƷװʱĬϷ
+ * @prama[in]:None
+ * @retval:ڴ
+ */
+matPool* matPool::install()
+{
+	// :˳ʱԿMatгеĿ
+	static matPool* pool = []()
+	{
+		matPool* instance = new matPool();
+		Mat::setDefaultAllocator(instance);
+		return instance;
+	}();
+	return pool;
+}
+/*-----------------------------------------------------------------------------------*/
+
+
+/*===================================================================================*/
+/******************************* ˽к *********************************************/
+/*===================================================================================*/
+
+/*
+ * @breif:ߴ缶,2Ϊÿĵȷ,˷Ѳ25%
+ * @prama[in]:bytes->
+ * @retval:ĿС
+ */
+size_t matPool::classSize(size_t bytes)
+{
+	size_t base = 1;
+	while (base <= bytes / 2)	base *= 2;
+	size_t quarter = max(base / 4, (size_t)1);
+	return (bytes + quarter - 1) / quarter * quarter;
+}
+/*-----------------------------------------------------------------------------------*/
@@ -0,0 +1,101 @@
+/*******************************************************************************
+ *
+ * \file    matPool.h
+ * \brief   ּڴأߴ缶𻺴Matڴ棬װΪĬϷ̬²ϵͳ
+ * \author  agent
+ * \version 1.0
+ * \date    2026-10-19
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * -----------------------------------------------------------------------------
+ * ļ޸ʷ
+ * <ʱ>       | <汾>  | <>         |
+ * 2026-10-19  | v1.0    | agent          |
+ * -----------------------------------------------------------------------------
+ ******************************************************************************/
+#include <opencv2/core.hpp>
+#include "publicElement.h"
+#include <iostream>
+#include <map>
+#include <vector>
+#include <mutex>
+using namespace cv;
+using namespace std;
+
+/*===================================================================================*/
+/******************************** 궨 *********************************************/
+/*===================================================================================*/
+#define MATPOOL_MINBYTES		65536							// ڴصС,СĿ齻ĬϷ .byte
+#define MATPOOL_MAXCACHED	((size_t)1 << 30)					// п .byte
+/*-----------------------------------------------------------------------------------*/
+
+#pragma once
+#ifndef MATPOOL_H
+#define MATPOOL_H
+
+class matPool : public MatAllocator
+{
+public:
+	typedef struct
+	{
+		size_t hitNum;								// ɻ
+		size_t missNum;								// ϵͳĴ
+		size_t missBytes;							// ϵͳ .byte
+		size_t cachedBytes;							// ǰĿп .byte
+	}pool_stats;
+
+public:
+	/*
+	 * @breif:캯
+	 * @prama[in]:minBytes->ڴصС;maxCached->п
+	 */
+	matPool(size_t minBytes = MATPOOL_MINBYTES, size_t maxCached = MATPOOL_MAXCACHED);
+	~matPool();
+
+	/*
+	 * @breif:MatAllocatorӿ,鰴ߴ缶ӻȡ,ͷʱŻػ
+	 */
+	UMatData* allocate(int dims, const int* sizes, int type, void* data, size_t* step, AccessFlag flags,
+		UMatUsageFlags usageFlags) const override;
+	bool allocate(UMatData* data, AccessFlag accessFlags, UMatUsageFlags usageFlags) const override;
+	void deallocate(UMatData* data) const override;
+
+	/*
+	 * @breif:ͷȫĿп
+	 * @prama[in]:None
+	 * @retval:None
+	 */
+	void trim();
+
+	/*
+	 * @breif:ȡСδ뻺ͳ
+	 * @prama[in]:None
+	 * @retval:ͳƽ
+	 */
+	pool_stats getStats();
+
+	/*
+	 * @breif:ΨһڴزװΪMatĬϷ,ظ÷ͬһʵ
+	 * @note:Ӧ״ʹmosaicStats֮ǰ,ͳƷװʱĬϷ
+	 * @prama[in]:None
+	 * @retval:ڴ
+	 */
+	static matPool* install();
+
+private:
+	size_t minBytes;								// ڴصС
+	size_t maxCached;								// п
+	mutable mutex poolMutex;						// 
+	mutable map<size_t, vector<uchar*>> freeBlocks;	// ߴ缶ŵĿп
+	mutable pool_stats stats;						// ͳ
+
+	/*
+	 * @breif:ߴ缶,2Ϊÿĵȷ,˷Ѳ25%
+	 * @prama[in]:bytes->
+	 * @retval:ĿС
+	 */
+	static size_t classSize(size_t bytes);
+};
+
+#endif // !MATPOOL_H
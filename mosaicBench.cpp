@@ -0,0 +1,658 @@
+/*******************************************************************************
+ *
+ * \file    mosaicBench.cpp
+ * \brief   ƴȵ㺯΢׼ԣϳȷ룬ͼߴɨ
+ * \author  agent
+ * \version 1.0
+ * \date    2026-10-19
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * -----------------------------------------------------------------------------
+ * ļ޸ʷ
+ * <ʱ>       | <汾>  | <>         |
+ * 2026-10-19  | v1.0    | agent          |
+ * -----------------------------------------------------------------------------
+ ******************************************************************************/
+#include "mosaicBench.h"
+#include "mosaicE2E.h"
+#include "matPool.h"
+
+/*===================================================================================*/
+/******************************* к *********************************************/
+/*===================================================================================*/
+
+/*
+ * @breif:캯,Ĭɨ640x480/1280x720/1920x1080500/2000/80001/10/100
+ */
+mosaicBench::mosaicBench()
+{
+	mosaicBench::imgSizes = { Size(640, 480), Size(1280, 720), Size(1920, 1080) };
+	mosaicBench::keyPtNums = { 500, 2000, 8000 };
+	mosaicBench::annSizes = { 10000, 100000, 1000000 };
+	mosaicBench::repeat = BENCH_REPEAT;
+}
+
+/*
+ * @breif:ȫɨ
+ * @prama[in]:None
+ * @retval:None
+ */
+void mosaicBench::runAll()
+{
+	mosaicBench::results.clear();
+	for (const Size& imgSize : mosaicBench::imgSizes)	mosaicBench::runImgKernels(imgSize);
+	for (int keyPtNum : mosaicBench::keyPtNums)			mosaicBench::runPointKernels(keyPtNum);
+	mosaicBench::runBundleKernels();
+	mosaicBench::runVocabKernels();
+	for (int descNum : mosaicBench::annSizes)			mosaicBench::runAnnKernels(descNum);
+}
+
+/*
+ * @breif:JSONCSVʽ
+ * @prama[in]:fileName->ļ·
+ * @retval:true->ɹ; false->ļ޷д
+ */
+bool mosaicBench::writeJson(string fileName)
+{
+	ofstream file(fileName);
+	if (!file.is_open())	return false;
+
+	file << "{\n  \"opencv\": \"" << CV_VERSION << "\",\n  \"threads\": " << getNumThreads()
+		<< ",\n  \"seed\": " << BENCH_SEED << ",\n  \"results\": [\n";
+	for (size_t i = 0; i < mosaicBench::results.size(); i++)
+	{
+		const bench_result& r = mosaicBench::results[i];
+		file << getFormatStr("    {\"kernel\": \"%s\", \"width\": %d, \"height\": %d, \"keypoints\": %d, \"repeat\": %d, "
+			"\"min_ms\": %.4f, \"median_ms\": %.4f, \"mean_ms\": %.4f, \"recall\": %.4f}", r.kernel.c_str(), r.imgSize.width,
+			r.imgSize.height, r.keyPtNum, r.repeat, r.minMs, r.medianMs, r.meanMs, r.recall)
+			<< (i + 1 < mosaicBench::results.size() ? ",\n" : "\n");
+	}
+	file << "  ]\n}\n";
+	return file.good();
+}
+
+bool mosaicBench::writeCsv(string fileName)
+{
+	ofstream file(fileName);
+	if (!file.is_open())	return false;
+
+	file << "kernel,width,height,keypoints,repeat,min_ms,median_ms,mean_ms,recall\n";
+	for (const bench_result& r : mosaicBench::results)
+	{
+		file << getFormatStr("%s,%d,%d,%d,%d,%.4f,%.4f,%.4f,%.4f\n", r.kernel.c_str(), r.imgSize.width, r.imgSize.height,
+			r.keyPtNum, r.repeat, r.minMs, r.medianMs, r.meanMs, r.recall);
+	}
+	return file.good();
+}
+/*-----------------------------------------------------------------------------------*/
+
+
+/*===================================================================================*/
+/******************************* ˽к *********************************************/
+/*===================================================================================*/
+
+/*
+ * @breif:ͼߴص:Ӧӳ䡢ƴӷŻ
+ * @prama[in]:imgSize->ϳͼߴ
+ * @retval:None
+ */
+void mosaicBench::runImgKernels(Size imgSize)
+{
+	featureDesc featureDescHandle;
+	imgProcess imgProcessHandle;
+	homoEst homographyMap;
+	Mat leftImg = mosaicBench::makeSyntheticImg(imgSize, BENCH_SEED);
+	Mat grayImg, Desc;
+	vector<KeyPoint> keyPt;
+	cvtColor(leftImg, grayImg, COLOR_RGB2GRAY);
+
+	mosaicBench::timeKernel("getFeatureDesc_ORB", imgSize, 0, [&]() { featureDescHandle.getFeatureDesc_ORB(grayImg, keyPt, Desc); });
+	mosaicBench::timeKernel("getFeatureDesc_SIFT", imgSize, 0, [&]() { featureDescHandle.getFeatureDesc_SIFT(grayImg, keyPt, Desc); });
+	mosaicBench::timeKernel("getFeatureDesc_BRISK", imgSize, 0, [&]() { featureDescHandle.getFeatureDesc_BRISK(grayImg, keyPt, Desc); });
+
+	// ͼΪͼһӽ,ӳͼƴ
+	Mat H = mosaicBench::makeSyntheticHomo(imgSize);
+	Mat Hinv = H.inv();
+	Size mapSize((int)(imgSize.width * (2 - BENCH_OVERLAP)), imgSize.height);
+	Mat sceneImg = mosaicBench::makeSyntheticImg(mapSize, BENCH_SEED + 1), rightImg, mapImg;
+	validMask mapMask;
+	leftImg = sceneImg(Rect(0, 0, imgSize.width, imgSize.height)).clone();
+	warpPerspective(sceneImg, rightImg, Hinv, imgSize);
+	mosaicBench::timeKernel("imgMapByHomo", imgSize, 0, [&]() { homographyMap.imgMapByHomo(rightImg, H, mapSize, mapImg, mapMask); });
+
+	// ͶӰ:ӳֻڽߴ仯ʱ,ֻ֡remap
+	projWarper warper;
+	Mat projImg;
+	mosaicBench::timeKernel("projWarper_build", imgSize, 0, [&]() { warper.build(PROJMODE_CYLINDER, imgSize.width, imgSize); });
+	mosaicBench::timeKernel("projWarper_apply", imgSize, 0, [&]() { warper.apply(rightImg, projImg); });
+
+	Mat dstImg, blendImg;
+	mosaicBench::timeKernel("imgMosaic", imgSize, 0, [&]() { imgProcessHandle.imgMosaic(leftImg, mapImg, mapMask, dstImg); });
+	int leftBound = (int)(imgSize.width * (1 - BENCH_OVERLAP));
+	mosaicBench::timeKernel("seamOpt_alpha", imgSize, 0, [&]()
+	{
+		imgProcessHandle.seamOpt_alpha(leftImg, mapImg, mapMask, dstImg, leftBound, imgSize.width);
+	});
+	mosaicBench::timeKernel("seamOpt_laplace", imgSize, 0, [&]()
+	{
+		imgProcessHandle.seamOpt_laplace(mapImg, dstImg, blendImg, 0.35f, DEBUGMODE_NORMAL);
+	});
+}
+
+/*
+ * @breif:ص:ƥ(һԶƥ)ڵ㡢Ӧ⡢RANSAC
+ * @prama[in]:keyPtNum->ϳ
+ * @retval:None
+ */
+void mosaicBench::runPointKernels(int keyPtNum)
+{
+	featureMatch featureMatchHandle;
+	Mat descFloat_1, descFloat_2, descBinary_1, descBinary_2;
+	mosaicBench::makeSyntheticDesc(keyPtNum, MATCHMODE_NORML2, descFloat_1, descFloat_2);
+	mosaicBench::makeSyntheticDesc(keyPtNum, MATCHMODE_HAMMING, descBinary_1, descBinary_2);
+	vector<DMatch> matches;
+	mosaicBench::timeKernel("featureMatch_MinMax_L2", Size(), keyPtNum, [&]()
+	{
+		matches = featureMatchHandle.featureMatch_MinMax(descFloat_1, descFloat_2, 2, MATCHMODE_NORML2);
+	});
+	mosaicBench::timeKernel("featureMatch_MinMax_Hamming", Size(), keyPtNum, [&]()
+	{
+		matches = featureMatchHandle.featureMatch_MinMax(descBinary_1, descBinary_2, 2.4f, MATCHMODE_HAMMING);
+	});
+	mosaicBench::timeKernel("featureMatch_Lows_L2", Size(), keyPtNum, [&]()
+	{
+		matches = featureMatchHandle.featureMatch_Lows(descFloat_1, descFloat_2, 0.5f, MATCHMODE_NORML2);
+	});
+	mosaicBench::timeKernel("featureMatch_Lows_Hamming", Size(), keyPtNum, [&]()
+	{
+		matches = featureMatchHandle.featureMatch_Lows(descBinary_1, descBinary_2, 0.5f, MATCHMODE_HAMMING);
+	});
+	mosaicBench::timeKernel("pipeline_MinMax_L2", Size(), keyPtNum, [&]() { matches = siftPipeline::descMatch(descFloat_1, descFloat_2); });
+	mosaicBench::timeKernel("pipeline_MinMax_Hamming", Size(), keyPtNum, [&]() { matches = orbPipeline::descMatch(descBinary_1, descBinary_2); });
+	mosaicBench::timeKernel("pipeline_Lows_Hamming", Size(), keyPtNum, [&]() { matches = orbLowsPipeline::descMatch(descBinary_1, descBinary_2); });
+
+	// һͼBENCH_PARTNERSͼƥ:ԵһԶֿ
+	vector<Mat> partnersFloat, partnersBinary;
+	for (int k = 0; k < BENCH_PARTNERS; k++)
+	{
+		partnersFloat.push_back(k % 2 ? descFloat_1 : descFloat_2);
+		partnersBinary.push_back(k % 2 ? descBinary_1 : descBinary_2);
+	}
+	vector<vector<DMatch>> partnerMatches(BENCH_PARTNERS);
+	mosaicBench::timeKernel("pipeline_MinMax_L2_xK", Size(), keyPtNum, [&]()
+	{
+		for (int k = 0; k < BENCH_PARTNERS; k++)	partnerMatches[k] = siftPipeline::descMatch(descFloat_1, partnersFloat[k]);
+	});
+	mosaicBench::timeKernel("pipeline_MinMaxBatch_L2_xK", Size(), keyPtNum, [&]()
+	{
+		partnerMatches = siftPipeline::descMatchBatch(descFloat_1, partnersFloat);
+	});
+	mosaicBench::timeKernel("pipeline_MinMax_Hamming_xK", Size(), keyPtNum, [&]()
+	{
+		for (int k = 0; k < BENCH_PARTNERS; k++)	partnerMatches[k] = orbPipeline::descMatch(descBinary_1, partnersBinary[k]);
+	});
+	mosaicBench::timeKernel("pipeline_MinMaxBatch_Hamming_xK", Size(), keyPtNum, [&]()
+	{
+		partnerMatches = orbPipeline::descMatchBatch(descBinary_1, partnersBinary);
+	});
+
+	Size imgSize(1280, 720);
+	Mat H = mosaicBench::makeSyntheticHomo(imgSize), H_32;
+	H.convertTo(H_32, CV_32F);
+	vector<Point2f> ptSrc, ptDst;
+	vector<size_t> inliers, allIdx(keyPtNum);
+	for (int i = 0; i < keyPtNum; i++)	allIdx[i] = i;
+	mosaicBench::makeSyntheticPts(keyPtNum, imgSize, H, ptSrc, ptDst);
+
+	mosaicBench::timeKernel("CalculateInliers", Size(), keyPtNum, [&]() { CalculateInliers(ptSrc, ptDst, H_32, 3, inliers); });
+	mosaicBench::timeKernel("CalculateHomographyMatrix", Size(), keyPtNum, [&]() { CalculateHomographyMatrix(ptSrc, ptDst, allIdx); });
+
+	mosaicBench::timeKernel("GetHomographyRANSAC", Size(), keyPtNum, [&]()
+	{
+		Mat bestH;
+		GetHomographyRANSAC(ptSrc, ptDst, 4, bestH, inliers, 3, 2000, 0.995f);
+	});
+	mosaicBench::timeKernel("SelectMotionModel", Size(), keyPtNum, [&]()
+	{
+		Mat bestH;
+		size_t iters;
+		SelectMotionModel(ptSrc, ptDst, bestH, inliers, 3, 2000, 0.995f, 1.0f, iters);
+	});
+
+	// ѡΪĿFEATURE_OVERSAMPLE,޶ʱORBһ
+	RNG rng(BENCH_SEED);
+	vector<KeyPoint> candidates(keyPtNum * FEATURE_OVERSAMPLE), selected;
+	for (KeyPoint& kp : candidates)
+	{
+		kp.pt = Point2f(rng.uniform(0.f, (float)imgSize.width), rng.uniform(0.f, (float)imgSize.height));
+		kp.response = rng.uniform(0.f, 1.f);
+	}
+	mosaicBench::timeKernel("selectKeyPoints_SSC", Size(), keyPtNum, [&]()
+	{
+		selected = candidates;
+		featureDesc::selectKeyPoints_SSC(selected, keyPtNum, imgSize);
+	});
+}
+
+/*
+ * @breif:ȫֹƽ:BENCH_BAVIEWSͼ,ڼһƴӶ,ֵΪ۳˴ƯƵĵӦ
+ * @prama[in]:None
+ * @retval:None
+ */
+void mosaicBench::runBundleKernels()
+{
+	RNG rng(BENCH_SEED);
+	Size imgSize(1280, 720);
+	int viewNum = BENCH_BAVIEWS;
+
+	// ֵ:ͼˮƽ,΢תλŶ
+	vector<Mat> truthHomo(viewNum);
+	for (int i = 0; i < viewNum; i++)
+	{
+		double angle = i ? rng.gaussian(0.005) : 0;
+		double tx = i * imgSize.width * (1 - BENCH_OVERLAP) + (i ? rng.gaussian(2.0) : 0);
+		double ty = i ? rng.gaussian(2.0) : 0;
+		truthHomo[i] = (Mat_<double>(3, 3) << cos(angle), -sin(angle), tx, sin(angle), cos(angle), ty, 0, 0, 1);
+	}
+
+	bundleAdjust adjuster;
+	for (int i = 0; i < viewNum; i++)
+	{
+		for (int j = i + 1; j <= i + 2 && j < viewNum; j++)
+		{
+			vector<Point2f> ptLeft, ptRight(BENCH_BAPAIRPTS);
+			for (Point2f& p : ptRight)	p = Point2f(rng.uniform(0.f, (float)imgSize.width), rng.uniform(0.f, (float)imgSize.height));
+			perspectiveTransform(ptRight, ptLeft, truthHomo[i].inv() * truthHomo[j]);
+			for (Point2f& p : ptLeft)	p += Point2f((float)rng.gaussian(BENCH_NOISE), (float)rng.gaussian(BENCH_NOISE));
+			adjuster.addPair(i, j, ptLeft, ptRight);
+		}
+	}
+
+	// ۳˵ĳֵ,ÿԴԼ1صƽ
+	vector<Mat> initHomo(viewNum);
+	initHomo[0] = Mat::eye(3, 3, CV_64F);
+	for (int i = 1; i < viewNum; i++)
+	{
+		Mat drift = (Mat_<double>(3, 3) << 1, 0, rng.gaussian(1.0), 0, 1, rng.gaussian(1.0), 0, 0, 1);
+		initHomo[i] = initHomo[i - 1] * truthHomo[i - 1].inv() * truthHomo[i] * drift;
+	}
+
+	int matchNum = (int)adjuster.pairs.size() * BENCH_BAPAIRPTS;
+	mosaicBench::timeKernel("bundleAdjust", Size(), matchNum, [&]()
+	{
+		adjuster.homoToRef = initHomo;
+		adjuster.optimize();
+	});
+}
+
+/*
+ * @breif:ʻ:BENCH_VOCABIMGSϳͼ,ͼһ,ʱѵѡƴӶɸѡ
+ * @prama[in]:None
+ * @retval:None
+ */
+void mosaicBench::runVocabKernels()
+{
+	int imgNum = BENCH_VOCABIMGS, descNum = BENCH_VOCABDESCS;
+	int poolNum = (imgNum + 1) * descNum / 2;
+	vector<pair<string, int>> modes = { { "L2", MATCHMODE_NORML2 }, { "Hamming", MATCHMODE_HAMMING } };
+	for (const pair<string, int>& mode : modes)
+	{
+		// iͼȡӳص[i*descNum/2, i*descNum/2+descNum),ģҰص
+		Mat pool, poolShuffled;
+		mosaicBench::makeSyntheticDesc(poolNum, mode.second, pool, poolShuffled);
+		vector<Mat> descs(imgNum);
+		for (int i = 0; i < imgNum; i++)	descs[i] = pool.rowRange(i * descNum / 2, i * descNum / 2 + descNum);
+
+		vocabTree vocab;
+		vector<pair<int, int>> candidates;
+		int descTotal = imgNum * descNum;
+		mosaicBench::timeKernel("vocabTree_train_" + mode.first, Size(), descTotal, [&]() { vocab.train(descs); });
+		mosaicBench::timeKernel("vocabTree_candidates_" + mode.first, Size(), descTotal, [&]()
+		{
+			for (int i = 0; i < imgNum; i++)	vocab.addImage(i, descs[i]);
+			vocab.build();
+			candidates = vocab.candidatePairs(VOCAB_TOPK);
+		});
+	}
+}
+
+/*
+ * @breif:ڼ:BENCH_ANNQUERIESѯdescNum128άν,
+ *        Աȱƥ䡢FLANNKD(ÿؽ,featureMatch_Lowsһ)HNSWĺʱrecall@2
+ * @prama[in]:descNum->
+ * @retval:None
+ */
+void mosaicBench::runAnnKernels(int descNum)
+{
+	// ʱֵ
+	bool selected = mosaicBench::filter.empty();
+	for (string kernel : { "ann_bf_knn2", "ann_flann_knn2", "ann_hnsw_build", "ann_hnsw_knn2" })
+		selected = selected || kernel.find(mosaicBench::filter) != string::npos;
+	if (!selected)	return;
+	Mat baseDesc, queryDesc;
+	mosaicBench::makeClusteredDesc(descNum, BENCH_ANNQUERIES, baseDesc, queryDesc);
+
+	// ֵֻνھ,Ծȷ,ʱ
+	vector<DMatch> bestMatch;
+	vector<float> secondDist;
+	bruteForceKnn2<l2Distance>(queryDesc, baseDesc, bestMatch, secondDist);
+
+	vector<vector<DMatch>> matches;
+	mosaicBench::timeKernel("ann_bf_knn2", Size(), descNum, [&]()
+	{
+		BFMatcher matcher(NORM_L2);
+		matcher.knnMatch(queryDesc, baseDesc, matches, 2);
+	}, BENCH_ANNREPEAT);
+	mosaicBench::recordRecall("ann_bf_knn2", matches, secondDist);
+	matches.clear();
+	mosaicBench::timeKernel("ann_flann_knn2", Size(), descNum, [&]()
+	{
+		FlannBasedMatcher matcher;
+		matcher.add(vector<Mat>(1, baseDesc));
+		matcher.train();
+		matcher.knnMatch(queryDesc, matches, 2);
+	}, BENCH_ANNREPEAT);
+	mosaicBench::recordRecall("ann_flann_knn2", matches, secondDist);
+	matches.clear();
+
+	hnswIndex index;
+	mosaicBench::timeKernel("ann_hnsw_build", Size(), descNum, [&]() { index.build(baseDesc); }, BENCH_ANNREPEAT);
+	if (index.empty())	index.build(baseDesc);
+	mosaicBench::timeKernel("ann_hnsw_knn2", Size(), descNum, [&]() { index.knnMatch(queryDesc, matches, 2); }, BENCH_ANNREPEAT);
+	mosaicBench::recordRecall("ann_hnsw_knn2", matches, secondDist);
+	cerr << getFormatStr("%-28s %d ڴ%.1fMB", "ann_hnsw_build", descNum, index.memoryBytes() / 1048576.0) << endl;
+}
+
+/*
+ * @breif:Ԥһκʱrepeat,¼Сλƽʱ
+ * @prama[in]:kernel->;imgSize,keyPtNum->ɨ;func->⺯;repeat->ʱ,0ΪȡmosaicBench::repeat
+ * @retval:None
+ */
+void mosaicBench::timeKernel(string kernel, Size imgSize, int keyPtNum, function<void()> func, int repeat)
+{
+	if (!mosaicBench::filter.empty() && kernel.find(mosaicBench::filter) == string::npos)	return;
+
+	func();
+	vector<double> times(cmpMax(repeat > 0 ? repeat : mosaicBench::repeat, 1));
+	for (double& t : times)
+	{
+		auto timeBegin = chrono::steady_clock::now();
+		func();
+		t = chrono::duration<double, milli>(chrono::steady_clock::now() - timeBegin).count();
+	}
+	vector<double> sorted = times;
+	sort(sorted.begin(), sorted.end());
+	double sum = 0;
+	for (double t : times)	sum += t;
+
+	bench_result r = { kernel, imgSize, keyPtNum, (int)times.size(), sorted.front(), sorted[sorted.size() / 2], sum / times.size(),
+		-1 };
+	mosaicBench::results.push_back(r);
+	cerr << getFormatStr("%-28s %5dx%-5d kp=%-6d min %9.3fms  median %9.3fms  mean %9.3fms", kernel.c_str(),
+		imgSize.width, imgSize.height, keyPtNum, r.minMs, r.medianMs, r.meanMs) << endl;
+}
+
+/*
+ * @breif:ΪһμʱĽڼ¼recall@2,ھ벻ʵνھ뼴Ϊ
+ * @prama[in]:kernel->;matches->Ľ;secondDist->ѯʵνڵL2ƽ
+ * @retval:None
+ */
+void mosaicBench::recordRecall(string kernel, const vector<vector<DMatch>>& matches, const vector<float>& secondDist)
+{
+	if (mosaicBench::results.empty() || mosaicBench::results.back().kernel != kernel || matches.empty())	return;
+	size_t hitNum = 0;
+	for (size_t i = 0; i < matches.size() && i < secondDist.size(); i++)
+	{
+		// ȵĽȡһ,ݲǿ벻ͬʵֵ
+		for (size_t j = 0; j < matches[i].size() && j < 2; j++)
+			if (matches[i][j].distance * matches[i][j].distance <= secondDist[i] * 1.0001f)	hitNum++;
+	}
+	bench_result& r = mosaicBench::results.back();
+	r.recall = (double)hitNum / (2 * matches.size());
+	cerr << getFormatStr("%-28s recall@2 %.4f  %.0fѯ/s", kernel.c_str(), r.recall,
+		matches.size() / (r.medianMs / 1000)) << endl;
+}
+
+/*
+ * @breif:ȷԵĺϳͼ,ƽͼϵɫ,֤㹻ǵ
+ * @prama[in]:imgSize->ͼߴ;seed->
+ * @retval:ϳͼ(CV_8UC3)
+ */
+Mat mosaicBench::makeSyntheticImg(Size imgSize, uint64 seed)
+{
+	RNG rng(seed);
+	Mat lowImg(cmpMax(imgSize.height / 16, 2), cmpMax(imgSize.width / 16, 2), CV_8UC3), dstImg;
+	rng.fill(lowImg, RNG::UNIFORM, Scalar::all(0), Scalar::all(256));
+	resize(lowImg, dstImg, imgSize, 0, 0, INTER_CUBIC);
+
+	int shapeNum = imgSize.area() / 2000;
+	for (int i = 0; i < shapeNum; i++)
+	{
+		Point center(rng.uniform(0, imgSize.width), rng.uniform(0, imgSize.height));
+		Scalar color(rng.uniform(0, 256), rng.uniform(0, 256), rng.uniform(0, 256));
+		int radius = rng.uniform(3, 20);
+		if (i % 2)	circle(dstImg, center, radius, color, FILLED);
+		else		rectangle(dstImg, Rect(center.x, center.y, radius * 2, radius), color, FILLED);
+	}
+	return dstImg;
+}
+
+/*
+ * @breif:ɺϳͼ֮ĵӦ(ͼƽƵͼҲಢ΢ת͸)
+ * @prama[in]:imgSize->ͼߴ
+ * @retval:ͼͼĵӦ(CV_64F)
+ */
+Mat mosaicBench::makeSyntheticHomo(Size imgSize)
+{
+	double angle = 0.02, tx = imgSize.width * (1 - BENCH_OVERLAP), ty = imgSize.height * 0.01;
+	return (Mat_<double>(3, 3) << cos(angle), -sin(angle), tx,
+		sin(angle), cos(angle), ty,
+		1e-5, 0, 1);
+}
+
+/*
+ * @breif:ɺϳƥ,ڵ㾭Hӳ䲢,
+ * @prama[in]:num->;imgSize->ȡֵΧ;H->Ӧ;ptSrc,ptDst->ƥ
+ * @retval:None
+ */
+void mosaicBench::makeSyntheticPts(int num, Size imgSize, const Mat& H, vector<Point2f>& ptSrc, vector<Point2f>& ptDst)
+{
+	RNG rng(BENCH_SEED);
+	ptSrc.resize(num);
+	for (Point2f& p : ptSrc)	p = Point2f(rng.uniform(0.f, (float)imgSize.width), rng.uniform(0.f, (float)imgSize.height));
+	perspectiveTransform(ptSrc, ptDst, H);
+	for (Point2f& p : ptDst)
+	{
+		if (rng.uniform(0.0, 1.0) < BENCH_OUTLIER)
+			p = Point2f(rng.uniform(0.f, 2.f * imgSize.width), rng.uniform(0.f, (float)imgSize.height));
+		else
+			p += Point2f((float)rng.gaussian(BENCH_NOISE), (float)rng.gaussian(BENCH_NOISE));
+	}
+}
+
+/*
+ * @breif:ɺϳӶ,ڶΪһ˳򲢼ŶĽ
+ * @prama[in]:num->;matchMode->MATCHMODE_NORML2(128ά)MATCHMODE_HAMMING(256λ)
+ * @prama[in]:desc_1,desc_2->
+ * @retval:None
+ */
+void mosaicBench::makeSyntheticDesc(int num, int matchMode, Mat& desc_1, Mat& desc_2)
+{
+	RNG rng(BENCH_SEED + matchMode);
+	vector<int> order(num);
+	for (int i = 0; i < num; i++)	order[i] = i;
+	for (int i = num - 1; i > 0; i--)	swap(order[i], order[rng.uniform(0, i + 1)]);
+
+	if (matchMode == MATCHMODE_NORML2)
+	{
+		desc_1.create(num, 128, CV_32F);
+		rng.fill(desc_1, RNG::UNIFORM, Scalar::all(0), Scalar::all(128));
+		desc_2.create(num, 128, CV_32F);
+		for (int i = 0; i < num; i++)
+		{
+			Mat noise(1, 128, CV_32F);
+			rng.fill(noise, RNG::NORMAL, Scalar::all(0), Scalar::all(8));
+			Mat row = desc_1.row(order[i]) + noise;
+			row.copyTo(desc_2.row(i));
+		}
+	}
+	else
+	{
+		desc_1.create(num, 32, CV_8U);
+		rng.fill(desc_1, RNG::UNIFORM, Scalar::all(0), Scalar::all(256));
+		desc_2.create(num, 32, CV_8U);
+		for (int i = 0; i < num; i++)
+		{
+			desc_1.row(order[i]).copyTo(desc_2.row(i));
+			uchar* rowAddr = desc_2.ptr<uchar>(i);
+			for (int k = 0; k < 16; k++)	rowAddr[rng.uniform(0, 32)] ^= (uchar)(1 << rng.uniform(0, 8));
+		}
+	}
+}
+
+/*
+ * @breif:ɾֲ128ά,ѯΪȡӼŶ
+ * @prama[in]:num->;queryNum->ѯ;baseDesc,queryDesc->
+ * @retval:None
+ */
+void mosaicBench::makeClusteredDesc(int num, int queryNum, Mat& baseDesc, Mat& queryDesc)
+{
+	// ȷֲĸάûнڽṹ,Ʒ˻,ʵӵľ
+	RNG rng(BENCH_SEED + num);
+	Mat centers(BENCH_ANNCENTERS, 128, CV_32F);
+	rng.fill(centers, RNG::UNIFORM, Scalar::all(0), Scalar::all(128));
+	baseDesc.create(num, 128, CV_32F);
+	rng.fill(baseDesc, RNG::NORMAL, Scalar::all(0), Scalar::all(16));
+	for (int i = 0; i < num; i++)	baseDesc.row(i) += centers.row(rng.uniform(0, BENCH_ANNCENTERS));
+	queryDesc.create(queryNum, 128, CV_32F);
+	rng.fill(queryDesc, RNG::NORMAL, Scalar::all(0), Scalar::all(8));
+	for (int i = 0; i < queryNum; i++)	queryDesc.row(i) += baseDesc.row(rng.uniform(0, num));
+}
+/*-----------------------------------------------------------------------------------*/
+
+
+/*===================================================================================*/
+/**********************************  *********************************************/
+/*===================================================================================*/
+
+/*
+ * @breif:"a,b,c"ʽб"WxH,WxH"ʽĳߴб
+ * @prama[in]:str->ַ
+ * @retval:
+ */
+static vector<int> parseIntList(string str)
+{
+	vector<int> values;
+	stringstream stream(str);
+	string item;
+	while (getline(stream, item, ','))	if (!item.empty())	values.push_back(atoi(item.c_str()));
+	return values;
+}
+
+static vector<double> parseDoubleList(string str)
+{
+	vector<double> values;
+	stringstream stream(str);
+	string item;
+	while (getline(stream, item, ','))	if (!item.empty())	values.push_back(atof(item.c_str()));
+	return values;
+}
+
+static vector<Size> parseSizeList(string str)
+{
+	vector<Size> sizes;
+	stringstream stream(str);
+	string item;
+	while (getline(stream, item, ','))
+	{
+		int width = 0, height = 0;
+		if (sscanf(item.c_str(), "%dx%d", &width, &height) == 2 && width > 0 && height > 0)	sizes.push_back(Size(width, height));
+	}
+	return sizes;
+}
+
+int main(int argc, char* argv[])
+{
+	mosaicBench bench;
+	mosaicE2E e2e;
+	string mode = "kernel", jsonFile, csvFile;
+	bool valid = true;
+	for (int i = 1; i < argc && valid; i += 2)
+	{
+		string arg = argv[i], value = (i + 1 < argc) ? argv[i + 1] : "";
+		valid = !value.empty();
+		if (arg == "--mode")
+		{
+			mode = value;
+			valid = valid && (mode == "kernel" || mode == "e2e");
+		}
+		else if (arg == "--sizes")			bench.imgSizes = parseSizeList(value);
+		else if (arg == "--keypoints")		bench.keyPtNums = parseIntList(value);
+		else if (arg == "--ann-sizes")		bench.annSizes = parseIntList(value);
+		else if (arg == "--repeat")			bench.repeat = atoi(value.c_str());
+		else if (arg == "--filter")			bench.filter = value;
+		else if (arg == "--view-sizes")		e2e.viewSizes = parseSizeList(value);
+		else if (arg == "--views")			e2e.viewNums = parseIntList(value);
+		else if (arg == "--overlaps")		e2e.overlaps = parseDoubleList(value);
+		else if (arg == "--noise")			e2e.noiseSigma = atof(value.c_str());
+		else if (arg == "--exposure")		e2e.exposure = atof(value.c_str());
+		else if (arg == "--kp-budget")		e2e.keyPtBudget = atoi(value.c_str());
+		else if (arg == "--guided")			e2e.guidedRadius = (float)atof(value.c_str());
+		else if (arg == "--detector")
+		{
+			if (value == "sift")			e2e.detectMode = SIFTDETECT;
+			else if (value == "orb")		e2e.detectMode = ORBDETECT;
+			else if (value == "brisk")		e2e.detectMode = BRISKDETECT;
+			else							valid = false;
+		}
+		else if (arg == "--blend")
+		{
+			if (value == "alpha")			e2e.seamMode = SEAMMODE_ALPHA;
+			else if (value == "dp")			e2e.seamMode = SEAMMODE_DP;
+			else if (value == "graphcut")	e2e.seamMode = SEAMMODE_GRAPHCUT;
+			else							valid = false;
+		}
+		else if (arg == "--motion")
+		{
+			if (value == "auto")				e2e.motionMode = MOTIONMODE_AUTO;
+			else if (value == "translation")	e2e.motionMode = MOTIONMODE_TRANSLATION;
+			else if (value == "similarity")		e2e.motionMode = MOTIONMODE_SIMILARITY;
+			else if (value == "affine")			e2e.motionMode = MOTIONMODE_AFFINE;
+			else if (value == "homography")		e2e.motionMode = MOTIONMODE_HOMOGRAPHY;
+			else							valid = false;
+		}
+		else if (arg == "--threads")		setNumThreads(atoi(value.c_str()));
+		else if (arg == "--pool")
+		{
+			if (atoi(value.c_str()) != 0)	matPool::install();
+		}
+		else if (arg == "--json")			jsonFile = value;
+		else if (arg == "--csv")			csvFile = value;
+		else								valid = false;
+	}
+	if (!valid)
+	{
+		cout << "÷: MosaicBench [--mode kernel|e2e] [--threads N] [--pool 0|1] [--json file] [--csv file]" << endl
+			<< "  kernel: [--sizes 640x480,1280x720] [--keypoints 500,2000] [--repeat N] [--filter name]" << endl
+			<< "          [--ann-sizes 10000,100000,1000000]" << endl
+			<< "  e2e:    [--view-sizes 1280x720,12000x8000] [--views 2,50,500] [--overlaps 0.2,0.5]" << endl
+			<< "          [--detector sift|orb|brisk] [--blend alpha|dp|graphcut] [--noise sigma] [--exposure e]" << endl
+			<< "          [--motion auto|translation|similarity|affine|homography] [--kp-budget N] [--guided radius]" << endl;
+		return 1;
+	}
+
+	bool success = true;
+	if (mode == "e2e")
+	{
+		e2e.runAll();
+		success = e2e.writeJson(jsonFile.empty() ? "bench_e2e.json" : jsonFile);
+		if (!csvFile.empty())	success = e2e.writeCsv(csvFile) && success;
+		return success ? 0 : 1;
+	}
+	bench.runAll();
+	success = bench.writeJson(jsonFile.empty() ? "bench_result.json" : jsonFile);
+	if (!csvFile.empty())	success = bench.writeCsv(csvFile) && success;
+	return success ? 0 : 1;
+}
+/*-----------------------------------------------------------------------------------*/
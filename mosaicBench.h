@@ -0,0 +1,189 @@
+/*******************************************************************************
+ *
+ * \file    mosaicBench.h
+ * \brief   ƴȵ㺯΢׼ԣϳȷ룬ͼߴɨ
+ * \author  agent
+ * \version 1.0
+ * \date    2026-10-19
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * -----------------------------------------------------------------------------
+ * ļ޸ʷ
+ * <ʱ>       | <汾>  | <>         |
+ * 2026-10-19  | v1.0    | agent          |
+ * -----------------------------------------------------------------------------
+ ******************************************************************************/
+#include <opencv2/imgproc/imgproc.hpp>
+#include <opencv2/calib3d/calib3d.hpp>
+#include "publicElement.h"
+#include "featureDesc.h"
+#include "featureMatch.h"
+#include "homoEstimation.h"
+#include "imgProcess.h"
+#include "ransac_personal.h"
+#include "mosaicPipeline.h"
+#include "projWarper.h"
+#include "bundleAdjust.h"
+#include "vocabTree.h"
+#include "hnswIndex.h"
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <functional>
+#include <chrono>
+using namespace cv;
+using namespace std;
+
+/*===================================================================================*/
+/******************************** 궨 *********************************************/
+/*===================================================================================*/
+#define BENCH_REPEAT				5							// ÿĬϼʱ(һԤ)
+#define BENCH_SEED			 20210617							// ϳ
+#define BENCH_OUTLIER			  0.3							// ϳƥ
+#define BENCH_NOISE				  0.5							// ϳƥڵ .pix
+#define BENCH_OVERLAP			  0.3							// ϳͼԵص
+#define BENCH_BAVIEWS			  300							// ȫƽĺϳͼ
+#define BENCH_BAPAIRPTS			  100							// ȫƽÿƴӶԵڵ
+#define BENCH_VOCABIMGS			  500							// ʻĺϳͼ
+#define BENCH_VOCABDESCS		  500							// ʻÿͼ
+#define BENCH_PARTNERS				6							// һԶƥĻͼ
+#define BENCH_ANNQUERIES		 1000							// ڼĲѯ
+#define BENCH_ANNCENTERS		  256							// ڼϳӵľ
+#define BENCH_ANNREPEAT				1							// ڼÿļʱ,ģʱϳ
+/*-----------------------------------------------------------------------------------*/
+
+#pragma once
+#ifndef MOSAICBENCH_H
+#define MOSAICBENCH_H
+
+class mosaicBench
+{
+public:
+	typedef struct
+	{
+		string kernel;								// ⺯
+		Size imgSize;								// ͼߴ,ͼ޹صΪ0
+		int keyPtNum;								// (ƥ),޹صΪ0
+		int repeat;									// ʱ
+		double minMs, medianMs, meanMs;				// ʱͳ .ms
+		double recall;								// ڼrecall@2,Ϊ-1
+	}bench_result;
+
+	vector<Size> imgSizes;							// ɨͼߴ
+	vector<int> keyPtNums;							// ɨ
+	vector<int> annSizes;							// ڼɨ
+	int repeat;										// ÿʱ
+	string filter;									// ֻưַ,Ϊȫ
+	vector<bench_result> results;					// Խ
+
+public:
+	/*
+	 * @breif:캯,Ĭɨ640x480/1280x720/1920x1080500/2000/80001/10/100
+	 */
+	mosaicBench();
+
+	/*
+	 * @breif:ȫɨ
+	 * @prama[in]:None
+	 * @retval:None
+	 */
+	void runAll();
+
+	/*
+	 * @breif:JSONCSVʽ
+	 * @prama[in]:fileName->ļ·
+	 * @retval:true->ɹ; false->ļ޷д
+	 */
+	bool writeJson(string fileName);
+	bool writeCsv(string fileName);
+
+private:
+	/*
+	 * @breif:ͼߴص:Ӧӳ䡢ƴӷŻ
+	 * @prama[in]:imgSize->ϳͼߴ
+	 * @retval:None
+	 */
+	void runImgKernels(Size imgSize);
+
+	/*
+	 * @breif:ص:ƥ(һԶƥ)ڵ㡢Ӧ⡢RANSAC
+	 * @prama[in]:keyPtNum->ϳ
+	 * @retval:None
+	 */
+	void runPointKernels(int keyPtNum);
+
+	/*
+	 * @breif:ȫֹƽ:BENCH_BAVIEWSͼ,ڼһƴӶ,ֵΪ۳˴ƯƵĵӦ
+	 * @prama[in]:None
+	 * @retval:None
+	 */
+	void runBundleKernels();
+
+	/*
+	 * @breif:ʻ:BENCH_VOCABIMGSϳͼ,ͼһ,ʱѵѡƴӶɸѡ
+	 * @prama[in]:None
+	 * @retval:None
+	 */
+	void runVocabKernels();
+
+	/*
+	 * @breif:ڼ:BENCH_ANNQUERIESѯdescNum128άν,
+	 *        Աȱƥ䡢FLANNKD(ÿؽ,featureMatch_Lowsһ)HNSWĺʱrecall@2
+	 * @prama[in]:descNum->
+	 * @retval:None
+	 */
+	void runAnnKernels(int descNum);
+
+	/*
+	 * @breif:Ԥһκʱrepeat,¼Сλƽʱ
+	 * @prama[in]:kernel->;imgSize,keyPtNum->ɨ;func->⺯;repeat->ʱ,0ΪȡmosaicBench::repeat
+	 * @retval:None
+	 */
+	void timeKernel(string kernel, Size imgSize, int keyPtNum, function<void()> func, int repeat = 0);
+
+	/*
+	 * @breif:ΪһμʱĽڼ¼recall@2,ھ벻ʵνھ뼴Ϊ
+	 * @prama[in]:kernel->;matches->Ľ;secondDist->ѯʵνڵL2ƽ
+	 * @retval:None
+	 */
+	void recordRecall(string kernel, const vector<vector<DMatch>>& matches, const vector<float>& secondDist);
+
+	/*
+	 * @breif:ȷԵĺϳͼ,ƽͼϵɫ,֤㹻ǵ
+	 * @prama[in]:imgSize->ͼߴ;seed->
+	 * @retval:ϳͼ(CV_8UC3)
+	 */
+	Mat makeSyntheticImg(Size imgSize, uint64 seed);
+
+	/*
+	 * @breif:ɺϳͼ֮ĵӦ(ͼƽƵͼҲಢ΢ת͸)
+	 * @prama[in]:imgSize->ͼߴ
+	 * @retval:ͼͼĵӦ(CV_64F)
+	 */
+	Mat makeSyntheticHomo(Size imgSize);
+
+	/*
+	 * @breif:ɺϳƥ,ڵ㾭Hӳ䲢,
+	 * @prama[in]:num->;imgSize->ȡֵΧ;H->Ӧ;ptSrc,ptDst->ƥ
+	 * @retval:None
+	 */
+	void makeSyntheticPts(int num, Size imgSize, const Mat& H, vector<Point2f>& ptSrc, vector<Point2f>& ptDst);
+
+	/*
+	 * @breif:ɺϳӶ,ڶΪһ˳򲢼ŶĽ
+	 * @prama[in]:num->;matchMode->MATCHMODE_NORML2(128ά)MATCHMODE_HAMMING(256λ)
+	 * @prama[in]:desc_1,desc_2->
+	 * @retval:None
+	 */
+	void makeSyntheticDesc(int num, int matchMode, Mat& desc_1, Mat& desc_2);
+
+	/*
+	 * @breif:ɾֲ128ά,ѯΪȡӼŶ
+	 * @prama[in]:num->;queryNum->ѯ;baseDesc,queryDesc->
+	 * @retval:None
+	 */
+	void makeClusteredDesc(int num, int queryNum, Mat& baseDesc, Mat& queryDesc);
+};
+
+#endif // !MOSAICBENCH_H
@@ -0,0 +1,263 @@
+/*******************************************************************************
+ *
+ * \file    mosaicE2E.cpp
+ * \brief   ˵ƴӻ׼ԣںϳȫϰͼߴ硢ͼصɨƴ
+ * \author  agent
+ * \version 1.0
+ * \date    2026-10-19
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * -----------------------------------------------------------------------------
+ * ļ޸ʷ
+ * <ʱ>       | <汾>  | <>         |
+ * 2026-10-19  | v1.0    | agent          |
+ * -----------------------------------------------------------------------------
+ ******************************************************************************/
+#include "mosaicE2E.h"
+#include "main.h"
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#include <psapi.h>
+#pragma comment(lib, "psapi.lib")
+#else
+#include <unistd.h>
+#include <cstdio>
+#endif
+
+/*===================================================================================*/
+/******************************* к *********************************************/
+/*===================================================================================*/
+
+/*
+ * @breif:캯,ĬORBɨ1280x720/2592x19442/8ͼ0.3/0.5ص
+ */
+mosaicE2E::mosaicE2E()
+{
+	mosaicE2E::viewSizes = { Size(1280, 720), Size(2592, 1944) };
+	mosaicE2E::viewNums = { 2, 8 };
+	mosaicE2E::overlaps = { 0.3, 0.5 };
+	mosaicE2E::detectMode = ORBDETECT;
+	mosaicE2E::matchType = MATCHMODE_MINMAX;
+	mosaicE2E::seamMode = SEAMMODE_DP;
+	mosaicE2E::motionMode = MOTIONMODE_AUTO;
+	mosaicE2E::keyPtBudget = 0;
+	mosaicE2E::guidedRadius = 0;
+	mosaicE2E::noiseSigma = SYNTH_NOISE;
+	mosaicE2E::exposure = SYNTH_EXPOSURE;
+}
+
+/*
+ * @breif:ȫɨ
+ * @prama[in]:None
+ * @retval:None
+ */
+void mosaicE2E::runAll()
+{
+	mosaicE2E::results.clear();
+	for (const Size& viewSize : mosaicE2E::viewSizes)
+		for (int viewNum : mosaicE2E::viewNums)
+			for (double overlap : mosaicE2E::overlaps)
+				mosaicE2E::runCase(viewSize, viewNum, overlap);
+}
+
+/*
+ * @breif:JSONCSVʽ
+ * @prama[in]:fileName->ļ·
+ * @retval:true->ɹ; false->ļ޷д
+ */
+bool mosaicE2E::writeJson(string fileName)
+{
+	ofstream file(fileName);
+	if (!file.is_open())	return false;
+
+	file << "{\n  \"opencv\": \"" << CV_VERSION << "\",\n  \"threads\": " << getNumThreads()
+		<< ",\n  \"seed\": " << SYNTH_SEED << ",\n  \"detector\": " << mosaicE2E::detectMode
+		<< ",\n  \"seam\": " << mosaicE2E::seamMode << ",\n  \"motion\": " << mosaicE2E::motionMode
+		<< ",\n  \"kp_budget\": " << mosaicE2E::keyPtBudget << ",\n  \"guided_radius\": " << mosaicE2E::guidedRadius
+		<< ",\n  \"results\": [\n";
+	for (size_t i = 0; i < mosaicE2E::results.size(); i++)
+	{
+		const e2e_result& r = mosaicE2E::results[i];
+		file << getFormatStr("    {\"width\": %d, \"height\": %d, \"views\": %d, \"overlap\": %.3f, \"mosaic_width\": %d, "
+			"\"mosaic_height\": %d, \"wall_ms\": %.3f, \"render_ms\": %.3f, \"register_ms\": %.3f, \"homo_ms\": %.3f, "
+			"\"warp_ms\": %.3f, \"blend_ms\": %.3f, \"base_mb\": %.1f, \"peak_mb\": %.1f, \"mean_error_px\": %.4f, "
+			"\"max_error_px\": %.4f, \"fail_pairs\": %d}", r.viewSize.width, r.viewSize.height, r.viewNum, r.overlap,
+			r.mosaicSize.width, r.mosaicSize.height, r.wallMs, r.renderMs, r.registerMs, r.homoMs, r.warpMs, r.blendMs,
+			r.baseMB, r.peakMB, r.meanError, r.maxError, r.failPairs)
+			<< (i + 1 < mosaicE2E::results.size() ? ",\n" : "\n");
+	}
+	file << "  ]\n}\n";
+	return file.good();
+}
+
+bool mosaicE2E::writeCsv(string fileName)
+{
+	ofstream file(fileName);
+	if (!file.is_open())	return false;
+
+	file << "width,height,views,overlap,mosaic_width,mosaic_height,wall_ms,render_ms,register_ms,homo_ms,warp_ms,blend_ms,"
+		"base_mb,peak_mb,mean_error_px,max_error_px,fail_pairs\n";
+	for (const e2e_result& r : mosaicE2E::results)
+	{
+		file << getFormatStr("%d,%d,%d,%.3f,%d,%d,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f,%.1f,%.1f,%.4f,%.4f,%d\n",
+			r.viewSize.width, r.viewSize.height, r.viewNum, r.overlap, r.mosaicSize.width, r.mosaicSize.height, r.wallMs,
+			r.renderMs, r.registerMs, r.homoMs, r.warpMs, r.blendMs, r.baseMB, r.peakMB, r.meanError, r.maxError, r.failPairs);
+	}
+	return file.good();
+}
+/*-----------------------------------------------------------------------------------*/
+
+
+/*===================================================================================*/
+/******************************* ˽к *********************************************/
+/*===================================================================================*/
+
+/*
+ * @breif:һ,ģʽͬҲͼʼƴ,ֽ׶μʱ
+ * @prama[in]:viewSize->ͼߴ;viewNum->ͼ;overlap->ص
+ * @retval:None
+ */
+void mosaicE2E::runCase(Size viewSize, int viewNum, double overlap)
+{
+	e2e_result r = {};
+	r.viewSize = viewSize;
+	r.viewNum = viewNum;
+	r.overlap = overlap;
+	synthPano pano(viewSize, viewNum, overlap, mosaicE2E::noiseSigma, mosaicE2E::exposure);
+	imgProcess handle;
+	handle.seamMode = mosaicE2E::seamMode;
+
+	// ̶̨߳ڲפڴ,õڼķֵ
+	atomic<bool> sampling(true);
+	atomic<size_t> peakBytes(mosaicE2E::getResidentBytes());
+	r.baseMB = peakBytes / 1048576.0;
+	thread sampler([&]()
+	{
+		while (sampling)
+		{
+			size_t bytes = mosaicE2E::getResidentBytes();
+			if (bytes > peakBytes)	peakBytes = bytes;
+			this_thread::sleep_for(chrono::milliseconds(E2E_SAMPLEMS));
+		}
+	});
+
+	vector<double> errors;
+	auto wallBegin = chrono::steady_clock::now(), stageBegin = wallBegin;
+	Mat mosaicImg = pano.renderView(viewNum - 1);
+	validMask mosaicMask;									// ƴӲֵЧ
+	mosaicMask.setRect(mosaicImg.size(), Rect(0, 0, mosaicImg.cols, mosaicImg.rows));
+	r.renderMs += mosaicStats::elapsedMs(stageBegin);
+	for (int i = viewNum - 2; i >= 0; i--)
+	{
+		Mat leftImg = pano.renderView(i);
+		r.renderMs += mosaicStats::elapsedMs(stageBegin);
+
+		vector<KeyPoint> keyPtRight, keyPtLeft;
+		vector<DMatch> goodMatchPt;
+		vector<Point2f> goodPtLeft, goodPtRight;
+		featureRegister(leftImg, mosaicImg, mosaicE2E::detectMode, mosaicE2E::matchType, keyPtLeft, keyPtRight, goodMatchPt,
+			goodPtLeft, goodPtRight, nullptr, mosaicE2E::keyPtBudget, mosaicE2E::guidedRadius);
+		r.registerMs += mosaicStats::elapsedMs(stageBegin);
+
+		// ƥ㲻Ӧ˻ʱΪʧ,ӵǰͼ¿ʼƴ
+		bool success = goodPtLeft.size() >= 4;
+		homoEst homographyMap(goodPtRight, goodPtLeft, mosaicImg.size());
+		homographyMap.motionMode = mosaicE2E::motionMode;
+		if (success)
+		{
+			homographyMap.findHomography_Base();
+			success = !homographyMap.H.empty();
+		}
+		if (success)
+		{
+			homographyMap.calTransBound();
+			success = homographyMap.rightBound > 0 && homographyMap.rightBound <= 2 * (leftImg.cols + mosaicImg.cols);
+		}
+		r.homoMs += mosaicStats::elapsedMs(stageBegin);
+		if (!success)
+		{
+			r.failPairs++;
+			mosaicImg = leftImg;
+			mosaicMask.setRect(mosaicImg.size(), Rect(0, 0, mosaicImg.cols, mosaicImg.rows));
+			continue;
+		}
+		errors.push_back(mosaicE2E::calRegError(homographyMap.H, pano.getTrueHomo(i, i + 1), viewSize));
+
+		Size mapSize = Size(homographyMap.rightBound, mosaicImg.rows);
+		Mat imgMapByHomo;
+		validMask mapMask;
+		homographyMap.imgMapByHomo(mosaicImg, homographyMap.H, mapSize, imgMapByHomo, mapMask, &mosaicMask);
+		r.warpMs += mosaicStats::elapsedMs(stageBegin);
+
+		Mat dstImg;
+		imageBlend(handle, leftImg, imgMapByHomo, mapMask, dstImg, homographyMap.leftBound, mosaicImg.cols, DEBUGMODE_NORMAL,
+			&mosaicMask);
+		mosaicImg = dstImg;
+		r.blendMs += mosaicStats::elapsedMs(stageBegin);
+	}
+	r.wallMs = chrono::duration<double, milli>(chrono::steady_clock::now() - wallBegin).count() - r.renderMs;
+	sampling = false;
+	sampler.join();
+
+	r.mosaicSize = mosaicImg.size();
+	r.peakMB = peakBytes / 1048576.0;
+	for (double e : errors)
+	{
+		r.meanError += e / errors.size();
+		r.maxError = max(r.maxError, e);
+	}
+	mosaicE2E::results.push_back(r);
+	cerr << getFormatStr("%5dx%-5d views=%-4d overlap=%.2f wall %10.1fms (reg %.1f homo %.1f warp %.1f blend %.1f) "
+		"peak %8.1fMB err %.3f/%.3fpx fail %d", viewSize.width, viewSize.height, viewNum, overlap, r.wallMs, r.registerMs,
+		r.homoMs, r.warpMs, r.blendMs, r.peakMB, r.meanError, r.maxError, r.failPairs) << endl;
+}
+
+/*
+ * @breif:ƵӦֵӦƽͶӰ,ֻͼͼͳ
+ * @prama[in]:H->ƵͼͼӦ;trueH->ֵӦ;viewSize->ͼߴ
+ * @retval:ƽͶӰ .pix
+ */
+double mosaicE2E::calRegError(const Mat& H, const Mat& trueH, Size viewSize)
+{
+	vector<Point2f> gridPt, estPt, truePt;
+	for (int i = 0; i < E2E_GRID; i++)
+		for (int j = 0; j < E2E_GRID; j++)
+			gridPt.push_back(Point2f(viewSize.width * (j + 0.5f) / E2E_GRID, viewSize.height * (i + 0.5f) / E2E_GRID));
+	perspectiveTransform(gridPt, estPt, H);
+	perspectiveTransform(gridPt, truePt, trueH);
+
+	double sum = 0;
+	int num = 0;
+	Rect2f leftRect(0, 0, (float)viewSize.width, (float)viewSize.height);
+	for (size_t k = 0; k < gridPt.size(); k++)
+	{
+		if (!leftRect.contains(truePt[k]))	continue;
+		sum += norm(estPt[k] - truePt[k]);
+		num++;
+	}
+	return num > 0 ? sum / num : 0;
+}
+
+/*
+ * @breif:ǰ̵ĳפڴ
+ * @prama[in]:None
+ * @retval:פڴ .byte
+ */
+size_t mosaicE2E::getResidentBytes()
+{
+#ifdef _WIN32
+	PROCESS_MEMORY_COUNTERS counters;
+	if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))	return 0;
+	return counters.WorkingSetSize;
+#else
+	long pages = 0, resident = 0;
+	FILE* file = fopen("/proc/self/statm", "r");
+	if (file == NULL)	return 0;
+	if (fscanf(file, "%ld %ld", &pages, &resident) != 2)	resident = 0;
+	fclose(file);
+	return (size_t)resident * (size_t)sysconf(_SC_PAGESIZE);
+#endif
+}
+/*-----------------------------------------------------------------------------------*/
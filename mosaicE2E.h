@@ -0,0 +1,111 @@
+/*******************************************************************************
+ *
+ * \file    mosaicE2E.h
+ * \brief   ˵ƴӻ׼ԣںϳȫϰͼߴ硢ͼصɨƴ
+ * \author  agent
+ * \version 1.0
+ * \date    2026-10-19
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * -----------------------------------------------------------------------------
+ * ļ޸ʷ
+ * <ʱ>       | <汾>  | <>         |
+ * 2026-10-19  | v1.0    | agent          |
+ * -----------------------------------------------------------------------------
+ ******************************************************************************/
+#include <opencv2/imgproc/imgproc.hpp>
+#include "publicElement.h"
+#include "synthPano.h"
+#include <iostream>
+#include <fstream>
+#include <string>
+using namespace cv;
+using namespace std;
+
+/*===================================================================================*/
+/******************************** 궨 *********************************************/
+/*===================================================================================*/
+#define E2E_GRID					8							// ׼Ĳ߳()
+#define E2E_SAMPLEMS			   10							// פڴ .ms
+/*-----------------------------------------------------------------------------------*/
+
+#pragma once
+#ifndef MOSAICE2E_H
+#define MOSAICE2E_H
+
+class mosaicE2E
+{
+public:
+	typedef struct
+	{
+		Size viewSize;								// ͼߴ
+		int viewNum;								// ͼ
+		double overlap;								// ͼˮƽص
+		Size mosaicSize;							// ƴӽߴ
+		double wallMs;								// ˵˺ʱ(ϳͼȾ) .ms
+		double renderMs;							// ϳͼȾʱ .ms
+		double registerMs, homoMs, warpMs, blendMs;	// ׶ۼƺʱ:׼ӦơӦӳ䡢عⲹں .ms
+		double baseMB, peakMB;						// ǰеĽ̳פڴֵ .MB
+		double meanError, maxError;					// ƴӶֵӦƽͶӰľֵֵ .pix
+		int failPairs;								// ׼ʧܵƴӶ
+	}e2e_result;
+
+	vector<Size> viewSizes;							// ɨͼߴ
+	vector<int> viewNums;							// ɨͼ
+	vector<double> overlaps;						// ɨص
+	int detectMode;									// ģʽ
+	int matchType;									// ƥ
+	int seamMode;									// ƴӷŻģʽ
+	int motionMode;									// ˶ģ,MOTIONMODE_*
+	int keyPtBudget;								// ÿͼ,0Ϊ
+	float guidedRadius;								// ƥļ뾶 .pix,0Ϊƥ
+	double noiseSigma;								// ϳͼ׼
+	double exposure;								// ϳͼعŶΧ
+	vector<e2e_result> results;						// Խ
+
+public:
+	/*
+	 * @breif:캯,ĬORBɨ1280x720/2592x19442/8ͼ0.3/0.5ص
+	 */
+	mosaicE2E();
+
+	/*
+	 * @breif:ȫɨ
+	 * @prama[in]:None
+	 * @retval:None
+	 */
+	void runAll();
+
+	/*
+	 * @breif:JSONCSVʽ
+	 * @prama[in]:fileName->ļ·
+	 * @retval:true->ɹ; false->ļ޷д
+	 */
+	bool writeJson(string fileName);
+	bool writeCsv(string fileName);
+
+private:
+	/*
+	 * @breif:һ,ģʽͬҲͼʼƴ,ֽ׶μʱ
+	 * @prama[in]:viewSize->ͼߴ;viewNum->ͼ;overlap->ص
+	 * @retval:None
+	 */
+	void runCase(Size viewSize, int viewNum, double overlap);
+
+	/*
+	 * @breif:ƵӦֵӦƽͶӰ,ֻͼͼͳ
+	 * @prama[in]:H->ƵͼͼӦ;trueH->ֵӦ;viewSize->ͼߴ
+	 * @retval:ƽͶӰ .pix
+	 */
+	double calRegError(const Mat& H, const Mat& trueH, Size viewSize);
+
+	/*
+	 * @breif:ǰ̵ĳפڴ
+	 * @prama[in]:None
+	 * @retval:פڴ .byte
+	 */
+	size_t getResidentBytes();
+};
+
+#endif // !MOSAICE2E_H
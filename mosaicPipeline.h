@@ -0,0 +1,638 @@
+/*******************************************************************************
+ *
+ * \file    mosaicPipeline.h
+ * \brief   Ի׼ˮߣӾ롢ƥڱ
+ * \author  agent
+ * \version 1.0
+ * \date    2026-10-19
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * -----------------------------------------------------------------------------
+ * ļ޸ʷ
+ * <ʱ>       | <汾>  | <>         |
+ * 2026-10-19  | v1.0    | agent          |
+ * -----------------------------------------------------------------------------
+ ******************************************************************************/
+#include <opencv2/core/hal/hal.hpp>
+#include "publicElement.h"
+#include "featureDesc.h"
+#include "featureMatch.h"
+#include "homoEstimation.h"
+#include "mosaicStats.h"
+#include "keyPtGrid.h"
+#include <ratio>
+#include <cfloat>
+#include <chrono>
+#include <memory>
+#include <cstring>
+using namespace cv;
+using namespace std;
+
+/*===================================================================================*/
+/******************************** 궨 *********************************************/
+/*===================================================================================*/
+#define PIPELINE_MINMAXFLOOR	   30.0							// minMaxƥСֵ
+#define GUIDED_MINMATCH				8							// ƥĳƥ,ʱƴֵӦ
+#define GUIDED_MININLIER			6							// ֵӦڵ,ʱƥ
+#define GUIDED_RATIO			  0.8							// ƥѡڴνڵľ
+#define BATCH_QUERYBLOCK		   64							// һԶƥĲѯ,SIFTʱԼ32KB,פL1/L2
+#define BATCH_TRAINBLOCK		  256							// һԶƥѵ
+#define HNSW_CACHESIZE			    8							// ÿ̻߳HNSW,ʱ̭δõ
+/*-----------------------------------------------------------------------------------*/
+
+#pragma once
+#ifndef MOSAICPIPELINE_H
+#define MOSAICPIPELINE_H
+
+/*===================================================================================*/
+/********************************  *****************************************/
+/*===================================================================================*/
+// descDepthΪԪ,ڱУ
+struct siftDetector
+{
+	static constexpr int descDepth = CV_32F;
+	static void detect(featureDesc& handle, Mat& srcGray, vector<KeyPoint>& keyPoint, Mat& Desc)
+	{
+		handle.getFeatureDesc_SIFT(srcGray, keyPoint, Desc);
+	}
+};
+
+struct surfDetector
+{
+	static constexpr int descDepth = CV_32F;
+	static void detect(featureDesc& handle, Mat& srcGray, vector<KeyPoint>& keyPoint, Mat& Desc)
+	{
+		handle.getFeatureDesc_SURF(srcGray, keyPoint, Desc);
+	}
+};
+
+struct orbDetector
+{
+	static constexpr int descDepth = CV_8U;
+	static void detect(featureDesc& handle, Mat& srcGray, vector<KeyPoint>& keyPoint, Mat& Desc)
+	{
+		handle.getFeatureDesc_ORB(srcGray, keyPoint, Desc);
+	}
+};
+
+struct briskDetector
+{
+	static constexpr int descDepth = CV_8U;
+	static void detect(featureDesc& handle, Mat& srcGray, vector<KeyPoint>& keyPoint, Mat& Desc)
+	{
+		handle.getFeatureDesc_BRISK(srcGray, keyPoint, Desc);
+	}
+};
+/*-----------------------------------------------------------------------------------*/
+
+
+/*===================================================================================*/
+/********************************  *******************************************/
+/*===================================================================================*/
+// calcؿɱȽϵľ(L2Ϊƽ,ʡȥ),toDistΪDMatchеʵʾ,fromDistΪ
+struct hammingDistance
+{
+	typedef uchar value_type;
+	static constexpr int descDepth = CV_8U;
+	static inline float calc(const uchar* a, const uchar* b, int len)	{ return (float)hal::normHamming(a, b, len); }
+	static inline float toDist(float d)									{ return d; }
+	static inline float fromDist(float d)								{ return d; }
+};
+
+struct l2Distance
+{
+	typedef float value_type;
+	static constexpr int descDepth = CV_32F;
+	static inline float calc(const float* a, const float* b, int len)	{ return hal::normL2Sqr_(a, b, len); }
+	static inline float toDist(float d)									{ return sqrt(d); }
+	static inline float fromDist(float d)								{ return d * d; }
+};
+/*-----------------------------------------------------------------------------------*/
+
+
+/*===================================================================================*/
+/******************************** ƥ *****************************************/
+/*===================================================================================*/
+/*
+ * @breif:ÿѯӵν,ѯв
+ * @prama[in]:queryDesc,trainDesc->ѯѵ
+ * @prama[in]:bestMatch->(Ϊcalc);secondDist->Ĵνھ(calc)
+ * @retval:None
+ */
+template<class Distance>
+void bruteForceKnn2(const Mat& queryDesc, const Mat& trainDesc, vector<DMatch>& bestMatch, vector<float>& secondDist)
+{
+	typedef typename Distance::value_type T;
+	int len = queryDesc.cols;
+	bestMatch.assign(queryDesc.rows, DMatch());
+	secondDist.assign(queryDesc.rows, FLT_MAX);
+	parallel_for_(Range(0, queryDesc.rows), [&](const Range& range)
+	{
+		for (int i = range.start; i < range.end; i++)
+		{
+			const T* q = queryDesc.ptr<T>(i);
+			float best = FLT_MAX, second = FLT_MAX;
+			int bestIdx = -1;
+			for (int j = 0; j < trainDesc.rows; j++)
+			{
+				float d = Distance::calc(q, trainDesc.ptr<T>(j), len);
+				if (d < best)			{ second = best; best = d; bestIdx = j; }
+				else if (d < second)	second = d;
+			}
+			bestMatch[i] = DMatch(i, bestIdx, best);
+			secondDist[i] = second;
+		}
+	});
+}
+
+/*
+ * @breif:һԶ౩:ѯӰBATCH_QUERYBLOCKзֿ鲢,ÿѵӰBATCH_TRAINBLOCKзֿȽ,
+ *        ѯڻפֱȫȽ,ֻʽһ
+ * @prama[in]:queryDesc->ѯ; trainDescs->ѵ,յĻάһµĻΪ
+ * @prama[in]:bestMatch,secondDist->ĸνھ(calc),bruteForceKnn2ͬ
+ * @retval:None
+ */
+template<class Distance>
+void bruteForceKnn2Batch(const Mat& queryDesc, const vector<Mat>& trainDescs, vector<vector<DMatch>>& bestMatch,
+	vector<vector<float>>& secondDist)
+{
+	typedef typename Distance::value_type T;
+	int len = queryDesc.cols, partnerNum = (int)trainDescs.size();
+	vector<bool> valid(partnerNum);
+	bestMatch.assign(partnerNum, vector<DMatch>());
+	secondDist.assign(partnerNum, vector<float>());
+	for (int k = 0; k < partnerNum; k++)
+	{
+		valid[k] = !trainDescs[k].empty() && trainDescs[k].cols == len && trainDescs[k].type() == queryDesc.type();
+		if (!valid[k])	continue;
+		bestMatch[k].assign(queryDesc.rows, DMatch());
+		secondDist[k].assign(queryDesc.rows, FLT_MAX);
+	}
+
+	int blockNum = (queryDesc.rows + BATCH_QUERYBLOCK - 1) / BATCH_QUERYBLOCK;
+	parallel_for_(Range(0, blockNum), [&](const Range& range)
+	{
+		float best[BATCH_QUERYBLOCK], second[BATCH_QUERYBLOCK];
+		int bestIdx[BATCH_QUERYBLOCK];
+		for (int b = range.start; b < range.end; b++)
+		{
+			int qBegin = b * BATCH_QUERYBLOCK, qEnd = min(qBegin + BATCH_QUERYBLOCK, queryDesc.rows);
+			for (int k = 0; k < partnerNum; k++)
+			{
+				if (!valid[k])	continue;
+				const Mat& trainDesc = trainDescs[k];
+				fill(best, best + BATCH_QUERYBLOCK, FLT_MAX);
+				fill(second, second + BATCH_QUERYBLOCK, FLT_MAX);
+				fill(bestIdx, bestIdx + BATCH_QUERYBLOCK, -1);
+				for (int tBegin = 0; tBegin < trainDesc.rows; tBegin += BATCH_TRAINBLOCK)
+				{
+					int tEnd = min(tBegin + BATCH_TRAINBLOCK, trainDesc.rows);
+					for (int i = qBegin; i < qEnd; i++)
+					{
+						const T* q = queryDesc.ptr<T>(i);
+						int bi = i - qBegin;
+						for (int j = tBegin; j < tEnd; j++)
+						{
+							float d = Distance::calc(q, trainDesc.ptr<T>(j), len);
+							if (d < best[bi])			{ second[bi] = best[bi]; best[bi] = d; bestIdx[bi] = j; }
+							else if (d < second[bi])	second[bi] = d;
+						}
+					}
+				}
+				for (int i = qBegin; i < qEnd; i++)
+				{
+					bestMatch[k][i] = DMatch(i, bestIdx[i - qBegin], best[i - qBegin]);
+					secondDist[k][i] = second[i - qBegin];
+				}
+			}
+		}
+	});
+}
+
+// minMax:벻max(Ratio*С, PIPELINE_MINMAXFLOOR)
+template<class Ratio>
+struct minMaxMatcher
+{
+	template<class Distance>
+	static vector<DMatch> match(const Mat& queryDesc, const Mat& trainDesc)
+	{
+		vector<DMatch> matchPoints;
+		vector<float> secondDist;
+		bruteForceKnn2<Distance>(queryDesc, trainDesc, matchPoints, secondDist);
+		return minMaxMatcher::select<Distance>(matchPoints, secondDist);
+	}
+
+	template<class Distance>
+	static vector<vector<DMatch>> matchBatch(const Mat& queryDesc, const vector<Mat>& trainDescs)
+	{
+		vector<vector<DMatch>> matchPoints, goodMatchPoints(trainDescs.size());
+		vector<vector<float>> secondDist;
+		bruteForceKnn2Batch<Distance>(queryDesc, trainDescs, matchPoints, secondDist);
+		for (size_t k = 0; k < trainDescs.size(); k++)
+			goodMatchPoints[k] = minMaxMatcher::select<Distance>(matchPoints[k], secondDist[k]);
+		return goodMatchPoints;
+	}
+
+	// νɸѡ,ھ͵ػΪʵʾ벢
+	template<class Distance>
+	static vector<DMatch> select(vector<DMatch>& matchPoints, const vector<float>& secondDist)
+	{
+		vector<DMatch> goodMatchPoints;
+		for (DMatch& m : matchPoints)	m.distance = Distance::toDist(m.distance);
+		sort(matchPoints.begin(), matchPoints.end());
+		if (matchPoints.empty())	return goodMatchPoints;
+
+		double threshold = max((double)Ratio::num / Ratio::den * matchPoints.front().distance, PIPELINE_MINMAXFLOOR);
+		for (const DMatch& m : matchPoints)
+		{
+			if (m.distance > threshold)	break;
+			goodMatchPoints.push_back(m);
+		}
+		return goodMatchPoints;
+	}
+};
+
+// Low's:ھСRatioνھʱ
+template<class Ratio>
+struct lowsMatcher
+{
+	template<class Distance>
+	static vector<DMatch> match(const Mat& queryDesc, const Mat& trainDesc)
+	{
+		vector<DMatch> matchPoints;
+		vector<float> secondDist;
+		if (trainDesc.rows < 2)	return vector<DMatch>();
+		bruteForceKnn2<Distance>(queryDesc, trainDesc, matchPoints, secondDist);
+		return lowsMatcher::select<Distance>(matchPoints, secondDist);
+	}
+
+	template<class Distance>
+	static vector<vector<DMatch>> matchBatch(const Mat& queryDesc, const vector<Mat>& trainDescs)
+	{
+		vector<vector<DMatch>> matchPoints, goodMatchPoints(trainDescs.size());
+		vector<vector<float>> secondDist;
+		bruteForceKnn2Batch<Distance>(queryDesc, trainDescs, matchPoints, secondDist);
+		for (size_t k = 0; k < trainDescs.size(); k++)
+			if (trainDescs[k].rows >= 2)	goodMatchPoints[k] = lowsMatcher::select<Distance>(matchPoints[k], secondDist[k]);
+		return goodMatchPoints;
+	}
+
+	// νڵľɸѡ
+	template<class Distance>
+	static vector<DMatch> select(const vector<DMatch>& matchPoints, const vector<float>& secondDist)
+	{
+		vector<DMatch> goodMatchPoints;
+		float ratio = (float)Ratio::num / Ratio::den;
+		for (size_t i = 0; i < matchPoints.size(); i++)
+		{
+			float best = Distance::toDist(matchPoints[i].distance);
+			if (best < ratio * Distance::toDist(secondDist[i]))
+				goodMatchPoints.push_back(DMatch(matchPoints[i].queryIdx, matchPoints[i].trainIdx, best));
+		}
+		return goodMatchPoints;
+	}
+};
+
+// HNSW:Ϊ,ͬһͼֻһ˳ƴͼ¼,
+// ȷ,ͬ;水̶߳,̻߳
+struct hnswIndexCache
+{
+	typedef struct
+	{
+		size_t key;								// ݵĹϣֵ
+		Mat desc;								// Ӹ,ϣͬʱֽں˶
+		shared_ptr<hnswIndex> index;			// desc
+	}cache_entry;
+
+	/*
+	 * @breif:ȡӶӦHNSW,δʱ뻺
+	 * @prama[in]:desc->ѵ(CV_32F)
+	 * @retval:,ʧʱΪָ
+	 */
+	static shared_ptr<hnswIndex> get(const Mat& desc)
+	{
+		thread_local vector<cache_entry> entries;	// ʹ,
+		Mat data = desc.isContinuous() ? desc : desc.clone();
+		size_t bytes = data.total() * data.elemSize();
+		size_t key = 1469598103934665603ULL;
+		for (size_t i = 0; i < bytes; i++)	key = (key ^ data.data[i]) * 1099511628211ULL;
+		for (size_t i = 0; i < entries.size(); i++)
+		{
+			const Mat& cached = entries[i].desc;
+			if (entries[i].key != key || cached.rows != data.rows || cached.cols != data.cols || cached.type() != data.type())	continue;
+			if (memcmp(cached.data, data.data, bytes) != 0)	continue;
+			cache_entry hit = entries[i];
+			entries.erase(entries.begin() + i);
+			entries.insert(entries.begin(), hit);
+			return hit.index;
+		}
+		shared_ptr<hnswIndex> index = make_shared<hnswIndex>();
+		if (!index->build(data))	return nullptr;
+		entries.insert(entries.begin(), cache_entry{ key, data.clone(), index });
+		if (entries.size() > HNSW_CACHESIZE)	entries.pop_back();
+		return index;
+	}
+};
+
+// minMax:ѵӽHNSWԲѯӼ,ɸѡͬminMaxMatcher,ڸ;
+// hnswIndexCacheͼ,һԶƥʱȡ,ƥһ
+template<class Ratio>
+struct hnswMinMaxMatcher
+{
+	template<class Distance>
+	static vector<DMatch> match(const Mat& queryDesc, const Mat& trainDesc)
+	{
+		static_assert(Distance::descDepth == CV_32F, "HNSWָ֧");
+		shared_ptr<hnswIndex> index = hnswIndexCache::get(trainDesc);
+		if (!index)	return vector<DMatch>();
+		return featureMatch().featureMatch_MinMax(*index, queryDesc, (float)Ratio::num / Ratio::den);
+	}
+
+	template<class Distance>
+	static vector<vector<DMatch>> matchBatch(const Mat& queryDesc, const vector<Mat>& trainDescs)
+	{
+		static_assert(Distance::descDepth == CV_32F, "HNSWָ֧");
+		vector<vector<DMatch>> goodMatchPoints(trainDescs.size());
+		featureMatch featureMatchHandle;
+		for (size_t k = 0; k < trainDescs.size(); k++)
+		{
+			const Mat& trainDesc = trainDescs[k];
+			if (trainDesc.empty() || trainDesc.cols != queryDesc.cols || trainDesc.type() != queryDesc.type())	continue;
+			shared_ptr<hnswIndex> index = hnswIndexCache::get(trainDesc);
+			if (!index)	continue;
+			goodMatchPoints[k] = featureMatchHandle.featureMatch_MinMax(*index, queryDesc, (float)Ratio::num / Ratio::den);
+		}
+		return goodMatchPoints;
+	}
+};
+
+/*
+ * @breif:ƥ:ͼؼ㰴Ͱ,ͼؼ㾭ֵӦͶӰͼֻ뾶ڵͼؼȽ,
+ *        СGUIDED_RATIOѡڴνҲdistLimit,ͬһͼؼֻСͼؼ
+ * @prama[in]:keyPtLeft,descLeft->ͼؼ; keyPtRight,descRight->ͼؼ
+ * @prama[in]:H->ͼͼĴֵӦ(CV_64F); radius->뾶 .pix; distLimit->(calc)
+ * @prama[in]:compareNum->ӱȽϴ
+ * @retval:ƥ,queryIdxΪͼštrainIdxΪͼ,Ϊcalc
+ */
+template<class Distance>
+vector<DMatch> guidedMatch(const vector<KeyPoint>& keyPtLeft, const Mat& descLeft, const vector<KeyPoint>& keyPtRight,
+	const Mat& descRight, const Mat& H, float radius, float distLimit, size_t& compareNum)
+{
+	typedef typename Distance::value_type T;
+	keyPtGrid grid;
+	grid.build(keyPtRight, radius);
+	vector<Point2f> ptLeft, ptProj;
+	KeyPoint::convert(keyPtLeft, ptLeft);
+	perspectiveTransform(ptLeft, ptProj, H);
+
+	int len = descLeft.cols;
+	vector<DMatch> bestMatch(keyPtLeft.size(), DMatch(-1, -1, FLT_MAX));
+	vector<size_t> compares(keyPtLeft.size(), 0);
+	parallel_for_(Range(0, (int)keyPtLeft.size()), [&](const Range& range)
+	{
+		vector<int> candidates;
+		for (int i = range.start; i < range.end; i++)
+		{
+			grid.query(ptProj[i], radius, candidates);
+			const T* q = descLeft.ptr<T>(i);
+			float best = FLT_MAX, second = FLT_MAX;
+			int bestIdx = -1;
+			for (int j : candidates)
+			{
+				float d = Distance::calc(q, descRight.ptr<T>(j), len);
+				if (d < best)			{ second = best; best = d; bestIdx = j; }
+				else if (d < second)	second = d;
+			}
+			compares[i] = candidates.size();
+			// ֵʵʾж,L2calcΪƽ
+			if (bestIdx < 0 || best > distLimit)	continue;
+			if (second < FLT_MAX && Distance::toDist(best) >= GUIDED_RATIO * Distance::toDist(second))	continue;
+			bestMatch[i] = DMatch(i, bestIdx, best);
+		}
+	});
+
+	compareNum = 0;
+	vector<int> rightOwner(keyPtRight.size(), -1);
+	for (size_t i = 0; i < bestMatch.size(); i++)
+	{
+		compareNum += compares[i];
+		int j = bestMatch[i].trainIdx;
+		if (j < 0)	continue;
+		if (rightOwner[j] < 0 || bestMatch[i].distance < bestMatch[rightOwner[j]].distance)	rightOwner[j] = (int)i;
+	}
+	vector<DMatch> goodMatchPoints;
+	for (size_t i = 0; i < bestMatch.size(); i++)
+		if (bestMatch[i].trainIdx >= 0 && rightOwner[bestMatch[i].trainIdx] == (int)i)	goodMatchPoints.push_back(bestMatch[i]);
+	return goodMatchPoints;
+}
+/*-----------------------------------------------------------------------------------*/
+
+
+/*===================================================================================*/
+/********************************  *****************************************/
+/*===================================================================================*/
+// ԶRANSACӦ󲢼ӳ߽
+struct ransacEstimator
+{
+	static void estimate(homoEst& homographyMap)
+	{
+		homographyMap.findHomography_Base();
+		homographyMap.calTransBound();
+	}
+};
+/*-----------------------------------------------------------------------------------*/
+
+
+/*===================================================================================*/
+/******************************** ׼ˮ *****************************************/
+/*===================================================================================*/
+template<class Detector, class Distance, class Matcher, class Estimator>
+class mosaicPipeline
+{
+	static_assert(Detector::descDepth == Distance::descDepth, "Բһ");
+
+public:
+	/*
+	 * @breif:ͼ,Ҫͼĳ(ͼ񼯼)ʹ
+	 * @prama[in]:srcGray->Ҷͼ; keyPoint->Ĺؼ; Desc->; keyPtBudget->,0Ϊ
+	 * @retval:None
+	 */
+	static void detect(Mat& srcGray, vector<KeyPoint>& keyPoint, Mat& Desc, int keyPtBudget = 0)
+	{
+		featureDesc featureDescHandle;
+		featureDescHandle.keyPtBudget = keyPtBudget;
+		Detector::detect(featureDescHandle, srcGray, keyPoint, Desc);
+	}
+
+	/*
+	 * @breif:Ըͼļ,ڵļø
+	 * @prama[in]:descHandle->; srcGray->Ҷͼ; keyPoint->Ĺؼ; Desc->
+	 * @retval:None
+	 */
+	static void detect(featureDesc& descHandle, Mat& srcGray, vector<KeyPoint>& keyPoint, Mat& Desc)
+	{
+		Detector::detect(descHandle, srcGray, keyPoint, Desc);
+	}
+
+	/*
+	 * @breif:ƥ,ӽٵһΪѯ
+	 * @prama[in]:Desc_1,Desc_2->ƥͼƬ
+	 * @retval:GoodMatchPoints->ɸѡƥ,queryIdxӦٵһ
+	 */
+	static vector<DMatch> descMatch(const Mat& Desc_1, const Mat& Desc_2)
+	{
+		if (Desc_1.empty() || Desc_2.empty())	return vector<DMatch>();
+		if (Desc_1.rows > Desc_2.rows)	return Matcher::template match<Distance>(Desc_2, Desc_1);
+		return Matcher::template match<Distance>(Desc_1, Desc_2);
+	}
+
+	/*
+	 * @breif:һԶƥ,һͼͼƥʱѯֻһ
+	 * @prama[in]:queryDesc->ѯ; trainDescs->ͼ
+	 * @retval:ͼƥ,queryIdxӦѯ(descMatchͬ,ѯ)
+	 */
+	static vector<vector<DMatch>> descMatchBatch(const Mat& queryDesc, const vector<Mat>& trainDescs)
+	{
+		if (queryDesc.empty())	return vector<vector<DMatch>>(trainDescs.size());
+		return Matcher::template matchBatch<Distance>(queryDesc, trainDescs);
+	}
+
+	/*
+	 * @breif:⡢ƥ(Ҷͼ)
+	 * @prama[in]:grayImgLeft,grayImgRight->ƴͼĻҶͼ
+	 * @prama[in]:keyPtLeft,keyPtRight->ҹؼ;goodMatchPt->ƥ
+	 * @prama[in]:goodPtLeft,goodPtRight->ƥ
+	 * @prama[in]:stats->ͳ,¼⡢ƥʱ㡢ƥ(Ϊͳ)
+	 * @prama[in]:keyPtBudget->ÿͼ,0Ϊ
+	 * @prama[in]:guidedRadius->ƥļ뾶 .pix,0ʱԳƥƴֵӦ,guidedMatchƥ
+	 * @retval:None
+	 */
+	static void featureRegister(Mat& grayImgLeft, Mat& grayImgRight, vector<KeyPoint>& keyPtLeft, vector<KeyPoint>& keyPtRight,
+		vector<DMatch>& goodMatchPt, vector<Point2f>& goodPtLeft, vector<Point2f>& goodPtRight, mosaicStats* stats = nullptr,
+		int keyPtBudget = 0, float guidedRadius = 0)
+	{
+		featureDesc featureDescHandle;
+		featureDescHandle.keyPtBudget = keyPtBudget;
+		Mat imgDescLeft, imgDescRight;
+		auto timeBegin = chrono::steady_clock::now();
+		Detector::detect(featureDescHandle, grayImgLeft, keyPtLeft, imgDescLeft);
+		Detector::detect(featureDescHandle, grayImgRight, keyPtRight, imgDescRight);
+		goodMatchPt = mosaicPipeline::descMatch(imgDescLeft, imgDescRight);
+
+		// descMatchͬĹжϲѯ,ʱͼΪѯ
+		bool leftQuery = imgDescLeft.rows <= imgDescRight.rows;
+		for (const DMatch& m : goodMatchPt)
+		{
+			goodPtLeft.push_back(keyPtLeft[leftQuery ? m.queryIdx : m.trainIdx].pt);
+			goodPtRight.push_back(keyPtRight[leftQuery ? m.trainIdx : m.queryIdx].pt);
+		}
+		if (guidedRadius > 0)
+			mosaicPipeline::guidedRefine(keyPtLeft, imgDescLeft, keyPtRight, imgDescRight, grayImgRight.size(), guidedRadius,
+				goodMatchPt, goodPtLeft, goodPtRight);
+		if (stats == nullptr)	return;
+		// ƥʱΪܺʱ۳ʱ
+		stats->detectMs += featureDescHandle.detectMs;
+		stats->describeMs += featureDescHandle.describeMs;
+		stats->matchMs += mosaicStats::elapsedMs(timeBegin) - featureDescHandle.detectMs - featureDescHandle.describeMs;
+		stats->keyPtLeft = (int)keyPtLeft.size();
+		stats->keyPtRight = (int)keyPtRight.size();
+		stats->matchNum = (int)goodPtLeft.size();
+	}
+
+	/*
+	 * @breif:ѹƥƵӦӳ߽
+	 * @prama[in]:homographyMap->ƥ㹹ĵӦƾ
+	 * @retval:None
+	 */
+	static void homoEstimate(homoEst& homographyMap)
+	{
+		Estimator::estimate(homographyMap);
+	}
+
+private:
+	/*
+	 * @breif:ԳƥͼͼĴֵӦ,ƥ;ֵӦڵ㲻ƥʱƥ
+	 * @prama[in]:keyPtLeft,imgDescLeft->ͼؼ; keyPtRight,imgDescRight->ͼؼ
+	 * @prama[in]:rightSize->ͼߴ; radius->뾶 .pix
+	 * @prama[in]:goodMatchPt,goodPtLeft,goodPtRight->ƥ,ƥɹʱ滻,ѯdescMatchһ
+	 * @retval:None
+	 */
+	static void guidedRefine(const vector<KeyPoint>& keyPtLeft, const Mat& imgDescLeft, const vector<KeyPoint>& keyPtRight,
+		const Mat& imgDescRight, Size rightSize, float radius, vector<DMatch>& goodMatchPt, vector<Point2f>& goodPtLeft,
+		vector<Point2f>& goodPtRight)
+	{
+		if (goodPtLeft.size() < GUIDED_MINMATCH)	return;
+		homoEst coarseMap(goodPtLeft, goodPtRight, rightSize);
+		coarseMap.findHomography_Base();
+		if (coarseMap.inlierNum < GUIDED_MININLIER)	return;
+
+		// ȡƥе,calcĶ
+		float distLimit = 0;
+		for (const DMatch& m : goodMatchPt)	distLimit = max(distLimit, m.distance);
+		distLimit = Distance::fromDist(distLimit);
+		size_t compareNum = 0;
+		vector<DMatch> guidedPt = guidedMatch<Distance>(keyPtLeft, imgDescLeft, keyPtRight, imgDescRight, coarseMap.H, radius,
+			distLimit, compareNum);
+		MOSAIC_LOG_DEBUG("guidedRefine ƥ:" << goodMatchPt.size() << " ֵӦڵ:" << coarseMap.inlierNum
+			<< " ƥ:" << guidedPt.size() << " ӱȽ:" << compareNum << "/" << keyPtLeft.size() * keyPtRight.size());
+		if (guidedPt.size() <= (size_t)coarseMap.inlierNum)	return;
+
+		bool leftQuery = imgDescLeft.rows <= imgDescRight.rows;
+		goodMatchPt.clear();
+		goodPtLeft.clear();
+		goodPtRight.clear();
+		for (const DMatch& m : guidedPt)
+		{
+			float dist = Distance::toDist(m.distance);
+			goodMatchPt.push_back(leftQuery ? DMatch(m.queryIdx, m.trainIdx, dist) : DMatch(m.trainIdx, m.queryIdx, dist));
+			goodPtLeft.push_back(keyPtLeft[m.queryIdx].pt);
+			goodPtRight.push_back(keyPtRight[m.trainIdx].pt);
+		}
+	}
+};
+
+// ԭмģʽƥͶӦˮ,ֵԭ֧һ
+typedef mosaicPipeline<siftDetector, l2Distance, minMaxMatcher<ratio<2>>, ransacEstimator> siftPipeline;
+typedef mosaicPipeline<surfDetector, l2Distance, minMaxMatcher<ratio<2>>, ransacEstimator> surfPipeline;
+typedef mosaicPipeline<siftDetector, l2Distance, hnswMinMaxMatcher<ratio<2>>, ransacEstimator> siftAnnPipeline;
+typedef mosaicPipeline<surfDetector, l2Distance, hnswMinMaxMatcher<ratio<2>>, ransacEstimator> surfAnnPipeline;
+typedef mosaicPipeline<orbDetector, hammingDistance, minMaxMatcher<ratio<12, 5>>, ransacEstimator> orbPipeline;
+typedef mosaicPipeline<orbDetector, hammingDistance, lowsMatcher<ratio<1, 2>>, ransacEstimator> orbLowsPipeline;
+typedef mosaicPipeline<briskDetector, hammingDistance, minMaxMatcher<ratio<23, 10>>, ransacEstimator> briskPipeline;
+/*-----------------------------------------------------------------------------------*/
+
+
+/*===================================================================================*/
+/******************************** ʱַ *****************************************/
+/*===================================================================================*/
+/*
+ * @breif:ʱļģʽƥѡˮ,Ըˮ͵Ŀնfunc
+ * @prama[in]:detectMode->ģʽ;matchType->ƥ(ORBminmaxlow's,SIFTSURF־ȷ)
+ * @prama[in]:func->ɵö,[&](auto pipeline){ pipeline.featureRegister(...); }
+ * @retval:true->ģʽЧ; false->δ֪ģʽ,funcδ
+ */
+template<class Func>
+bool pipelineDispatch(int detectMode, int matchType, Func&& func)
+{
+	switch (detectMode)
+	{
+	case(SIFTDETECT):
+		if (matchType == MATCHMODE_ANN)	func(siftAnnPipeline());
+		else							func(siftPipeline());
+		return true;
+	case(SURFDETECT):
+		if (matchType == MATCHMODE_ANN)	func(surfAnnPipeline());
+		else							func(surfPipeline());
+		return true;
+	case(BRISKDETECT):	func(briskPipeline());	return true;
+	case(ORBDETECT):
+		if (matchType)	func(orbPipeline());
+		else			func(orbLowsPipeline());
+		return true;
+	default:			return false;
+	}
+}
+/*-----------------------------------------------------------------------------------*/
+
+#endif // !MOSAICPIPELINE_H
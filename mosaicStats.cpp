@@ -0,0 +1,174 @@
+/*******************************************************************************
+ *
+ * \file    mosaicStats.cpp
+ * \brief   ƴͳƣֽ׶κʱƥRANSACڵʡڴJSON
+ * \author  agent
+ * \version 1.0
+ * \date    2026-10-19
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * -----------------------------------------------------------------------------
+ * ļ޸ʷ
+ * <ʱ>       | <汾>  | <>         |
+ * 2026-10-19  | v1.0    | agent          |
+ * -----------------------------------------------------------------------------
+ ******************************************************************************/
+#include "mosaicStats.h"
+
+ofstream mosaicStats::sinkFile;
+mutex mosaicStats::sinkMutex;
+
+/*===================================================================================*/
+/*******************************  *******************************************/
+/*===================================================================================*/
+static thread_local size_t allocCounter = 0;		// ߳ۼMatڴ .byte
+
+// װĬϷ,ֻͳڴ,ͷԭ
+class countingAllocator : public MatAllocator
+{
+public:
+	MatAllocator* base;
+
+	countingAllocator(MatAllocator* base) : base(base) {}
+
+	UMatData* allocate(int dims, const int* sizes, int type, void* data, size_t* step, AccessFlag flags,
+		UMatUsageFlags usageFlags) const override
+	{
+		UMatData* u = base->allocate(dims, sizes, type, data, step, flags, usageFlags);
+		if (u != NULL && data == NULL)	allocCounter += u->size;
+		return u;
+	}
+
+	bool allocate(UMatData* data, AccessFlag accessFlags, UMatUsageFlags usageFlags) const override
+	{
+		return base->allocate(data, accessFlags, usageFlags);
+	}
+
+	void deallocate(UMatData* data) const override
+	{
+		base->deallocate(data);
+	}
+};
+/*-----------------------------------------------------------------------------------*/
+
+
+/*===================================================================================*/
+/******************************* к *********************************************/
+/*===================================================================================*/
+
+/*
+ * @breif:캯,
+ */
+mosaicStats::mosaicStats()
+{
+	mosaicStats::grayMs = mosaicStats::detectMs = mosaicStats::describeMs = mosaicStats::matchMs = 0;
+	mosaicStats::ransacMs = mosaicStats::warpMs = mosaicStats::blendMs = mosaicStats::totalMs = 0;
+	mosaicStats::keyPtLeft = mosaicStats::keyPtRight = mosaicStats::matchNum = 0;
+	mosaicStats::ransacIters = mosaicStats::inlierNum = 0;
+	mosaicStats::motionModel = MOTIONMODE_HOMOGRAPHY;
+	mosaicStats::inlierRatio = 0;
+	mosaicStats::allocBytes = 0;
+	mosaicStats::allocBegin = 0;
+}
+
+/*
+ * @breif:ʼһͳ;ʱܺʱڴ,Ѵͳļʱ׷һ
+ * @prama[in]:None
+ * @retval:None
+ */
+void mosaicStats::begin()
+{
+	mosaicStats::allocBegin = mosaicStats::threadAllocBytes();
+	mosaicStats::timeBegin = chrono::steady_clock::now();
+}
+
+void mosaicStats::end()
+{
+	mosaicStats::totalMs = chrono::duration<double, milli>(chrono::steady_clock::now() - mosaicStats::timeBegin).count();
+	mosaicStats::allocBytes = mosaicStats::threadAllocBytes() - mosaicStats::allocBegin;
+	mosaicStats::inlierRatio = mosaicStats::matchNum > 0 ? (double)mosaicStats::inlierNum / mosaicStats::matchNum : 0;
+
+	lock_guard<mutex> lock(mosaicStats::sinkMutex);
+	if (mosaicStats::sinkFile.is_open())	mosaicStats::sinkFile << mosaicStats::toJson() << endl;
+}
+
+/*
+ * @breif:ͳƼ¼תΪJSON
+ * @prama[in]:None
+ * @retval:JSONַ
+ */
+string mosaicStats::toJson()
+{
+	string tag;
+	for (char c : mosaicStats::tag)
+	{
+		if (c == '"' || c == '\\')	tag += '\\';
+		tag += c;
+	}
+	return getFormatStr("{\"tag\": \"%s\", \"left_width\": %d, \"left_height\": %d, \"right_width\": %d, \"right_height\": %d, "
+		"\"gray_ms\": %.3f, \"detect_ms\": %.3f, \"describe_ms\": %.3f, \"match_ms\": %.3f, \"ransac_ms\": %.3f, "
+		"\"warp_ms\": %.3f, \"blend_ms\": %.3f, \"total_ms\": %.3f, \"keypoints_left\": %d, \"keypoints_right\": %d, "
+		"\"matches\": %d, \"ransac_iters\": %d, \"inliers\": %d, \"inlier_ratio\": %.4f, \"motion_model\": %d, \"alloc_bytes\": %zu}",
+		tag.c_str(), mosaicStats::leftSize.width, mosaicStats::leftSize.height, mosaicStats::rightSize.width,
+		mosaicStats::rightSize.height, mosaicStats::grayMs, mosaicStats::detectMs, mosaicStats::describeMs,
+		mosaicStats::matchMs, mosaicStats::ransacMs, mosaicStats::warpMs, mosaicStats::blendMs, mosaicStats::totalMs,
+		mosaicStats::keyPtLeft, mosaicStats::keyPtRight, mosaicStats::matchNum, mosaicStats::ransacIters,
+		mosaicStats::inlierNum, mosaicStats::inlierRatio, mosaicStats::motionModel, mosaicStats::allocBytes);
+}
+
+/*
+ * @breif:򿪡رսڹͳļ(JSON),򿪺ÿend()׷һ,̰߳ȫ
+ * @prama[in]:fileName->ͳļ·
+ * @retval:true->ɹ; false->ļ޷
+ */
+bool mosaicStats::openSink(string fileName)
+{
+	lock_guard<mutex> lock(mosaicStats::sinkMutex);
+	if (mosaicStats::sinkFile.is_open())	mosaicStats::sinkFile.close();
+	mosaicStats::sinkFile.open(fileName, ios::app);
+	return mosaicStats::sinkFile.is_open();
+}
+
+void mosaicStats::closeSink()
+{
+	lock_guard<mutex> lock(mosaicStats::sinkMutex);
+	if (mosaicStats::sinkFile.is_open())	mosaicStats::sinkFile.close();
+}
+
+/*
+ * @breif:timeBeginĺʱtimeBeginΪǰʱ,׶ʱ
+ * @prama[in]:timeBegin->ʱ
+ * @retval:ʱ .ms
+ */
+double mosaicStats::elapsedMs(chrono::steady_clock::time_point& timeBegin)
+{
+	auto timeEnd = chrono::steady_clock::now();
+	double ms = chrono::duration<double, milli>(timeEnd - timeBegin).count();
+	timeBegin = timeEnd;
+	return ms;
+}
+/*-----------------------------------------------------------------------------------*/
+
+
+/*===================================================================================*/
+/******************************* ˽к *********************************************/
+/*===================================================================================*/
+
+/*
+ * @breif:߳ۼMatڴ,״εʱװ
+ * @prama[in]:None
+ * @retval:ۼ .byte
+ */
+size_t mosaicStats::threadAllocBytes()
+{
+	static countingAllocator* counter = []()
+	{
+		countingAllocator* allocator = new countingAllocator(Mat::getDefaultAllocator());
+		Mat::setDefaultAllocator(allocator);
+		return allocator;
+	}();
+	(void)counter;
+	return allocCounter;
+}
+/*-----------------------------------------------------------------------------------*/
@@ -0,0 +1,103 @@
+/*******************************************************************************
+ *
+ * \file    mosaicStats.h
+ * \brief   ƴͳƣֽ׶κʱƥRANSACڵʡڴJSON
+ * \author  agent
+ * \version 1.0
+ * \date    2026-10-19
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * -----------------------------------------------------------------------------
+ * ļ޸ʷ
+ * <ʱ>       | <汾>  | <>         |
+ * 2026-10-19  | v1.0    | agent          |
+ * -----------------------------------------------------------------------------
+ ******************************************************************************/
+#include <opencv2/core.hpp>
+#include "publicElement.h"
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <chrono>
+#include <mutex>
+using namespace cv;
+using namespace std;
+
+#pragma once
+#ifndef MOSAICSTATS_H
+#define MOSAICSTATS_H
+
+class mosaicStats
+{
+public:
+	string tag;										// бʶ(ļ),Ϊ
+	Size leftSize, rightSize;						// ͼߴ
+	double grayMs;									// ҶȻʱ .ms
+	double detectMs;								// ʱ .ms
+	double describeMs;								// ʱ .ms
+	double matchMs;									// ƥʱ .ms
+	double ransacMs;								// RANSACӦƺʱ .ms
+	double warpMs;									// Ӧӳʱ .ms
+	double blendMs;									// عⲹƴںϺʱ .ms
+	double totalMs;									// ܺʱ .ms
+	int keyPtLeft, keyPtRight;						// ͼ
+	int matchNum;									// ƥ
+	int ransacIters;								// RANSAC
+	int inlierNum;									// RANSACڵ
+	int motionModel;								// õ˶ģ,MOTIONMODE_*
+	double inlierRatio;								// ڵ
+	size_t allocBytes;								// ڼ䱾߳Matڴ .byte
+
+public:
+	/*
+	 * @breif:캯,
+	 */
+	mosaicStats();
+
+	/*
+	 * @breif:ʼһͳ;ʱܺʱڴ,Ѵͳļʱ׷һ
+	 * @prama[in]:None
+	 * @retval:None
+	 */
+	void begin();
+	void end();
+
+	/*
+	 * @breif:ͳƼ¼תΪJSON
+	 * @prama[in]:None
+	 * @retval:JSONַ
+	 */
+	string toJson();
+
+	/*
+	 * @breif:򿪡رսڹͳļ(JSON),򿪺ÿend()׷һ,̰߳ȫ
+	 * @prama[in]:fileName->ͳļ·
+	 * @retval:true->ɹ; false->ļ޷
+	 */
+	static bool openSink(string fileName);
+	static void closeSink();
+
+	/*
+	 * @breif:timeBeginĺʱtimeBeginΪǰʱ,׶ʱ
+	 * @prama[in]:timeBegin->ʱ
+	 * @retval:ʱ .ms
+	 */
+	static double elapsedMs(chrono::steady_clock::time_point& timeBegin);
+
+private:
+	chrono::steady_clock::time_point timeBegin;		// ͳƿʼʱ
+	size_t allocBegin;								// ͳƿʼʱ߳Matڴ
+
+	static ofstream sinkFile;						// ͳļ
+	static mutex sinkMutex;							// ͳļд
+
+	/*
+	 * @breif:߳ۼMatڴ,״εʱװ
+	 * @prama[in]:None
+	 * @retval:ۼ .byte
+	 */
+	static size_t threadAllocBytes();
+};
+
+#endif // !MOSAICSTATS_H
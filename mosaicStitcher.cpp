@@ -0,0 +1,328 @@
+/*******************************************************************************
+ *
+ * \file    mosaicStitcher.cpp
+ * \brief   Ƕʽƴӽӿڣ㿽֡ͼ롢д߻ӳ빤ھڿñ
+ * \author  agent
+ * \version 1.0
+ * \date    2026-10-19
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * -----------------------------------------------------------------------------
+ * ļ޸ʷ
+ * <ʱ>       | <汾>  | <>         |
+ * 2026-10-19  | v1.0    | agent          |
+ * -----------------------------------------------------------------------------
+ ******************************************************************************/
+#include "mosaicStitcher.h"
+#include "main.h"
+
+struct mosaicStitcher::stitcher_state
+{
+	imgProcess handle;								// عⲹںϾ,ͼ
+	vector<featureDesc> descHandles;				// ·֡,ø
+	vector<Mat> frames;								// ·֡,ͨʱֱõڴ
+	vector<Mat> colorBufs;							// ͨȥAͨĻ
+	vector<Mat> grayImgs;							// ·֡ĻҶͼ
+	vector<vector<KeyPoint>> keyPts;				// ·֡Ĺؼ
+	vector<Mat> descs;								// ·֡
+	vector<Size> frameSizes;						// ׼ʱĸ֡ߴ,仯ʱ׼
+	vector<Mat> homo;								// iΪi+1·i·ĵӦ,Ϊձʾδ׼
+	vector<Size> mapSizes;							// iƴӶԵӳͼߴ
+	vector<int> leftBounds;							// iƴӶӳͼ߽
+	vector<warpMapCache> mapCaches;					// iƴӶԵӳ
+	vector<mosaicWorkspace> workspaces;				// iƴӶԵĹ
+	validMask mosaicMask;							// ƴӲֵЧ,֡
+	Size dstSize;									// ƴӽߴ
+	bool swapRB;									// ΪRGB˳
+	int sinceRegister;								// ϴ׼ƴӴ
+};
+
+/*===================================================================================*/
+/******************************* к *********************************************/
+/*===================================================================================*/
+
+/*
+ * @breif:졢
+ */
+mosaicStitcher::mosaicStitcher()
+{
+	mosaicStitcher::detectMode = SIFTDETECT;
+	mosaicStitcher::matchType = MATCHMODE_MINMAX;
+	mosaicStitcher::seamMode = SEAMMODE_DP;
+	mosaicStitcher::motionMode = MOTIONMODE_AUTO;
+	mosaicStitcher::keyPtBudget = 0;
+	mosaicStitcher::registerInterval = 1;
+	mosaicStitcher::callNum = 0;
+	mosaicStitcher::state.reset(new stitcher_state());
+	mosaicStitcher::state->swapRB = false;
+	mosaicStitcher::state->sinceRegister = 0;
+}
+mosaicStitcher::~mosaicStitcher()
+{
+}
+
+/*
+ * @breif:׼ƴӽߴ,״ƴǰ
+ * @prama[in]:frames->е֡ͼ; frameNum->֡; width,height->Ľߴ .pix
+ * @retval:STITCHER_OK
+ */
+int mosaicStitcher::prepare(const frame_view* frames, int frameNum, int& width, int& height)
+{
+	stitcher_state& st = *mosaicStitcher::state;
+	try
+	{
+		int ret = mosaicStitcher::wrapFrames(frames, frameNum);
+		if (ret != STITCHER_OK)	return ret;
+		bool sizeChanged = st.frameSizes.size() != st.frames.size();
+		for (size_t f = 0; f < st.frames.size() && !sizeChanged; f++)	sizeChanged = st.frameSizes[f] != st.frames[f].size();
+		bool needRegister = st.homo.empty() || sizeChanged || mosaicStitcher::registerInterval == 1
+			|| (mosaicStitcher::registerInterval > 1 && st.sinceRegister >= mosaicStitcher::registerInterval);
+		if (needRegister && (ret = mosaicStitcher::registerFrames()) != STITCHER_OK)	return ret;
+	}
+	catch (const cv::Exception& e)
+	{
+		mosaicStitcher::lastError = e.what();
+		return STITCHER_ERR_INTERNAL;
+	}
+	catch (const exception& e)
+	{
+		mosaicStitcher::lastError = e.what();
+		return STITCHER_ERR_INTERNAL;
+	}
+	catch (...)
+	{
+		mosaicStitcher::lastError = "δ֪쳣";
+		return STITCHER_ERR_INTERNAL;
+	}
+	width = st.dstSize.width;
+	height = st.dstSize.height;
+	return STITCHER_OK;
+}
+
+/*
+ * @breif:ƴһ֡д߻;Ϊͨͨ˳һʱ,һںֱдû
+ * @prama[in]:frames->е֡ͼ; frameNum->֡; out->,ɹʱ߸Ϊߴ
+ * @retval:STITCHER_OK;岻ʱoutĿ߸Ϊߴ
+ */
+int mosaicStitcher::stitch(const frame_view* frames, int frameNum, frame_buffer& out)
+{
+	stitcher_state& st = *mosaicStitcher::state;
+	int width = 0, height = 0;
+	int ret = mosaicStitcher::prepare(frames, frameNum, width, height);
+	if (ret != STITCHER_OK)	return ret;
+	if (out.data == nullptr || out.format < STITCHER_FORMAT_BGR || out.format > STITCHER_FORMAT_RGBA)
+	{
+		mosaicStitcher::lastError = "Ч";
+		return STITCHER_ERR_ARG;
+	}
+	int outChannels = (out.format >= STITCHER_FORMAT_BGRA) ? 4 : 3;
+	if (out.width < width || out.height < height || out.stride < (size_t)width * outChannels)
+	{
+		mosaicStitcher::lastError = getFormatStr("岻,Ҫ%dx%d", width, height);
+		out.width = width;
+		out.height = height;
+		return STITCHER_ERR_BUFFER;
+	}
+
+	try
+	{
+		st.handle.seamMode = mosaicStitcher::seamMode;
+		st.handle.motionMode = mosaicStitcher::motionMode;
+		Mat outImg(height, width, CV_8UC(outChannels), out.data, out.stride);
+		bool outSwapRB = out.format == STITCHER_FORMAT_RGB || out.format == STITCHER_FORMAT_RGBA;
+		bool direct = outChannels == 3 && outSwapRB == st.swapRB;
+		int camNum = (int)st.frames.size();
+		Mat mosaicImg = st.frames[camNum - 1];
+		for (int i = camNum - 2; i >= 0; i--)
+		{
+			mosaicWorkspace& ws = st.workspaces[i];
+			homoEst homographyMap;
+			// һ·Ч,ӳͼһںϽӳõ
+			homographyMap.imgMapByHomo(mosaicImg, st.homo[i], st.mapSizes[i], st.mapCaches[i], ws.imgMapByHomo, ws.mapMask,
+				(i == camNum - 2) ? nullptr : &st.mosaicMask);
+			// ߴһ,create·,һںϵĽֱڵ߻
+			Mat& dstImg = (i == 0 && direct) ? outImg : ws.dstImg;
+			imageBlend(st.handle, st.frames[i], ws.imgMapByHomo, ws.mapMask, dstImg, st.leftBounds[i], mosaicImg.cols,
+				DEBUGMODE_NORMAL, &st.mosaicMask);
+			mosaicImg = dstImg;
+		}
+		if (!direct)
+		{
+			if (outChannels == 3)	cvtColor(mosaicImg, outImg, COLOR_BGR2RGB);
+			else					cvtColor(mosaicImg, outImg, outSwapRB == st.swapRB ? COLOR_BGR2BGRA : COLOR_BGR2RGBA);
+		}
+	}
+	catch (const cv::Exception& e)
+	{
+		mosaicStitcher::lastError = e.what();
+		return STITCHER_ERR_INTERNAL;
+	}
+	catch (const exception& e)
+	{
+		mosaicStitcher::lastError = e.what();
+		return STITCHER_ERR_INTERNAL;
+	}
+	catch (...)
+	{
+		mosaicStitcher::lastError = "δ֪쳣";
+		return STITCHER_ERR_INTERNAL;
+	}
+	out.width = width;
+	out.height = height;
+	st.sinceRegister++;
+	mosaicStitcher::callNum++;
+	return STITCHER_OK;
+}
+
+/*
+ * @breif:Ӧӳ,´ε׼;뻺屣
+ * @prama[in]:None
+ * @retval:None
+ */
+void mosaicStitcher::reset()
+{
+	mosaicStitcher::state->homo.clear();
+	mosaicStitcher::state->mapCaches.clear();
+	mosaicStitcher::state->sinceRegister = 0;
+}
+/*-----------------------------------------------------------------------------------*/
+
+
+/*===================================================================================*/
+/******************************* ˽к *********************************************/
+/*===================================================================================*/
+
+/*
+ * @breif:װ֡ΪOpenCVͼ(ֱͨõڴ,ͨתڲ)
+ * @prama[in]:frames->֡ͼ; frameNum->֡
+ * @retval:STITCHER_OKSTITCHER_ERR_ARG
+ */
+int mosaicStitcher::wrapFrames(const frame_view* frames, int frameNum)
+{
+	stitcher_state& st = *mosaicStitcher::state;
+	if (frames == nullptr || frameNum < 2)
+	{
+		mosaicStitcher::lastError = "Ҫ֡";
+		return STITCHER_ERR_ARG;
+	}
+	int format = frames[0].format;
+	if (format < STITCHER_FORMAT_BGR || format > STITCHER_FORMAT_RGBA)
+	{
+		mosaicStitcher::lastError = getFormatStr("δ֪ظʽ:%d", format);
+		return STITCHER_ERR_ARG;
+	}
+	int channels = (format >= STITCHER_FORMAT_BGRA) ? 4 : 3;
+	st.frames.resize(frameNum);
+	st.colorBufs.resize(frameNum);
+	for (int f = 0; f < frameNum; f++)
+	{
+		const frame_view& view = frames[f];
+		if (view.data == nullptr || view.width <= 0 || view.height <= 0 || view.format != format
+			|| view.stride < (size_t)view.width * channels)
+		{
+			mosaicStitcher::lastError = getFormatStr("%d֡Ч֡ʽһ", f);
+			return STITCHER_ERR_ARG;
+		}
+		// ֻʹ,дڴ
+		Mat wrapped(view.height, view.width, CV_8UC(channels), (void*)view.data, view.stride);
+		if (channels == 4)
+		{
+			cvtColor(wrapped, st.colorBufs[f], COLOR_BGRA2BGR);
+			st.frames[f] = st.colorBufs[f];
+		}
+		else	st.frames[f] = wrapped;
+	}
+	st.swapRB = format == STITCHER_FORMAT_RGB || format == STITCHER_FORMAT_RGBA;
+	return STITCHER_OK;
+}
+
+/*
+ * @breif:֡һ,֡ƥ䲢ƵӦ,ӳߴߴ
+ * @prama[in]:None
+ * @retval:STITCHER_OKSTITCHER_ERR_REGISTER
+ */
+int mosaicStitcher::registerFrames()
+{
+	stitcher_state& st = *mosaicStitcher::state;
+	int frameNum = (int)st.frames.size();
+	st.descHandles.resize(frameNum);
+	st.grayImgs.resize(frameNum);
+	st.keyPts.resize(frameNum);
+	st.descs.resize(frameNum);
+	for (int f = 0; f < frameNum; f++)
+	{
+		st.descHandles[f].keyPtBudget = mosaicStitcher::keyPtBudget;
+		cvtColor(st.frames[f], st.grayImgs[f], st.swapRB ? COLOR_RGB2GRAY : COLOR_BGR2GRAY);
+	}
+
+	// м֡ͬʱƴӶԵһ,֡һ,ֱ֡ƥ
+	vector<Mat> homo(frameNum - 1);
+	bool matched = true;
+	bool isKnown = pipelineDispatch(mosaicStitcher::detectMode, mosaicStitcher::matchType, [&](auto pipeline)
+	{
+		parallel_for_(Range(0, frameNum), [&](const Range& range)
+		{
+			for (int f = range.start; f < range.end; f++)
+				pipeline.detect(st.descHandles[f], st.grayImgs[f], st.keyPts[f], st.descs[f]);
+		});
+		for (int i = 0; i + 1 < frameNum && matched; i++)
+		{
+			vector<DMatch> goodMatchPt = pipeline.descMatch(st.descs[i], st.descs[i + 1]);
+			bool leftQuery = st.descs[i].rows <= st.descs[i + 1].rows;
+			vector<Point2f> goodPtLeft, goodPtRight;
+			for (const DMatch& m : goodMatchPt)
+			{
+				goodPtLeft.push_back(st.keyPts[i][leftQuery ? m.queryIdx : m.trainIdx].pt);
+				goodPtRight.push_back(st.keyPts[i + 1][leftQuery ? m.trainIdx : m.queryIdx].pt);
+			}
+			if (goodPtLeft.size() < 4)
+			{
+				mosaicStitcher::lastError = getFormatStr("%d%d֡ƥ㲻", i, i + 1);
+				matched = false;
+				break;
+			}
+			homoEst homographyMap(goodPtRight, goodPtLeft, st.frames[i + 1].size());
+			homographyMap.motionMode = mosaicStitcher::motionMode;
+			pipeline.homoEstimate(homographyMap);
+			homo[i] = homographyMap.H;
+		}
+	});
+	if (!isKnown)
+	{
+		mosaicStitcher::lastError = getFormatStr("δ֪ļģʽ:%d", mosaicStitcher::detectMode);
+		return STITCHER_ERR_ARG;
+	}
+	if (!matched)	return STITCHER_ERR_REGISTER;
+
+	// ,ƴλڵi+1֡ϵ,ӳͼ߶ȡƴָ߶
+	vector<Size> mapSizes(frameNum - 1);
+	vector<int> leftBounds(frameNum - 1);
+	Size mosaicSize = st.frames[frameNum - 1].size();
+	for (int i = frameNum - 2; i >= 0; i--)
+	{
+		homoEst homographyMap(vector<Point2f>(), vector<Point2f>(), mosaicSize);
+		homographyMap.H = homo[i];
+		homographyMap.calTransBound();
+		if (homographyMap.rightBound <= 0)
+		{
+			mosaicStitcher::lastError = getFormatStr("%d%d֡׼Ч", i, i + 1);
+			return STITCHER_ERR_REGISTER;
+		}
+		mapSizes[i] = Size(homographyMap.rightBound, mosaicSize.height);
+		leftBounds[i] = homographyMap.leftBound;
+		mosaicSize = Size(cmpMax(st.frames[i].cols, mapSizes[i].width), cmpMax(st.frames[i].rows, mapSizes[i].height));
+	}
+
+	st.homo = homo;
+	st.mapSizes = mapSizes;
+	st.leftBounds = leftBounds;
+	st.dstSize = mosaicSize;
+	st.frameSizes.resize(frameNum);
+	for (int f = 0; f < frameNum; f++)	st.frameSizes[f] = st.frames[f].size();
+	st.mapCaches.resize(frameNum - 1);
+	st.workspaces.resize(frameNum - 1);
+	st.sinceRegister = 0;
+	return STITCHER_OK;
+}
+/*-----------------------------------------------------------------------------------*/
@@ -0,0 +1,124 @@
+/*******************************************************************************
+ *
+ * \file    mosaicStitcher.h
+ * \brief   Ƕʽƴӽӿڣ㿽֡ͼ롢д߻ӳ빤ھڿñ
+ * \author  agent
+ * \version 1.0
+ * \date    2026-10-19
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * -----------------------------------------------------------------------------
+ * ļ޸ʷ
+ * <ʱ>       | <汾>  | <>         |
+ * 2026-10-19  | v1.0    | agent          |
+ * -----------------------------------------------------------------------------
+ ******************************************************************************/
+#include <cstddef>
+#include <cstdio>
+#include <cassert>
+#include <iostream>
+#include <string>
+#include <memory>
+#include "publicElement.h"
+using namespace std;
+
+/*===================================================================================*/
+/******************************** 궨 *********************************************/
+/*===================================================================================*/
+#define STITCHER_FORMAT_BGR			0							// 8λͨ,BGR
+#define STITCHER_FORMAT_RGB			1							// 8λͨ,RGB
+#define STITCHER_FORMAT_BGRA		2							// 8λͨ,BGRA,ʱA
+#define STITCHER_FORMAT_RGBA		3							// 8λͨ,RGBA,ʱA
+
+#define STITCHER_OK					0							// ɹ
+#define STITCHER_ERR_ARG		   -1							// Ч(֡㡢ָ롢ʽδ֪֡ʽһ)
+#define STITCHER_ERR_REGISTER	   -2							// ׼ʧ(ƥ㲻)
+#define STITCHER_ERR_BUFFER		   -3							// 岻,ߴд
+#define STITCHER_ERR_INTERNAL	   -4							// ڲ(OpenCV׼쳣),lastError
+/*-----------------------------------------------------------------------------------*/
+
+#pragma once
+#ifndef MOSAICSTITCHER_H
+#define MOSAICSTITCHER_H
+
+/*
+ * ӿڲOpenCVͷļ֡,֡׼ӳں;
+ * ֡ߴ·δ׼ļʱֱӸõӦӳ,ֻӳںϡ
+ */
+class mosaicStitcher
+{
+public:
+	typedef struct
+	{
+		const unsigned char* data;					// صַ,ڼֻ
+		int width, height;							//  .pix
+		size_t stride;								// ֽ
+		int format;									// ظʽ,STITCHER_FORMAT_*
+	}frame_view;
+
+	typedef struct
+	{
+		unsigned char* data;						// صַ
+		int width, height;							// Ϊ,Ϊƴӽߴ(дϽ) .pix
+		size_t stride;								// ֽ
+		int format;									// ظʽ,STITCHER_FORMAT_*
+	}frame_buffer;
+
+	int detectMode;									// ģʽ
+	int matchType;									// ƥ
+	int seamMode;									// ƴӷŻģʽ
+	int motionMode;									// ˶ģ
+	int keyPtBudget;								// ÿ֡,0Ϊ
+	int registerInterval;							// ÿٴε׼,1Ϊÿ,0Ϊ״(̶λ)
+	int callNum;									// ɵƴӴ
+	string lastError;								// һʧܵԭ
+
+public:
+	/*
+	 * @breif:졢
+	 */
+	mosaicStitcher();
+	~mosaicStitcher();
+
+	/*
+	 * @breif:׼ƴӽߴ,״ƴǰ
+	 * @prama[in]:frames->е֡ͼ; frameNum->֡; width,height->Ľߴ .pix
+	 * @retval:STITCHER_OK
+	 */
+	int prepare(const frame_view* frames, int frameNum, int& width, int& height);
+
+	/*
+	 * @breif:ƴһ֡д߻;Ϊͨͨ˳һʱ,һںֱдû
+	 * @prama[in]:frames->е֡ͼ; frameNum->֡; out->,ɹʱ߸Ϊߴ
+	 * @retval:STITCHER_OK;岻ʱoutĿ߸Ϊߴ
+	 */
+	int stitch(const frame_view* frames, int frameNum, frame_buffer& out);
+
+	/*
+	 * @breif:Ӧӳ,´ε׼;뻺屣
+	 * @prama[in]:None
+	 * @retval:None
+	 */
+	void reset();
+
+private:
+	struct stitcher_state;							// ڲ״̬,mosaicStitcher.cpp
+	unique_ptr<stitcher_state> state;
+
+	/*
+	 * @breif:װ֡ΪOpenCVͼ(ֱͨõڴ,ͨתڲ)
+	 * @prama[in]:frames->֡ͼ; frameNum->֡
+	 * @retval:STITCHER_OKSTITCHER_ERR_ARG
+	 */
+	int wrapFrames(const frame_view* frames, int frameNum);
+
+	/*
+	 * @breif:֡һ,֡ƥ䲢ƵӦ,ӳߴߴ
+	 * @prama[in]:None
+	 * @retval:STITCHER_OKSTITCHER_ERR_REGISTER
+	 */
+	int registerFrames();
+};
+
+#endif // !MOSAICSTITCHER_H
@@ -0,0 +1,69 @@
+/*******************************************************************************
+ *
+ * \file    mosaicWorkspace.cpp
+ * \brief   ƴӹ֡ͬһƴӶԵм仺壬֡ߴ粻ʱ
+ * \author  agent
+ * \version 1.0
+ * \date    2026-10-19
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * -----------------------------------------------------------------------------
+ * ļ޸ʷ
+ * <ʱ>       | <汾>  | <>         |
+ * 2026-10-19  | v1.0    | agent          |
+ * -----------------------------------------------------------------------------
+ ******************************************************************************/
+#include "mosaicWorkspace.h"
+
+/*===================================================================================*/
+/******************************* к *********************************************/
+/*===================================================================================*/
+
+/*
+ * @breif:ƥ,
+ * @prama[in]:None
+ * @retval:None
+ */
+void mosaicWorkspace::clear()
+{
+	mosaicWorkspace::keyPtLeft.clear();
+	mosaicWorkspace::keyPtRight.clear();
+	mosaicWorkspace::goodMatchPt.clear();
+	mosaicWorkspace::goodPtLeft.clear();
+	mosaicWorkspace::goodPtRight.clear();
+}
+
+/*
+ * @breif:ͷȫ
+ * @prama[in]:None
+ * @retval:None
+ */
+void mosaicWorkspace::release()
+{
+	mosaicWorkspace::grayImgLeft.release();
+	mosaicWorkspace::grayImgRight.release();
+	mosaicWorkspace::imgMapByHomo.release();
+	mosaicWorkspace::mapMask.release();
+	mosaicWorkspace::dstImg.release();
+	vector<KeyPoint>().swap(mosaicWorkspace::keyPtLeft);
+	vector<KeyPoint>().swap(mosaicWorkspace::keyPtRight);
+	vector<DMatch>().swap(mosaicWorkspace::goodMatchPt);
+	vector<Point2f>().swap(mosaicWorkspace::goodPtLeft);
+	vector<Point2f>().swap(mosaicWorkspace::goodPtRight);
+}
+
+/*
+ * @breif:ռõͼ񻺳
+ * @prama[in]:None
+ * @retval:ռ .byte
+ */
+size_t mosaicWorkspace::bytes()
+{
+	size_t total = 0;
+	for (const Mat& img : { mosaicWorkspace::grayImgLeft, mosaicWorkspace::grayImgRight, mosaicWorkspace::imgMapByHomo,
+		mosaicWorkspace::dstImg })
+		total += img.total() * img.elemSize();
+	return total + mosaicWorkspace::mapMask.bytes();
+}
+/*-----------------------------------------------------------------------------------*/
@@ -0,0 +1,63 @@
+/*******************************************************************************
+ *
+ * \file    mosaicWorkspace.h
+ * \brief   ƴӹ֡ͬһƴӶԵм仺壬֡ߴ粻ʱ
+ * \author  agent
+ * \version 1.0
+ * \date    2026-10-19
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * -----------------------------------------------------------------------------
+ * ļ޸ʷ
+ * <ʱ>       | <汾>  | <>         |
+ * 2026-10-19  | v1.0    | agent          |
+ * -----------------------------------------------------------------------------
+ ******************************************************************************/
+#include <opencv2/core.hpp>
+#include <opencv2/features2d.hpp>
+#include "publicElement.h"
+#include "validMask.h"
+#include <vector>
+using namespace cv;
+using namespace std;
+
+#pragma once
+#ifndef MOSAICWORKSPACE_H
+#define MOSAICWORKSPACE_H
+
+class mosaicWorkspace
+{
+public:
+	Mat grayImgLeft, grayImgRight;					// Ҷͼ
+	vector<KeyPoint> keyPtLeft, keyPtRight;			// ؼ
+	vector<DMatch> goodMatchPt;						// ƥ
+	vector<Point2f> goodPtLeft, goodPtRight;		// ƥ
+	Mat imgMapByHomo;								// ӳ䵽ͼϵͼ
+	validMask mapMask;								// ӳͼЧ
+	Mat dstImg;										// ƴӽ,´ʹͬһƴǰЧ
+
+public:
+	/*
+	 * @breif:ƥ,
+	 * @prama[in]:None
+	 * @retval:None
+	 */
+	void clear();
+
+	/*
+	 * @breif:ͷȫ
+	 * @prama[in]:None
+	 * @retval:None
+	 */
+	void release();
+
+	/*
+	 * @breif:ռõͼ񻺳
+	 * @prama[in]:None
+	 * @retval:ռ .byte
+	 */
+	size_t bytes();
+};
+
+#endif // !MOSAICWORKSPACE_H
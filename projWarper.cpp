@@ -0,0 +1,169 @@
+/*******************************************************************************
+ *
+ * \file    projWarper.cpp
+ * \brief   桢ͶӰԤ㶨ӳԴͼͶӰջƴ
+ * \author  agent
+ * \version 1.0
+ * \date    2026-10-19
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * -----------------------------------------------------------------------------
+ * ļ޸ʷ
+ * <ʱ>       | <汾>  | <>         |
+ * 2026-10-19  | v1.0    | agent          |
+ * -----------------------------------------------------------------------------
+ ******************************************************************************/
+#include "projWarper.h"
+
+map<string, shared_ptr<projWarper>> projWarper::cache;
+mutex projWarper::cacheMutex;
+
+/*===================================================================================*/
+/******************************* к *********************************************/
+/*===================================================================================*/
+
+/*
+ * @breif:캯
+ */
+projWarper::projWarper()
+{
+	projWarper::projMode = PROJMODE_PLANE;
+	projWarper::focal = 0;
+}
+
+/*
+ * @breif:жӳǷӦͶӰģʽԴͼߴ
+ * @prama[in]:projMode->ͶӰģʽ; focal-> .pix; srcSize->Դͼߴ
+ * @retval:true->ӳЧ
+ */
+bool projWarper::isValid(int projMode, double focal, Size srcSize)
+{
+	return !projWarper::mapXY.empty() && projWarper::projMode == projMode && projWarper::srcSize == srcSize
+		&& abs(projWarper::focal - focal) < 1e-3;
+}
+
+/*
+ * @breif:ԤͶӰͼԴͼĶӳ,ȡԴͼ
+ * @prama[in]:projMode->ͶӰģʽ; focal-> .pix; srcSize->Դͼߴ
+ * @retval:None
+ */
+void projWarper::build(int projMode, double focal, Size srcSize)
+{
+	projWarper::projMode = projMode;
+	projWarper::focal = focal;
+	projWarper::srcSize = srcSize;
+	projWarper::dstSize = projWarper::calDstSize(projMode, focal, srcSize);
+	Size dstSize = projWarper::dstSize;
+	projWarper::mapXY.create(dstSize, CV_16SC2);
+	projWarper::mapA.create(dstSize, CV_16UC1);
+
+	// ͶӰ(theta,phi)=(u,v)/focal,ͶӰԴͼƽ
+	double srcCx = srcSize.width * 0.5, srcCy = srcSize.height * 0.5;
+	double dstCx = dstSize.width * 0.5, dstCy = dstSize.height * 0.5;
+	int stripNum = (dstSize.height + PROJ_STRIP - 1) / PROJ_STRIP;
+	parallel_for_(Range(0, stripNum), [&](const Range& range)
+	{
+		Mat stripX(PROJ_STRIP, dstSize.width, CV_32FC1), stripY(PROJ_STRIP, dstSize.width, CV_32FC1);
+		vector<double> tanTheta(dstSize.width), secTheta(dstSize.width);
+		for (int j = 0; j < dstSize.width; j++)
+		{
+			double theta = (j + 0.5 - dstCx) / focal;
+			tanTheta[j] = tan(theta);
+			secTheta[j] = 1.0 / cos(theta);
+		}
+		for (int s = range.start; s < range.end; s++)
+		{
+			int rowBegin = s * PROJ_STRIP;
+			int rowEnd = cmpMin(rowBegin + PROJ_STRIP, dstSize.height);
+			for (int i = rowBegin; i < rowEnd; i++)
+			{
+				float* rowAddrX = stripX.ptr<float>(i - rowBegin);
+				float* rowAddrY = stripY.ptr<float>(i - rowBegin);
+				double v = i + 0.5 - dstCy;
+				double h = (projMode == PROJMODE_SPHERE) ? focal * tan(v / focal) : v;	// Ϊ߶,Ϊtan(phi)*focal
+				for (int j = 0; j < dstSize.width; j++)
+				{
+					rowAddrX[j] = (float)(focal * tanTheta[j] + srcCx - 0.5);
+					rowAddrY[j] = (float)(h * secTheta[j] + srcCy - 0.5);
+				}
+			}
+			Mat dstXY = projWarper::mapXY.rowRange(rowBegin, rowEnd);
+			Mat dstA = projWarper::mapA.rowRange(rowBegin, rowEnd);
+			convertMaps(stripX.rowRange(0, rowEnd - rowBegin), stripY.rowRange(0, rowEnd - rowBegin), dstXY, dstA, CV_16SC2);
+		}
+	});
+}
+
+/*
+ * @breif:remap,ӳֻ,ɶ̹߳
+ * @prama[in]:srcImg->Դͼ; dstImg->ͶӰͼ,ߴΪdstSize
+ * @retval:None
+ */
+void projWarper::apply(const Mat& srcImg, Mat& dstImg) const
+{
+	dstImg.create(projWarper::dstSize, srcImg.type());
+	int stripNum = (projWarper::dstSize.height + PROJ_STRIP - 1) / PROJ_STRIP;
+	parallel_for_(Range(0, stripNum), [&](const Range& range)
+	{
+		for (int s = range.start; s < range.end; s++)
+		{
+			int rowBegin = s * PROJ_STRIP;
+			int rowEnd = cmpMin(rowBegin + PROJ_STRIP, projWarper::dstSize.height);
+			Mat dstStrip = dstImg.rowRange(rowBegin, rowEnd);
+			remap(srcImg, dstStrip, projWarper::mapXY.rowRange(rowBegin, rowEnd), projWarper::mapA.rowRange(rowBegin, rowEnd),
+				INTER_LINEAR, BORDER_CONSTANT, Scalar(0, 0, 0));
+		}
+	});
+}
+
+/*
+ * @breif:ͶӰģʽԴͼߴȡڹӳ,ʱ,̸֡߳
+ * @prama[in]:projMode->ͶӰģʽ; focal-> .pix; srcSize->Դͼߴ
+ * @retval:ӳ
+ */
+shared_ptr<projWarper> projWarper::get(int projMode, double focal, Size srcSize)
+{
+	string key = getFormatStr("%d_%.3f_%dx%d", projMode, focal, srcSize.width, srcSize.height);
+	lock_guard<mutex> lock(projWarper::cacheMutex);
+	auto it = projWarper::cache.find(key);
+	if (it != projWarper::cache.end())	return it->second;
+
+	// ߴƵ仯ʱ,ȡľɵ߳
+	if (projWarper::cache.size() >= PROJ_CACHEMAX)	projWarper::cache.clear();
+	shared_ptr<projWarper> warper = make_shared<projWarper>();
+	warper->build(projMode, focal, srcSize);
+	projWarper::cache[key] = warper;
+	return warper;
+}
+
+/*
+ * @breif:սڹӳ
+ * @prama[in]:None
+ * @retval:None
+ */
+void projWarper::clearCache()
+{
+	lock_guard<mutex> lock(projWarper::cacheMutex);
+	projWarper::cache.clear();
+}
+/*-----------------------------------------------------------------------------------*/
+
+
+/*===================================================================================*/
+/******************************* ˽к *********************************************/
+/*===================================================================================*/
+
+/*
+ * @breif:ͶӰͼߴ,߶Ȳ,߶ͬǶѹ
+ * @prama[in]:projMode->ͶӰģʽ; focal-> .pix; srcSize->Դͼߴ
+ * @retval:ͶӰͼߴ
+ */
+Size projWarper::calDstSize(int projMode, double focal, Size srcSize)
+{
+	int width = (int)ceil(2 * focal * atan(srcSize.width * 0.5 / focal));
+	int height = srcSize.height;
+	if (projMode == PROJMODE_SPHERE)	height = (int)ceil(2 * focal * atan(srcSize.height * 0.5 / focal));
+	return Size(cmpMax(width, 1), cmpMax(height, 1));
+}
+/*-----------------------------------------------------------------------------------*/
@@ -0,0 +1,100 @@
+/*******************************************************************************
+ *
+ * \file    projWarper.h
+ * \brief   桢ͶӰԤ㶨ӳԴͼͶӰջƴ
+ * \author  agent
+ * \version 1.0
+ * \date    2026-10-19
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * -----------------------------------------------------------------------------
+ * ļ޸ʷ
+ * <ʱ>       | <汾>  | <>         |
+ * 2026-10-19  | v1.0    | agent          |
+ * -----------------------------------------------------------------------------
+ ******************************************************************************/
+#include <opencv2/imgproc/imgproc.hpp>
+#include "publicElement.h"
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+using namespace cv;
+using namespace std;
+
+/*===================================================================================*/
+/******************************** 궨 *********************************************/
+/*===================================================================================*/
+#define PROJ_STRIP				   64							// д
+#define PROJ_CACHEMAX			   16							// ڻӳ
+/*-----------------------------------------------------------------------------------*/
+
+#pragma once
+#ifndef PROJWARPER_H
+#define PROJWARPER_H
+
+class projWarper
+{
+public:
+	int projMode;									// ͶӰģʽ,PROJMODE_CYLINDERPROJMODE_SPHERE
+	double focal;									//  .pix(Դͼ)
+	Size srcSize;									// Դͼߴ
+	Size dstSize;									// ͶӰͼߴ,ԼΪfocal*ˮƽӳ
+	Mat mapXY;										// ӳ,CV_16SC2
+	Mat mapA;										// ֵ,CV_16UC1
+
+public:
+	/*
+	 * @breif:캯
+	 */
+	projWarper();
+
+	/*
+	 * @breif:жӳǷӦͶӰģʽԴͼߴ
+	 * @prama[in]:projMode->ͶӰģʽ; focal-> .pix; srcSize->Դͼߴ
+	 * @retval:true->ӳЧ
+	 */
+	bool isValid(int projMode, double focal, Size srcSize);
+
+	/*
+	 * @breif:ԤͶӰͼԴͼĶӳ,ȡԴͼ
+	 * @prama[in]:projMode->ͶӰģʽ; focal-> .pix; srcSize->Դͼߴ
+	 * @retval:None
+	 */
+	void build(int projMode, double focal, Size srcSize);
+
+	/*
+	 * @breif:remap,ӳֻ,ɶ̹߳
+	 * @prama[in]:srcImg->Դͼ; dstImg->ͶӰͼ,ߴΪdstSize
+	 * @retval:None
+	 */
+	void apply(const Mat& srcImg, Mat& dstImg) const;
+
+	/*
+	 * @breif:ͶӰģʽԴͼߴȡڹӳ,ʱ,̸֡߳
+	 * @prama[in]:projMode->ͶӰģʽ; focal-> .pix; srcSize->Դͼߴ
+	 * @retval:ӳ
+	 */
+	static shared_ptr<projWarper> get(int projMode, double focal, Size srcSize);
+
+	/*
+	 * @breif:սڹӳ
+	 * @prama[in]:None
+	 * @retval:None
+	 */
+	static void clearCache();
+
+private:
+	static map<string, shared_ptr<projWarper>> cache;	// ڹӳ,ģʽߴ
+	static mutex cacheMutex;
+
+	/*
+	 * @breif:ͶӰͼߴ,߶Ȳ,߶ͬǶѹ
+	 * @prama[in]:projMode->ͶӰģʽ; focal-> .pix; srcSize->Դͼߴ
+	 * @retval:ͶӰͼߴ
+	 */
+	static Size calDstSize(int projMode, double focal, Size srcSize);
+};
+
+#endif // !PROJWARPER_H
@@ -37,8 +37,66 @@
 
 #define MATCHMODE_LOWS          0               // LOW'Sƥ䷨
 #define MATCHMODE_MINMAX        1               // MINMAXƥ䷨
+#define MATCHMODE_ANN           2               // MINMAXƥ䷨,HNSW(ͬMINMAX)
+
+#define SEAMMODE_ALPHA          0               // صalphaں
+#define SEAMMODE_DP             1               // ̬滮ƴӷ
+#define SEAMMODE_GRAPHCUT       2               // ͼƴӷ
+
+#define GAINMODE_NONE           0               // عⲹ
+#define GAINMODE_IMAGE          1               // ͼһ
+#define GAINMODE_BLOCK          2               // зֿ
+
+#define MOTIONMODE_TRANSLATION  0               // ƽģ(2ɶ,1С)
+#define MOTIONMODE_SIMILARITY   1               // ģ(4ɶ,2С)
+#define MOTIONMODE_AFFINE       2               // ģ(6ɶ,3С)
+#define MOTIONMODE_HOMOGRAPHY   3               // Ӧģ(8ɶ,4С)
+#define MOTIONMODE_AUTO         4               // GRICԶѡ,ҪʱΪӦ
+
+#define PROJMODE_PLANE          0               // ͶӰ,ֱӵӦӳ
+#define PROJMODE_CYLINDER       1               // ͶӰ,ˮƽӳǳ
+#define PROJMODE_SPHERE         2               // ͶӰ,ˮƽֱǶѹ
 
 #define WINDOW_NAME         "ͼƴչʾ桿"
+
+// ޽湹(ʱMOSAIC_HEADLESS)highgui,ʾΪ
+#ifdef MOSAIC_HEADLESS
+#define MOSAIC_SHOW(winName, img)   ((void)0)
+#else
+#define MOSAIC_SHOW(winName, img)   imshow(winName, img)
+#endif
+
+#define LOGLEVEL_NONE           0               // ־
+#define LOGLEVEL_ERROR          1               // 
+#define LOGLEVEL_WARN           2               // 
+#define LOGLEVEL_INFO           3               // Ϣ
+#define LOGLEVEL_DEBUG          4               // Ϣ(RANSAC)
+
+// ־,ڸü־Ϊ;ڼmosaicLogLevel()һ
+#ifndef MOSAIC_LOGLEVEL
+#define MOSAIC_LOGLEVEL         LOGLEVEL_INFO
+#endif
+#define MOSAIC_LOG(level, msg)  do { if ((level) <= mosaicLogLevel()) std::cerr << msg << std::endl; } while (0)
+#if MOSAIC_LOGLEVEL >= LOGLEVEL_ERROR
+#define MOSAIC_LOG_ERROR(msg)   MOSAIC_LOG(LOGLEVEL_ERROR, msg)
+#else
+#define MOSAIC_LOG_ERROR(msg)   ((void)0)
+#endif
+#if MOSAIC_LOGLEVEL >= LOGLEVEL_WARN
+#define MOSAIC_LOG_WARN(msg)    MOSAIC_LOG(LOGLEVEL_WARN, msg)
+#else
+#define MOSAIC_LOG_WARN(msg)    ((void)0)
+#endif
+#if MOSAIC_LOGLEVEL >= LOGLEVEL_INFO
+#define MOSAIC_LOG_INFO(msg)    MOSAIC_LOG(LOGLEVEL_INFO, msg)
+#else
+#define MOSAIC_LOG_INFO(msg)    ((void)0)
+#endif
+#if MOSAIC_LOGLEVEL >= LOGLEVEL_DEBUG
+#define MOSAIC_LOG_DEBUG(msg)   MOSAIC_LOG(LOGLEVEL_DEBUG, msg)
+#else
+#define MOSAIC_LOG_DEBUG(msg)   ((void)0)
+#endif
 /*-----------------------------------------------------------------------------------*/
 
 /*===================================================================================*/
@@ -69,6 +127,13 @@ inline int cmpMin(int x, int y)
 {
     return (x > y) ? y : x;
 }
+
+// ־,Ĭڼͬ,ʱ
+inline int& mosaicLogLevel()
+{
+    static int level = MOSAIC_LOGLEVEL;
+    return level;
+}
 /*-----------------------------------------------------------------------------------*/
 
 #endif // !PUBLICELEMENT_H
\ No newline at end of file
@@ -1,12 +1,10 @@
 #pragma once
-#include <opencv2/features2d.hpp>
 #include <opencv2/core.hpp>
-#include <opencv2/opencv.hpp>
-#include <opencv2/highgui/highgui.hpp>
-#include <opencv2/imgproc/imgproc.hpp>
-#include <opencv2/features2d.hpp>
+#include <opencv2/calib3d.hpp>
+#include <algorithm>
 #include <iostream>
 #include"ransac_personal.h"
+#include "publicElement.h"
 
 
 
@@ -196,44 +194,152 @@ void CalculateInliers(
 )	//βΣƥ㣬õHֵǰõinlier㼯
 {
 	current_inliers.clear();	//յǰڵ㼯
-	cv::Mat homogeneous_points1, homogeneous_points2;	//mat
+	// ֱӰ3x3ϵͶӰ,Ϊÿ㹹Mat
+	cv::Mat matrix_H_32, matrix_H_inv;
+	matrix_H.convertTo(matrix_H_32, CV_32F);
+	matrix_H_inv = matrix_H_32.inv();	//H󲢸ֵ
+	float h[9], h_inv[9];
+	for (int k = 0; k < 9; k++)
+	{
+		h[k] = matrix_H_32.at<float>(k / 3, k % 3);
+		h_inv[k] = matrix_H_inv.at<float>(k / 3, k % 3);
+	}
 
-	cv::convertPointsToHomogeneous(points_img1, homogeneous_points1);
-	cv::convertPointsToHomogeneous(points_img2, homogeneous_points2);	//ƥתΪʽ
-	cv::Mat matrix_H_inv = matrix_H.inv();	//H󲢸ֵ
+	for (size_t idx = 0; idx < points_img1.size(); ++idx)
+	{
+		const cv::Point2f& p1 = points_img1[idx];
+		const cv::Point2f& p2 = points_img2[idx];
+		float w1 = h[6] * p1.x + h[7] * p1.y + h[8];
+		float w2 = h_inv[6] * p2.x + h_inv[7] * p2.y + h_inv[8];
+		cv::Point2f v1_prime_cartesian((h[0] * p1.x + h[1] * p1.y + h[2]) / w1, (h[3] * p1.x + h[4] * p1.y + h[5]) / w1);
+		cv::Point2f v2_prime_cartesian((h_inv[0] * p2.x + h_inv[1] * p2.y + h_inv[2]) / w2,
+			(h_inv[3] * p2.x + h_inv[4] * p2.y + h_inv[5]) / w2);
 
-	for (size_t idx = 0; idx < homogeneous_points1.rows; ++idx)
+		float distance = cv::norm(p2 - v1_prime_cartesian)
+			+ cv::norm(p1 - v2_prime_cartesian);
+
+		if (distance < threshold)
+		{
+			current_inliers.emplace_back(idx);
+		}
+	}
+}
+
+//˶ģ͵С
+size_t GetMotionSampleSize(const int& motion_model)
+{
+	switch (motion_model)
 	{
-		cv::Mat v1 = homogeneous_points1.row(idx).reshape(1, 3);
-		cv::Mat v2 = homogeneous_points2.row(idx).reshape(1, 3);
-		cv::Mat v1_prime = matrix_H * v1;
-		cv::Mat v2_prime = matrix_H_inv * v2;
+	case(MOTIONMODE_TRANSLATION):	return 1;
+	case(MOTIONMODE_SIMILARITY):	return 2;
+	case(MOTIONMODE_AFFINE):		return 3;
+	default:						return 4;
+	}
+}
 
-		float v1_prime_x = v1_prime.at<float>(0, 0) / v1_prime.at<float>(2, 0);
-		float v1_prime_y = v1_prime.at<float>(1, 0) / v1_prime.at<float>(2, 0);
-		float v2_prime_x = v2_prime.at<float>(0, 0) / v2_prime.at<float>(2, 0);
-		float v2_prime_y = v2_prime.at<float>(1, 0) / v2_prime.at<float>(2, 0);
+//˶ģ͵ɶ
+size_t GetMotionDoF(const int& motion_model)
+{
+	return 2 * GetMotionSampleSize(motion_model);
+}
 
-		cv::Point2f v1_prime_cartesian = { v1_prime_x, v1_prime_y };
-		cv::Point2f v2_prime_cartesian = { v2_prime_x, v2_prime_y };
+//˶ģͼ3x3任(CV_32F)СʱΪС˽⣬˻ʱؿվ
+cv::Mat CalculateMotionMatrix(
+	std::vector<cv::Point2f>& points_img1,
+	std::vector<cv::Point2f>& points_img2,
+	std::vector<size_t>& indices,
+	const int& motion_model
+)
+{
+	if (motion_model == MOTIONMODE_HOMOGRAPHY)
+		return CalculateHomographyMatrix(points_img1, points_img2, indices);
+	if (indices.empty())
+		return cv::Mat();
 
-		float distance = cv::norm(points_img2.at(idx) - v1_prime_cartesian)
-			+ cv::norm(points_img1.at(idx) - v2_prime_cartesian);
+	// ģģȥԲ
+	cv::Point2f mass_point1(0, 0), mass_point2(0, 0);
+	for (const auto& idx : indices)
+	{
+		mass_point1 += points_img1[idx];
+		mass_point2 += points_img2[idx];
+	}
+	mass_point1 *= (1.0f / indices.size());
+	mass_point2 *= (1.0f / indices.size());
 
-		if (distance < threshold)
+	double a = 1, b = 0, c = 0, d = 1;	// Բ[a b; c d]
+	if (motion_model == MOTIONMODE_SIMILARITY)
+	{
+		// x' = a*x - c*y, y' = c*x + a*y ıʽС˽
+		double s_pp = 0, s_a = 0, s_c = 0;
+		for (const auto& idx : indices)
 		{
-			current_inliers.emplace_back(idx);
+			cv::Point2f p = points_img1[idx] - mass_point1;
+			cv::Point2f q = points_img2[idx] - mass_point2;
+			s_pp += p.x * p.x + p.y * p.y;
+			s_a += p.x * q.x + p.y * q.y;
+			s_c += p.x * q.y - p.y * q.x;
+		}
+		if (s_pp < 1e-6)
+			return cv::Mat();
+		a = d = s_a / s_pp;
+		c = s_c / s_pp;
+		b = -c;
+	}
+	else if (motion_model == MOTIONMODE_AFFINE)
+	{
+		// зֱ2x2淽
+		double s_xx = 0, s_xy = 0, s_yy = 0, s_xu = 0, s_yu = 0, s_xv = 0, s_yv = 0;
+		for (const auto& idx : indices)
+		{
+			cv::Point2f p = points_img1[idx] - mass_point1;
+			cv::Point2f q = points_img2[idx] - mass_point2;
+			s_xx += p.x * p.x;	s_xy += p.x * p.y;	s_yy += p.y * p.y;
+			s_xu += p.x * q.x;	s_yu += p.y * q.x;
+			s_xv += p.x * q.y;	s_yv += p.y * q.y;
 		}
+		double det = s_xx * s_yy - s_xy * s_xy;
+		if (std::abs(det) < 1e-6 * (s_xx + s_yy) * (s_xx + s_yy) + 1e-12)	//
+			return cv::Mat();
+		a = (s_xu * s_yy - s_yu * s_xy) / det;
+		b = (s_yu * s_xx - s_xu * s_xy) / det;
+		c = (s_xv * s_yy - s_yv * s_xy) / det;
+		d = (s_yv * s_xx - s_xv * s_xy) / det;
 	}
+
+	cv::Mat matrix_H = cv::Mat::eye(3, 3, CV_32F);
+	matrix_H.at<float>(0, 0) = (float)a;
+	matrix_H.at<float>(0, 1) = (float)b;
+	matrix_H.at<float>(1, 0) = (float)c;
+	matrix_H.at<float>(1, 1) = (float)d;
+	matrix_H.at<float>(0, 2) = (float)(mass_point2.x - (a * mass_point1.x + b * mass_point1.y));
+	matrix_H.at<float>(1, 2) = (float)(mass_point2.y - (c * mass_point1.x + d * mass_point1.y));
+	return matrix_H;
 }
 
-//ԶRANSAChomo㷨岿֣
-void GetHomographyRANSAC(
+//ԶRANSAChomo㷨岿֣ʵʵbest_inliersڵ
+size_t GetHomographyRANSAC(
 	std::vector<cv::Point2f>& points_img1,
 	std::vector<cv::Point2f>& points_img2,
 	const size_t& k_sample_size,
 	cv::Mat& best_matrix_H,
-	std::vector<size_t> best_inliers,
+	std::vector<size_t>& best_inliers,
+	const float& threshold,
+	const size_t& max_iterations,
+	const float& confidence
+)
+{
+	return GetMotionRANSAC(points_img1, points_img2, MOTIONMODE_HOMOGRAPHY, k_sample_size, best_matrix_H, best_inliers,
+		threshold, max_iterations, confidence);
+}
+
+//˶ģ͵RANSACʵʵbest_inliersڵ
+size_t GetMotionRANSAC(
+	std::vector<cv::Point2f>& points_img1,
+	std::vector<cv::Point2f>& points_img2,
+	const int& motion_model,
+	const size_t& k_sample_size,
+	cv::Mat& best_matrix_H,
+	std::vector<size_t>& best_inliers,
 	const float& threshold,
 	const size_t& max_iterations,
 	const float& confidence
@@ -245,6 +351,10 @@ void GetHomographyRANSAC(
 	// The current number of iterations
 	size_t iteration_number = 0;
 	size_t n_iterations = max_iterations;
+	best_inliers.clear();
+	best_matrix_H.release();
+	if (n_points < k_sample_size)	//Сʱ޷
+		return 0;
 	// The indices of the inliers of the current best model
 	std::vector<size_t> current_inliers;
 	current_inliers.reserve(points_img1.size());
@@ -252,30 +362,30 @@ void GetHomographyRANSAC(
 	std::vector<size_t> sample_indices;		//indices
 	sample_indices.reserve(k_sample_size);	//̬ڲ
 
-	std::cout << "Searching for Homography with RANSAC!" << std::endl
+	MOSAIC_LOG_DEBUG("Searching for motion model " << motion_model << " with RANSAC!" << std::endl
 		<< "Number of found point correspondences: " << points_img1.size()
 		<< std::endl << "Threshold is: " << threshold << std::endl
-		<< "Performing " << max_iterations << " iterations." << std::endl;
+		<< "Performing " << max_iterations << " iterations.");
 
 	while (iteration_number++ < n_iterations)	//δﵽʱ
 	{
 		if (iteration_number % 10 == 0)	//10ı
-			std::cout << "Current iteration: " << iteration_number << std::endl;	//ǰ
+			MOSAIC_LOG_DEBUG("Current iteration: " << iteration_number);	//ǰ
 		SelectMinimalSample(n_points, sample_indices, k_sample_size);	//ݵвɼСݵ
 		// collinearity check here....
 		// Translation and Scale matrices
-		cv::Mat matrix_H = CalculateHomographyMatrix(points_img1,
-			points_img2, sample_indices);		//ݵǰģͼƥ֮homo
-		cv::Mat matrix_H_inv = matrix_H.inv();	//H
+		cv::Mat matrix_H = CalculateMotionMatrix(points_img1,
+			points_img2, sample_indices, motion_model);		//ݵǰģͼƥ֮ı任
+		if (matrix_H.empty())	//˻
+			continue;
 		// Count the number of inliers
 		CalculateInliers(points_img1, points_img2, matrix_H,
 			threshold, current_inliers);	//㵱ǰ״̬µڼ
 
 		if (current_inliers.size() > best_inliers.size())	//˵ǰѵڼʱڼϵС
 		{
-			std::cout << "Iteration number: " << iteration_number << std::endl
-				<< "Current best inliers size: " << current_inliers.size()
-				<< std::endl;
+			MOSAIC_LOG_DEBUG("Iteration number: " << iteration_number << std::endl
+				<< "Current best inliers size: " << current_inliers.size());
 
 			best_inliers.swap(current_inliers);
 			best_matrix_H = matrix_H.clone();	//Ƶǰhomo
@@ -290,9 +400,103 @@ void GetHomographyRANSAC(
 			confidence,
 			k_sample_size
 		);	//
+		n_iterations = std::min(n_iterations, max_iterations);
+	}
+	if (best_inliers.size() >= k_sample_size)
+	{
+		cv::Mat matrix_H = CalculateMotionMatrix(points_img1, points_img2,
+			best_inliers, motion_model);	//ڼϼӦı任
+		if (!matrix_H.empty())
+			best_matrix_H = matrix_H;
+	}
+	return iteration_number - 1;
+}
+
+//GRICģѡ׼(Torr)в³ضϺϰɶȵģ͸ӶȳͷֵԽСԽ
+double CalculateGRIC(
+	std::vector<cv::Point2f>& points_img1,
+	std::vector<cv::Point2f>& points_img2,
+	cv::Mat& matrix_H,
+	const int& motion_model,
+	const float& sigma
+)
+{
+	const double r = 4, d = 2;	//ά(ͼ2ά)ģά(ƽӳΪ2)
+	const double n = (double)points_img1.size();
+	const double lambda1 = log(r), lambda2 = log(r * n), lambda3 = 2;
+	cv::Mat matrix_H_32;
+	matrix_H.convertTo(matrix_H_32, CV_32F);
+	const float* h = matrix_H_32.ptr<float>(0);
+	double rho = 0;
+	for (size_t idx = 0; idx < points_img1.size(); ++idx)
+	{
+		const cv::Point2f& p1 = points_img1[idx];
+		const cv::Point2f& p2 = points_img2[idx];
+		float w = h[6] * p1.x + h[7] * p1.y + h[8];
+		float dx = (h[0] * p1.x + h[1] * p1.y + h[2]) / w - p2.x;
+		float dy = (h[3] * p1.x + h[4] * p1.y + h[5]) / w - p2.y;
+		double e2 = (dx * dx + dy * dy) / (sigma * sigma);
+		rho += (e2 < lambda3 * (r - d)) ? e2 : lambda3 * (r - d);	//wΪ0ʱe2ΪNaN
+	}
+	return rho + lambda1 * d * n + lambda2 * GetMotionDoF(motion_model);
+}
+
+//Զѡ˶ģͣƽơơģRANSACȽGRIC
+//ɷڵϵĵӦGRIC(ģȫʧ)ʱĵӦRANSACѡеģ
+int SelectMotionModel(
+	std::vector<cv::Point2f>& points_img1,
+	std::vector<cv::Point2f>& points_img2,
+	cv::Mat& best_matrix_H,
+	std::vector<size_t>& best_inliers,
+	const float& threshold,
+	const size_t& max_iterations,
+	const float& confidence,
+	const float& sigma,
+	size_t& total_iterations
+)
+{
+	int best_model = MOTIONMODE_HOMOGRAPHY;
+	double best_gric = std::numeric_limits<double>::max();
+	cv::Mat matrix_H;
+	std::vector<size_t> current_inliers, affine_inliers;
+	total_iterations = 0;
+	best_inliers.clear();
+	best_matrix_H.release();
+
+	for (int model = MOTIONMODE_TRANSLATION; model <= MOTIONMODE_AFFINE; model++)
+	{
+		total_iterations += GetMotionRANSAC(points_img1, points_img2, model, GetMotionSampleSize(model), matrix_H,
+			current_inliers, threshold, max_iterations, confidence);
+		if (matrix_H.empty())
+			continue;
+		double gric = CalculateGRIC(points_img1, points_img2, matrix_H, model, sigma);
+		MOSAIC_LOG_DEBUG("Motion model " << model << " inliers: " << current_inliers.size() << " GRIC: " << gric);
+		if (model == MOTIONMODE_AFFINE)
+			affine_inliers = current_inliers;
+		if (gric < best_gric)
+		{
+			best_gric = gric;
+			best_model = model;
+			best_matrix_H = matrix_H.clone();
+			best_inliers.swap(current_inliers);
+		}
+	}
+
+	bool promote = best_matrix_H.empty();
+	if (!promote && affine_inliers.size() >= GetMotionSampleSize(MOTIONMODE_HOMOGRAPHY))
+	{
+		matrix_H = CalculateHomographyMatrix(points_img1, points_img2, affine_inliers);
+		double gric = CalculateGRIC(points_img1, points_img2, matrix_H, MOTIONMODE_HOMOGRAPHY, sigma);
+		MOSAIC_LOG_DEBUG("Motion model " << MOTIONMODE_HOMOGRAPHY << " (affine inliers) GRIC: " << gric);
+		promote = gric < best_gric;
+	}
+	if (promote)
+	{
+		total_iterations += GetMotionRANSAC(points_img1, points_img2, MOTIONMODE_HOMOGRAPHY,
+			GetMotionSampleSize(MOTIONMODE_HOMOGRAPHY), best_matrix_H, best_inliers, threshold, max_iterations, confidence);
+		best_model = MOTIONMODE_HOMOGRAPHY;
 	}
-	best_matrix_H = CalculateHomographyMatrix(points_img1, points_img2,
-		best_inliers);	//ڼϼӦhomo
+	return best_model;
 }
 
 //HomoǷȷ
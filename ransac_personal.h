@@ -1,11 +1,8 @@
 #pragma once
 #pragma once
 #include <vector>
-#include <opencv2/features2d.hpp>
 #include <opencv2/core.hpp>
-#include <opencv2/opencv.hpp>
-#include <opencv2/highgui/highgui.hpp>
-#include <opencv2/imgproc/imgproc.hpp>
+#include <opencv2/calib3d.hpp>
 #include <time.h>
 #include <iostream>
 
@@ -54,17 +51,60 @@ void CalculateInliers(
 	std::vector<size_t>& current_inliers
 );
 
-void GetHomographyRANSAC(
+size_t GetHomographyRANSAC(
 	std::vector<cv::Point2f>& points_img1,
 	std::vector<cv::Point2f>& points_img2,
 	const size_t& k_sample_size,
 	cv::Mat& best_matrix_H,
-	std::vector<size_t> best_inliers_idx,
+	std::vector<size_t>& best_inliers_idx,
 	const float& threshold,
 	const size_t& n_iterations,
 	const float& confidence
 );
 
+size_t GetMotionSampleSize(const int& motion_model);
+
+size_t GetMotionDoF(const int& motion_model);
+
+cv::Mat CalculateMotionMatrix(
+	std::vector<cv::Point2f>& points_img1,
+	std::vector<cv::Point2f>& points_img2,
+	std::vector<size_t>& indices,
+	const int& motion_model
+);
+
+size_t GetMotionRANSAC(
+	std::vector<cv::Point2f>& points_img1,
+	std::vector<cv::Point2f>& points_img2,
+	const int& motion_model,
+	const size_t& k_sample_size,
+	cv::Mat& best_matrix_H,
+	std::vector<size_t>& best_inliers_idx,
+	const float& threshold,
+	const size_t& n_iterations,
+	const float& confidence
+);
+
+double CalculateGRIC(
+	std::vector<cv::Point2f>& points_img1,
+	std::vector<cv::Point2f>& points_img2,
+	cv::Mat& matrix_H,
+	const int& motion_model,
+	const float& sigma
+);
+
+int SelectMotionModel(
+	std::vector<cv::Point2f>& points_img1,
+	std::vector<cv::Point2f>& points_img2,
+	cv::Mat& best_matrix_H,
+	std::vector<size_t>& best_inliers_idx,
+	const float& threshold,
+	const size_t& n_iterations,
+	const float& confidence,
+	const float& sigma,
+	size_t& total_iterations
+);
+
 void checkHomographyCorrectness(
 	std::vector<cv::Point2f>& normalized_points_img1,
 	std::vector<cv::Point2f>& normalized_points_img2,
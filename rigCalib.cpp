@@ -0,0 +1,284 @@
+/*******************************************************************************
+ *
+ * \file    rigCalib.cpp
+ * \brief   ̶λ궨һα궨Ӧ̣ʱƯƼ
+ * \author  agent
+ * \version 1.0
+ * \date    2026-10-19
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * -----------------------------------------------------------------------------
+ * ļ޸ʷ
+ * <ʱ>       | <汾>  | <>         |
+ * 2026-10-19  | v1.0    | agent          |
+ * -----------------------------------------------------------------------------
+ ******************************************************************************/
+#include "rigCalib.h"
+
+/*===================================================================================*/
+/******************************* к *********************************************/
+/*===================================================================================*/
+
+/*
+ * @breif:캯
+ * @prama[in]:checkInterval->ƯƼ(֡); driftThresh->¹ƵͶӰ
+ */
+rigCalib::rigCalib(int checkInterval, double driftThresh)
+{
+	rigCalib::checkInterval = checkInterval;
+	rigCalib::driftThresh = driftThresh;
+}
+
+/*
+ * @breif:һ֡궨,ͬһƴӶԵĶ֡ƥܺͳһ
+ * @prama[in]:pairIdx->ƴӶ; ptLeft,ptRight->ƥ; imgSize->ͼߴ
+ * @retval:None
+ */
+void rigCalib::addCalibFrame(int pairIdx, const vector<Point2f>& ptLeft, const vector<Point2f>& ptRight, Size imgSize)
+{
+	rigCalib::reservePair(pairIdx);
+	rigCalib::calibPtLeft[pairIdx].insert(rigCalib::calibPtLeft[pairIdx].end(), ptLeft.begin(), ptLeft.end());
+	rigCalib::calibPtRight[pairIdx].insert(rigCalib::calibPtRight[pairIdx].end(), ptRight.begin(), ptRight.end());
+	rigCalib::pairs[pairIdx].imgSize = imgSize;
+}
+
+/*
+ * @breif:ɻܵƥƵӦ,ڵ㷴ϸ,ͬʱ㻭߽
+ * @prama[in]:pairIdx->ƴӶ
+ * @retval:true->궨ɹ; false->ƥ㲻
+ */
+bool rigCalib::calibratePair(int pairIdx)
+{
+	size_t inlierNum = 0;
+	if (!rigCalib::fitPair(rigCalib::calibPtLeft[pairIdx], rigCalib::calibPtRight[pairIdx], rigCalib::pairs[pairIdx], inlierNum))
+	{
+		MOSAIC_LOG_ERROR("rigCalib::calibratePair ƥ㲻޿ģ:" << pairIdx);
+		return false;
+	}
+	MOSAIC_LOG_INFO("rigCalib::calibratePair " << pairIdx << " ڵ:" << inlierNum << "/" << rigCalib::calibPtLeft[pairIdx].size()
+		<< " ͶӰλ:" << rigCalib::pairs[pairIdx].refError);
+	return true;
+}
+
+/*
+ * @breif:µƥ¹ĳһƴӶ(Ưƺ),ģ͵ͶӰԭ궨
+ *        (RIGCALIB_MINERROR)ʱ滻,ͬʱƥ滻ܵı궨;ԭģ궨
+ * @prama[in]:pairIdx->ƴӶ; ptLeft,ptRight->ƥ; imgSize->ͼߴ
+ * @retval:true->滻Ϊģ; false->ʧܻģ͸
+ */
+bool rigCalib::updatePair(int pairIdx, const vector<Point2f>& ptLeft, const vector<Point2f>& ptRight, Size imgSize)
+{
+	rigCalib::reservePair(pairIdx);
+	pair_calib& calib = rigCalib::pairs[pairIdx];
+	pair_calib candidate;
+	candidate.imgSize = imgSize;
+	size_t inlierNum = 0;
+	vector<Point2f> fitLeft = ptLeft, fitRight = ptRight;
+	if (!rigCalib::fitPair(fitLeft, fitRight, candidate, inlierNum))
+	{
+		MOSAIC_LOG_WARN("rigCalib::updatePair ¹ʧ,ԭ궨:" << pairIdx);
+		return false;
+	}
+	if (!calib.H.empty() && candidate.refError > max(calib.refError, RIGCALIB_MINERROR))
+	{
+		MOSAIC_LOG_WARN("rigCalib::updatePair " << pairIdx << " ģ" << candidate.refError << "ڱ궨"
+			<< calib.refError << ",ԭ궨");
+		return false;
+	}
+	calib = candidate;
+	rigCalib::calibPtLeft[pairIdx].swap(fitLeft);
+	rigCalib::calibPtRight[pairIdx].swap(fitRight);
+	MOSAIC_LOG_INFO("rigCalib::updatePair " << pairIdx << " ڵ:" << inlierNum << "/" << ptLeft.size()
+		<< " ͶӰλ:" << calib.refError);
+	return true;
+}
+
+/*
+ * @breif:桢ȡ궨ļ(YAML),Ӧ뻭߽
+ * @prama[in]:fileName->궨ļ·
+ * @retval:true->ɹ; false->ʧ
+ */
+bool rigCalib::save(string fileName)
+{
+	// ڴYAMLдļ,FileStorageдʧʱ޴ӵ֪
+	FileStorage fs(".yml", FileStorage::WRITE | FileStorage::MEMORY | FileStorage::FORMAT_YAML);
+	if (!fs.isOpened())	return false;
+
+	fs << "pairs" << "[";
+	for (const pair_calib& calib : rigCalib::pairs)
+	{
+		fs << "{" << "H" << calib.H << "imgSize" << calib.imgSize << "mapSize" << calib.mapSize
+			<< "leftBound" << calib.leftBound << "refError" << calib.refError << "}";
+	}
+	fs << "]";
+	string content = fs.releaseAndGetString();
+
+	ofstream file(fileName, ios::binary);
+	if (!file.is_open())
+	{
+		MOSAIC_LOG_ERROR("rigCalib::save ޷궨ļ:" << fileName);
+		return false;
+	}
+	file.write(content.data(), content.size());
+	file.close();
+	if (file.fail())
+	{
+		MOSAIC_LOG_ERROR("rigCalib::save д궨ļʧ:" << fileName);
+		return false;
+	}
+	return true;
+}
+
+bool rigCalib::load(string fileName)
+{
+	FileStorage fs(fileName, FileStorage::READ);
+	if (!fs.isOpened())	return false;
+
+	FileNode pairsNode = fs["pairs"];
+	rigCalib::pairs.assign(pairsNode.size(), pair_calib());
+	rigCalib::mapCaches.assign(pairsNode.size(), warpMapCache());
+	for (size_t i = 0; i < rigCalib::mapCaches.size(); i++)	rigCalib::mapCaches[i].tag = "pair" + to_string(i);
+	rigCalib::workspaces.assign(pairsNode.size(), mosaicWorkspace());
+	rigCalib::calibPtLeft.assign(pairsNode.size(), vector<Point2f>());
+	rigCalib::calibPtRight.assign(pairsNode.size(), vector<Point2f>());
+	for (int i = 0; i < (int)pairsNode.size(); i++)
+	{
+		FileNode node = pairsNode[i];
+		node["H"] >> rigCalib::pairs[i].H;
+		node["imgSize"] >> rigCalib::pairs[i].imgSize;
+		node["mapSize"] >> rigCalib::pairs[i].mapSize;
+		node["leftBound"] >> rigCalib::pairs[i].leftBound;
+		node["refError"] >> rigCalib::pairs[i].refError;
+	}
+	return !rigCalib::pairs.empty();
+}
+
+/*
+ * @breif:ǰ֡ǷҪƯƼ
+ * @prama[in]:frameIdx->֡
+ * @retval:true->Ҫ
+ */
+bool rigCalib::needCheck(int frameIdx)
+{
+	return rigCalib::checkInterval > 0 && frameIdx % rigCalib::checkInterval == 0;
+}
+
+/*
+ * @breif:ϡƯƼ,㵱ǰ֡ƥڱ궨ӦµͶӰλ
+ * @prama[in]:pairIdx->ƴӶ; leftImg,rightImg->ǰ֡ͼ
+ * @retval:ͶӰλ .pix, ƥ㲻ʱRIGCALIB_LOST
+ */
+double rigCalib::checkDrift(int pairIdx, Mat& leftImg, Mat& rightImg)
+{
+	Mat grayImgLeft, grayImgRight, imgDescLeft, imgDescRight;
+	vector<KeyPoint> keyPtLeft, keyPtRight;
+	cvtColor(leftImg, grayImgLeft, COLOR_RGB2GRAY);
+	cvtColor(rightImg, grayImgRight, COLOR_RGB2GRAY);
+	Ptr<ORB> OrbFeature = ORB::create(RIGCALIB_FEATURES);
+	OrbFeature->detectAndCompute(grayImgLeft, Mat(), keyPtLeft, imgDescLeft);
+	OrbFeature->detectAndCompute(grayImgRight, Mat(), keyPtRight, imgDescRight);
+	if (imgDescLeft.rows < 2 || imgDescRight.rows < 2)	return RIGCALIB_LOST;
+
+	featureMatch featureMatchHandle;
+	vector<Point2f> goodPtLeft, goodPtRight, projRight;
+	vector<DMatch> goodMatchPt = featureMatchHandle.featureMatch_MinMax(imgDescLeft, imgDescRight, 2.4, MATCHMODE_HAMMING);
+	featureMatchHandle.getGoodPt(goodMatchPt, keyPtRight, keyPtLeft, goodPtRight, goodPtLeft);
+	if (goodPtLeft.size() < RIGCALIB_MINMATCH)	return RIGCALIB_LOST;
+
+	perspectiveTransform(goodPtRight, projRight, rigCalib::pairs[pairIdx].H);
+	vector<double> errors(projRight.size());
+	for (size_t i = 0; i < projRight.size(); i++)	errors[i] = norm(projRight[i] - goodPtLeft[i]);
+	nth_element(errors.begin(), errors.begin() + errors.size() / 2, errors.end());
+	return errors[errors.size() / 2];
+}
+
+/*
+ * @breif:ƯƼǷҪ¹:ƥ㲻,궨(RIGCALIB_MINERROR)driftThresh
+ * @prama[in]:pairIdx->ƴӶ; error->checkDriftķֵ
+ * @retval:true->Ҫ¹
+ */
+bool rigCalib::isDrifted(int pairIdx, double error)
+{
+	if (error < 0)	return true;
+	return error > rigCalib::driftThresh * max(rigCalib::pairs[pairIdx].refError, RIGCALIB_MINERROR);
+}
+/*-----------------------------------------------------------------------------------*/
+
+
+/*===================================================================================*/
+/******************************* ˽к *********************************************/
+/*===================================================================================*/
+
+/*
+ * @breif:֤ƴӶЧ,Ҫʱչ洢
+ * @prama[in]:pairIdx->ƴӶ
+ * @retval:None
+ */
+void rigCalib::reservePair(int pairIdx)
+{
+	if (pairIdx < (int)rigCalib::pairs.size())	return;
+	int oldNum = (int)rigCalib::pairs.size();
+	rigCalib::pairs.resize(pairIdx + 1, pair_calib());
+	rigCalib::mapCaches.resize(pairIdx + 1);
+	for (int i = oldNum; i <= pairIdx; i++)	rigCalib::mapCaches[i].tag = "pair" + to_string(i);
+	rigCalib::workspaces.resize(pairIdx + 1);
+	rigCalib::calibPtLeft.resize(pairIdx + 1);
+	rigCalib::calibPtRight.resize(pairIdx + 1);
+}
+
+/*
+ * @breif:ƥƵӦڵ㷴,㻭߽HڵͶӰλ
+ * @prama[in]:ptLeft,ptRight->ƥ; calib->imgSizeΪ,Ϊı궨
+ * @prama[in]:inlierNum->Hڵ
+ * @retval:true->Ƴɹ; false->ƥ㲻RANSAC޿ģ
+ */
+bool rigCalib::fitPair(vector<Point2f>& ptLeft, vector<Point2f>& ptRight, pair_calib& calib, size_t& inlierNum)
+{
+	inlierNum = 0;
+	if (ptLeft.size() < 4)	return false;
+
+	// RANSACֹ,ͼΪ׼,ͼӳ䵽ͼ;޿ģʱHΪ
+	homoEst homographyMap(ptRight, ptLeft, calib.imgSize);
+	homographyMap.findHomography_Base();
+	if (homographyMap.H.empty() || homographyMap.inlierNum < 4)	return false;
+
+	// ȫڵ㷴
+	Mat H_32;
+	vector<size_t> inliers;
+	homographyMap.H.convertTo(H_32, CV_32F);
+	for (int k = 0; k < RIGCALIB_REFINE; k++)
+	{
+		CalculateInliers(ptRight, ptLeft, H_32, RIGCALIB_THRESH, inliers);
+		if (inliers.size() < 4)	break;
+		H_32 = CalculateHomographyMatrix(ptRight, ptLeft, inliers);
+	}
+	H_32.convertTo(homographyMap.H, CV_64F);
+	homographyMap.calTransBound();
+
+	// HڵͶӰλ,checkDriftͳһ
+	CalculateInliers(ptRight, ptLeft, H_32, RIGCALIB_THRESH, inliers);
+	inlierNum = inliers.size();
+	if (inlierNum < 4)	return false;
+	vector<Point2f> inlierRight, inlierLeft, projRight;
+	for (size_t idx : inliers)
+	{
+		inlierRight.push_back(ptRight[idx]);
+		inlierLeft.push_back(ptLeft[idx]);
+	}
+	calib.refError = 0;
+	if (!inlierRight.empty())
+	{
+		perspectiveTransform(inlierRight, projRight, homographyMap.H);
+		vector<double> errors(projRight.size());
+		for (size_t i = 0; i < projRight.size(); i++)	errors[i] = norm(projRight[i] - inlierLeft[i]);
+		nth_element(errors.begin(), errors.begin() + errors.size() / 2, errors.end());
+		calib.refError = errors[errors.size() / 2];
+	}
+
+	calib.H = homographyMap.H.clone();
+	calib.mapSize = Size(homographyMap.rightBound, calib.imgSize.height);
+	calib.leftBound = homographyMap.leftBound;
+	return true;
+}
+/*-----------------------------------------------------------------------------------*/
@@ -0,0 +1,142 @@
+/*******************************************************************************
+ *
+ * \file    rigCalib.h
+ * \brief   ̶λ궨һα궨Ӧ̣ʱƯƼ
+ * \author  agent
+ * \version 1.0
+ * \date    2026-10-19
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * -----------------------------------------------------------------------------
+ * ļ޸ʷ
+ * <ʱ>       | <汾>  | <>         |
+ * 2026-10-19  | v1.0    | agent          |
+ * -----------------------------------------------------------------------------
+ ******************************************************************************/
+#include <opencv2/imgproc/imgproc.hpp>
+#include <opencv2/features2d.hpp>
+#include "publicElement.h"
+#include "homoEstimation.h"
+#include "featureMatch.h"
+#include "warpMapCache.h"
+#include "mosaicWorkspace.h"
+#include <iostream>
+#include <fstream>
+#include <algorithm>
+using namespace cv;
+using namespace std;
+
+/*===================================================================================*/
+/******************************** 궨 *********************************************/
+/*===================================================================================*/
+#define RIGCALIB_INTERVAL		   30							// ƯƼ .֡
+#define RIGCALIB_DRIFT			  2.0							// ¹ƵͶӰ(Ա궨)
+#define RIGCALIB_MINERROR		  0.5							// 궨,궨Сʱ΢ .pix
+#define RIGCALIB_MINMATCH		    8							// ƯƼƥ
+#define RIGCALIB_LOST			 -1.0							// ƯƼƥ㲻(ʧȥ׼)ʱķֵ
+#define RIGCALIB_FEATURES		  300							// ƯƼʹõϡ
+#define RIGCALIB_THRESH			    3							// 궨ʱڵжֵ .pix
+#define RIGCALIB_REFINE			    3							// 궨ʱڵϴ
+/*-----------------------------------------------------------------------------------*/
+
+#pragma once
+#ifndef RIGCALIB_H
+#define RIGCALIB_H
+
+class rigCalib
+{
+public:
+	typedef struct
+	{
+		Mat H;										// ͼͼĵӦ
+		Size imgSize;								// ͼߴ
+		Size mapSize;								// ӳͼƬ()С
+		int leftBound = 0;							// Ӧ任ͼ߽
+		double refError = 0;						// 궨ʱHڵͶӰλ .pix
+	}pair_calib;
+
+	vector<pair_calib> pairs;						// ƴӶԵı궨,˳ƴӵ˳һ
+	vector<warpMapCache> mapCaches;					// ƴӶԵӳ
+	vector<mosaicWorkspace> workspaces;				// ƴӶԵƴӹ,֡ӳͼ
+	int checkInterval;								// ƯƼ .֡
+	double driftThresh;								// Ưֵ,ͶӰԱ궨
+
+public:
+	/*
+	 * @breif:캯
+	 * @prama[in]:checkInterval->ƯƼ(֡); driftThresh->¹ƵͶӰ
+	 */
+	rigCalib(int checkInterval = RIGCALIB_INTERVAL, double driftThresh = RIGCALIB_DRIFT);
+
+	/*
+	 * @breif:һ֡궨,ͬһƴӶԵĶ֡ƥܺͳһ
+	 * @prama[in]:pairIdx->ƴӶ; ptLeft,ptRight->ƥ; imgSize->ͼߴ
+	 * @retval:None
+	 */
+	void addCalibFrame(int pairIdx, const vector<Point2f>& ptLeft, const vector<Point2f>& ptRight, Size imgSize);
+
+	/*
+	 * @breif:ɻܵƥƵӦ,ڵ㷴ϸ,ͬʱ㻭߽
+	 * @prama[in]:pairIdx->ƴӶ
+	 * @retval:true->궨ɹ; false->ƥ㲻ƲӦ
+	 */
+	bool calibratePair(int pairIdx);
+
+	/*
+	 * @breif:µƥ¹ĳһƴӶ(Ưƺ),ģ͵ͶӰԭ궨
+	 *        (RIGCALIB_MINERROR)ʱ滻,ͬʱƥ滻ܵı궨;ԭģ궨
+	 * @prama[in]:pairIdx->ƴӶ; ptLeft,ptRight->ƥ; imgSize->ͼߴ
+	 * @retval:true->滻Ϊģ; false->ʧܻģ͸
+	 */
+	bool updatePair(int pairIdx, const vector<Point2f>& ptLeft, const vector<Point2f>& ptRight, Size imgSize);
+
+	/*
+	 * @breif:桢ȡ궨ļ(YAML),Ӧ뻭߽
+	 * @prama[in]:fileName->궨ļ·
+	 * @retval:true->ɹ; false->ʧ
+	 */
+	bool save(string fileName);
+	bool load(string fileName);
+
+	/*
+	 * @breif:ǰ֡ǷҪƯƼ
+	 * @prama[in]:frameIdx->֡
+	 * @retval:true->Ҫ
+	 */
+	bool needCheck(int frameIdx);
+
+	/*
+	 * @breif:ϡƯƼ,㵱ǰ֡ƥڱ궨ӦµͶӰλ
+	 * @prama[in]:pairIdx->ƴӶ; leftImg,rightImg->ǰ֡ͼ
+	 * @retval:ͶӰλ .pix, ƥ㲻ʱRIGCALIB_LOST
+	 */
+	double checkDrift(int pairIdx, Mat& leftImg, Mat& rightImg);
+
+	/*
+	 * @breif:ƯƼǷҪ¹:ƥ㲻,궨(RIGCALIB_MINERROR)driftThresh
+	 * @prama[in]:pairIdx->ƴӶ; error->checkDriftķֵ
+	 * @retval:true->Ҫ¹
+	 */
+	bool isDrifted(int pairIdx, double error);
+
+private:
+	vector<vector<Point2f>> calibPtLeft, calibPtRight;	// ܵı궨ƥ
+
+	/*
+	 * @breif:ƥƵӦڵ㷴,㻭߽HڵͶӰλ
+	 * @prama[in]:ptLeft,ptRight->ƥ; calib->imgSizeΪ,Ϊı궨
+	 * @prama[in]:inlierNum->Hڵ
+	 * @retval:true->Ƴɹ; false->ƥ㲻RANSAC޿ģ
+	 */
+	static bool fitPair(vector<Point2f>& ptLeft, vector<Point2f>& ptRight, pair_calib& calib, size_t& inlierNum);
+
+	/*
+	 * @breif:֤ƴӶЧ,Ҫʱչ洢
+	 * @prama[in]:pairIdx->ƴӶ
+	 * @retval:None
+	 */
+	void reservePair(int pairIdx);
+};
+
+#endif // !RIGCALIB_H
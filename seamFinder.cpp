@@ -0,0 +1,182 @@
+/*******************************************************************************
+ *
+ * \file    seamFinder.cpp
+ * \brief   ƴӷصԶ̬滮ͼСƴӷ
+ * \author  agent
+ * \version 1.0
+ * \date    2026-10-19
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * -----------------------------------------------------------------------------
+ * ļ޸ʷ
+ * <ʱ>       | <汾>  | <>         |
+ * 2026-10-19  | v1.0    | agent          |
+ * -----------------------------------------------------------------------------
+ ******************************************************************************/
+#include "seamFinder.h"
+#include <opencv2/stitching/detail/seam_finders.hpp>
+
+/*===================================================================================*/
+/******************************* к *********************************************/
+/*===================================================================================*/
+
+/*
+ * @breif:캯
+ * @prama[in]:seamMode->ƴӷģʽ; scale->ͼ²
+ */
+seamFinder::seamFinder(int seamMode, int scale)
+{
+	seamFinder::seamMode = seamMode;
+	seamFinder::scale = cmpMax(scale, 1);
+}
+
+/*
+ * @breif:ص[start,end)ƴӷ
+ * @prama[in]:leftImg->ƴͼ; rightImg->ӳ䵽ͼϵͼ; rightMask->ͼЧ
+ * @prama[in]:start,end->صұ߽
+ * @retval:seamMask->صС(CV_8UC1),255ʾȡͼ,0ʾȡͼ
+ */
+Mat seamFinder::findSeam(const Mat& leftImg, const Mat& rightImg, const validMask& rightMask, int start, int end)
+{
+	start = cmpMax(start, 0);
+	end = cmpMin(end, cmpMin(leftImg.cols, rightImg.cols));
+	Mat seamMask(leftImg.rows, cmpMax(end - start, 0), CV_8UC1, Scalar(255));
+	if (end - start < 2)	return seamMask;
+
+	// ֻصڡ²
+	int bandRows = cmpMin(leftImg.rows, rightImg.rows);
+	int bandCols = end - start;
+	Size smallSize((bandCols + seamFinder::scale - 1) / seamFinder::scale, (bandRows + seamFinder::scale - 1) / seamFinder::scale);
+	Mat leftBand, rightBand;
+	resize(leftImg(Rect(start, 0, bandCols, bandRows)), leftBand, smallSize, 0, 0, INTER_AREA);
+	resize(rightImg(Rect(start, 0, bandCols, bandRows)), rightBand, smallSize, 0, 0, INTER_AREA);
+
+	// ͼЧֻչص,²ȡֵΪ255(ӦԭͼȫЧ)ΪЧ
+	Mat validMat(bandRows, bandCols, CV_8UC1, Scalar(0)), validBand;
+	for (int i = 0; i < bandRows; i++)
+	{
+		const validMask::row_run* rowRun = rightMask.rowRuns(i);
+		for (int r = 0; r < rightMask.runNum(i); r++)
+		{
+			int begin = cmpMax(rowRun[r].begin, start), runEnd = cmpMin(rowRun[r].end, end);
+			if (begin < runEnd)	validMat(Rect(begin - start, i, runEnd - begin, 1)).setTo(255);
+		}
+	}
+	resize(validMat, validBand, smallSize, 0, 0, INTER_AREA);
+
+	if (seamFinder::seamMode == SEAMMODE_GRAPHCUT)
+	{
+		Mat smallMask = seamFinder::findSeam_GraphCut(leftBand, rightBand, validBand), bandMask;
+		resize(smallMask, bandMask, Size(bandCols, bandRows), 0, 0, INTER_NEAREST);
+		bandMask.copyTo(seamMask(Rect(0, 0, bandCols, bandRows)));
+		return seamMask;
+	}
+
+	// ̬滮ƴӷϲ,мԲֵʹƴӷƽ
+	vector<int> seamCol = seamFinder::findSeam_DP(seamFinder::calSeamCost(leftBand, rightBand, validBand));
+	for (int i = 0; i < bandRows; i++)
+	{
+		float fy = (i + 0.5f) / seamFinder::scale - 0.5f;
+		int y0 = cmpMin(cmpMax((int)floor(fy), 0), smallSize.height - 1);
+		int y1 = cmpMin(y0 + 1, smallSize.height - 1);
+		float t = min(max(fy - y0, 0.0f), 1.0f);
+		float col = seamCol[y0] * (1 - t) + seamCol[y1] * t;
+		int x = cmpMin(cmpMax((int)((col + 0.5f) * seamFinder::scale), 0), bandCols);
+		seamMask(Rect(x, i, bandCols - x, 1)).setTo(0);
+	}
+	return seamMask;
+}
+/*-----------------------------------------------------------------------------------*/
+
+
+/*===================================================================================*/
+/******************************* ˽к *********************************************/
+/*===================================================================================*/
+
+/*
+ * @breif:²Ĵͼ,ͼɫ,ͼشۼ
+ * @prama[in]:leftBand,rightBand->صڵͼ(²); validBand->ͼЧ(²,255ΪЧ)
+ * @retval:cost->ͼ(CV_32FC1)
+ */
+Mat seamFinder::calSeamCost(const Mat& leftBand, const Mat& rightBand, const Mat& validBand)
+{
+	Mat cost(leftBand.rows, leftBand.cols, CV_32FC1);
+	for (int i = 0; i < leftBand.rows; i++)
+	{
+		const uchar* rowAddrLeft = leftBand.ptr<uchar>(i);
+		const uchar* rowAddrRight = rightBand.ptr<uchar>(i);
+		const uchar* rowAddrValid = validBand.ptr<uchar>(i);
+		float* rowAddrCost = cost.ptr<float>(i);
+		for (int j = 0; j < leftBand.cols; j++)
+		{
+			const uchar* l = rowAddrLeft + j * 3;
+			const uchar* r = rowAddrRight + j * 3;
+			if (rowAddrValid[j] != 255)
+			{
+				rowAddrCost[j] = SEAM_INVALIDCOST;
+				continue;
+			}
+			float db = (float)l[0] - r[0], dg = (float)l[1] - r[1], dr = (float)l[2] - r[2];
+			rowAddrCost[j] = db * db + dg * dg + dr * dr;
+		}
+	}
+	return cost;
+}
+
+/*
+ * @breif:̬滮Сֱƴӷ
+ * @prama[in]:cost->ͼ
+ * @retval:seamCol->ÿƴӷ
+ */
+vector<int> seamFinder::findSeam_DP(const Mat& cost)
+{
+	int rows = cost.rows, cols = cost.cols;
+	Mat energy = cost.clone();						// Сۼƴ
+	Mat path(rows, cols, CV_8SC1);					// ݷ:-101
+	for (int i = 1; i < rows; i++)
+	{
+		const float* rowAddrPrev = energy.ptr<float>(i - 1);
+		float* rowAddrCur = energy.ptr<float>(i);
+		schar* rowAddrPath = path.ptr<schar>(i);
+		for (int j = 0; j < cols; j++)
+		{
+			int best = 0;
+			float minEnergy = rowAddrPrev[j];
+			if (j > 0 && rowAddrPrev[j - 1] < minEnergy)			{ minEnergy = rowAddrPrev[j - 1]; best = -1; }
+			if (j < cols - 1 && rowAddrPrev[j + 1] < minEnergy)		{ minEnergy = rowAddrPrev[j + 1]; best = 1; }
+			rowAddrCur[j] += minEnergy;
+			rowAddrPath[j] = (schar)best;
+		}
+	}
+
+	// һеСۼƴ۵
+	vector<int> seamCol(rows);
+	const float* rowAddrLast = energy.ptr<float>(rows - 1);
+	seamCol[rows - 1] = (int)(min_element(rowAddrLast, rowAddrLast + cols) - rowAddrLast);
+	for (int i = rows - 1; i > 0; i--)
+		seamCol[i - 1] = seamCol[i] + path.ptr<schar>(i)[seamCol[i]];
+	return seamCol;
+}
+
+/*
+ * @breif:ͼƴӷ
+ * @prama[in]:leftBand,rightBand->صڵͼ(²); validBand->ͼЧ(²,255ΪЧ)
+ * @retval:seamMask->²С,255ʾȡͼ
+ */
+Mat seamFinder::findSeam_GraphCut(const Mat& leftBand, const Mat& rightBand, const Mat& validBand)
+{
+	Mat leftF, rightF;
+	leftBand.convertTo(leftF, CV_32F);
+	rightBand.convertTo(rightF, CV_32F);
+	Mat leftMask(leftBand.rows, leftBand.cols, CV_8UC1, Scalar(255));
+	Mat rightMask = validBand == 255;				// ͼشֻȡͼ
+
+	vector<UMat> srcImgs = { leftF.getUMat(ACCESS_READ), rightF.getUMat(ACCESS_READ) };
+	vector<UMat> masks = { leftMask.getUMat(ACCESS_RW), rightMask.getUMat(ACCESS_RW) };
+	vector<Point> corners = { Point(0, 0), Point(0, 0) };
+	detail::GraphCutSeamFinder graphCut(detail::GraphCutSeamFinderBase::COST_COLOR);
+	graphCut.find(srcImgs, corners, masks);
+	return masks[0].getMat(ACCESS_READ).clone();
+}
+/*-----------------------------------------------------------------------------------*/
@@ -0,0 +1,79 @@
+/*******************************************************************************
+ *
+ * \file    seamFinder.h
+ * \brief   ƴӷصԶ̬滮ͼСƴӷ
+ * \author  agent
+ * \version 1.0
+ * \date    2026-10-19
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * -----------------------------------------------------------------------------
+ * ļ޸ʷ
+ * <ʱ>       | <汾>  | <>         |
+ * 2026-10-19  | v1.0    | agent          |
+ * -----------------------------------------------------------------------------
+ ******************************************************************************/
+#include <opencv2/imgproc/imgproc.hpp>
+#include "publicElement.h"
+#include "validMask.h"
+#include <iostream>
+using namespace cv;
+using namespace std;
+
+/*===================================================================================*/
+/******************************** 궨 *********************************************/
+/*===================================================================================*/
+#define SEAM_SCALE					4							// ͼ²
+#define SEAM_INVALIDCOST		  1e6f							// ͼشĴ
+/*-----------------------------------------------------------------------------------*/
+
+#pragma once
+#ifndef SEAMFINDER_H
+#define SEAMFINDER_H
+
+class seamFinder
+{
+public:
+	int seamMode;									// ƴӷģʽ,SEAMMODE_DPSEAMMODE_GRAPHCUT
+	int scale;										// ͼ²
+
+public:
+	/*
+	 * @breif:캯
+	 * @prama[in]:seamMode->ƴӷģʽ; scale->ͼ²
+	 */
+	seamFinder(int seamMode = SEAMMODE_DP, int scale = SEAM_SCALE);
+
+	/*
+	 * @breif:ص[start,end)ƴӷ
+	 * @prama[in]:leftImg->ƴͼ; rightImg->ӳ䵽ͼϵͼ; rightMask->ͼЧ
+	 * @prama[in]:start,end->صұ߽
+	 * @retval:seamMask->صС(CV_8UC1),255ʾȡͼ,0ʾȡͼ
+	 */
+	Mat findSeam(const Mat& leftImg, const Mat& rightImg, const validMask& rightMask, int start, int end);
+
+private:
+	/*
+	 * @breif:²Ĵͼ,ͼɫ,ͼشۼ
+	 * @prama[in]:leftBand,rightBand->صڵͼ(²); validBand->ͼЧ(²,255ΪЧ)
+	 * @retval:cost->ͼ(CV_32FC1)
+	 */
+	Mat calSeamCost(const Mat& leftBand, const Mat& rightBand, const Mat& validBand);
+
+	/*
+	 * @breif:̬滮Сֱƴӷ
+	 * @prama[in]:cost->ͼ
+	 * @retval:seamCol->ÿƴӷ
+	 */
+	vector<int> findSeam_DP(const Mat& cost);
+
+	/*
+	 * @breif:ͼƴӷ
+	 * @prama[in]:leftBand,rightBand->صڵͼ(²); validBand->ͼЧ(²,255ΪЧ)
+	 * @retval:seamMask->²С,255ʾȡͼ
+	 */
+	Mat findSeam_GraphCut(const Mat& leftBand, const Mat& rightBand, const Mat& validBand);
+};
+
+#endif // !SEAMFINDER_H
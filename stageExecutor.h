@@ -0,0 +1,274 @@
+/*******************************************************************************
+ *
+ * \file    stageExecutor.h
+ * \brief   ּˮִɶĹִ߳Ун˳
+ * \author  agent
+ * \version 1.0
+ * \date    2026-10-19
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * -----------------------------------------------------------------------------
+ * ļ޸ʷ
+ * <ʱ>       | <汾>  | <>         |
+ * 2026-10-19  | v1.0    | agent          |
+ * -----------------------------------------------------------------------------
+ ******************************************************************************/
+#include <opencv2/core.hpp>
+#include <iostream>
+#include <vector>
+#include <map>
+#include <string>
+#include <functional>
+#include <exception>
+#include <mutex>
+#include "publicElement.h"
+#include "boundedQueue.h"
+using namespace std;
+
+/*===================================================================================*/
+/******************************** 궨 *********************************************/
+/*===================================================================================*/
+#define EXECUTOR_QUEUEDEPTH			4							// Ĭϼ
+/*-----------------------------------------------------------------------------------*/
+
+#pragma once
+#ifndef STAGEEXECUTOR_H
+#define STAGEEXECUTOR_H
+
+/*
+ * Դ,;ĳʧܵ,԰Ž
+ * ʱ,;֮߳,̬ȡһ
+ */
+template<class Job>
+class stageExecutor
+{
+public:
+	typedef function<bool(Job&, string&)> stage_func;				// һ,ʧʱfalseдϢ
+	typedef function<bool(Job&)> source_func;						// һ,ʱfalse
+	typedef function<void(Job&, const string&)> sink_func;			// ˳,ϢΪձʾɹ
+
+	typedef struct
+	{
+		string name;								// 
+		int workers;								// ߳
+		size_t jobNum;								// 
+		double busyMs;								// ̴߳ʱ֮ .ms
+	}stage_report;
+
+	typedef struct
+	{
+		string name;								// ,"->"
+		typename boundedQueue<int>::queue_stats stats;	// ռͳ
+	}queue_report;
+
+	size_t queueDepth;								// 
+	size_t maxReorder;								// Ż
+	double totalMs;									// һrunܺʱ .ms
+
+public:
+	/*
+	 * @breif:캯
+	 * @prama[in]:queueDepth->
+	 */
+	stageExecutor(size_t queueDepth = EXECUTOR_QUEUEDEPTH)
+	{
+		stageExecutor::queueDepth = queueDepth;
+		stageExecutor::maxReorder = 0;
+		stageExecutor::totalMs = 0;
+	}
+
+	/*
+	 * @breif:׷һ,׷˳
+	 * @prama[in]:name->; workers->߳; func->,̲ͬ߳
+	 * @retval:None
+	 */
+	void addStage(string name, int workers, stage_func func)
+	{
+		stage_info stage;
+		stage.name = name;
+		stage.workers = cmpMax(workers, 1);
+		stage.func = func;
+		stageExecutor::stages.push_back(stage);
+	}
+
+	/*
+	 * @breif:ˮֱԴ;ȫ;Դڶ̵߳,ڵ̵߳
+	 * @prama[in]:source->Դ; sink->
+	 * @retval:
+	 */
+	size_t run(source_func source, sink_func sink)
+	{
+		auto timeBegin = chrono::steady_clock::now();
+		int stageNum = (int)stageExecutor::stages.size();
+		stageExecutor::queues.clear();
+		for (int s = 0; s <= stageNum; s++)
+			stageExecutor::queues.emplace_back(new boundedQueue<slot_ptr>(stageExecutor::queueDepth));
+		stageExecutor::jobNum.assign(stageNum, 0);
+		stageExecutor::busyMs.assign(stageNum, 0);
+		stageExecutor::maxReorder = 0;
+
+		vector<thread> threads;
+		threads.emplace_back([&]()
+		{
+			size_t seq = 0;
+			while (true)
+			{
+				slot_ptr slot(new job_slot());
+				slot->seq = seq;
+				if (!source(slot->job))	break;
+				seq++;
+				if (!stageExecutor::queues[0]->push(slot))	break;
+			}
+			stageExecutor::queues[0]->close();
+		});
+
+		// ÿһ˳̹߳رζ,ȡ֮˳
+		vector<unique_ptr<atomic<int>>> alive;
+		for (int s = 0; s < stageNum; s++)
+		{
+			alive.emplace_back(new atomic<int>(stageExecutor::stages[s].workers));
+			for (int w = 0; w < stageExecutor::stages[s].workers; w++)
+				threads.emplace_back([&, s]()
+				{
+					stageExecutor::stageWorker(s);
+					if (--*alive[s] == 0)	stageExecutor::queues[s + 1]->close();
+				});
+		}
+
+		// ɵݴ,ֱ
+		map<size_t, slot_ptr> reorder;
+		size_t nextSeq = 0;
+		slot_ptr slot;
+		while (stageExecutor::queues[stageNum]->pop(slot))
+		{
+			size_t seq = slot->seq;
+			reorder[seq] = move(slot);
+			stageExecutor::maxReorder = max(stageExecutor::maxReorder, reorder.size());
+			for (auto it = reorder.find(nextSeq); it != reorder.end(); it = reorder.find(++nextSeq))
+			{
+				sink(it->second->job, it->second->errorInfo);
+				reorder.erase(it);
+			}
+		}
+		for (thread& t : threads)	t.join();
+		stageExecutor::totalMs = chrono::duration<double, milli>(chrono::steady_clock::now() - timeBegin).count();
+		return nextSeq;
+	}
+
+	/*
+	 * @breif:һrunĸͳͳ,kΪk,һΪ
+	 * @prama[in]:None
+	 * @retval:ͳƽ
+	 */
+	vector<stage_report> stageReport() const
+	{
+		vector<stage_report> report;
+		for (size_t s = 0; s < stageExecutor::stages.size(); s++)
+		{
+			stage_report item;
+			item.name = stageExecutor::stages[s].name;
+			item.workers = stageExecutor::stages[s].workers;
+			item.jobNum = s < stageExecutor::jobNum.size() ? stageExecutor::jobNum[s] : 0;
+			item.busyMs = s < stageExecutor::busyMs.size() ? stageExecutor::busyMs[s] : 0;
+			report.push_back(item);
+		}
+		return report;
+	}
+	vector<queue_report> queueReport() const
+	{
+		vector<queue_report> report;
+		for (size_t q = 0; q < stageExecutor::queues.size(); q++)
+		{
+			typename boundedQueue<slot_ptr>::queue_stats stats = stageExecutor::queues[q]->getStats();
+			queue_report item;
+			item.name = (q == 0 ? string("Դ") : stageExecutor::stages[q - 1].name) + "->"
+				+ (q < stageExecutor::stages.size() ? stageExecutor::stages[q].name : string(""));
+			item.stats = { stats.capacity, stats.maxOccupancy, stats.meanOccupancy, stats.pushNum, stats.fullWaits,
+				stats.emptyWaits };
+			report.push_back(item);
+		}
+		return report;
+	}
+
+	/*
+	 * @breif:ӡռ;Ϊʱ(ܺʱ*߳),ӽ1ļƿ
+	 * @prama[in]:None
+	 * @retval:None
+	 */
+	void printReport() const
+	{
+		for (const stage_report& stage : stageExecutor::stageReport())
+		{
+			double load = stageExecutor::totalMs > 0 ? stage.busyMs / (stageExecutor::totalMs * stage.workers) : 0;
+			cout << getFormatStr("   %-10s ߳%2d %5d ƽ%8.1fms %5.1f%%", stage.name.c_str(), stage.workers,
+				(int)stage.jobNum, stage.jobNum == 0 ? 0.0 : stage.busyMs / stage.jobNum, load * 100) << endl;
+		}
+		for (const queue_report& queue : stageExecutor::queueReport())
+			cout << getFormatStr("   %-20s %2d ƽռ%5.2f ռ%2d %5d յȴ%5d", queue.name.c_str(),
+				(int)queue.stats.capacity, queue.stats.meanOccupancy, (int)queue.stats.maxOccupancy,
+				(int)queue.stats.fullWaits, (int)queue.stats.emptyWaits) << endl;
+		cout << getFormatStr("  Ż%d", (int)stageExecutor::maxReorder) << endl;
+	}
+
+private:
+	typedef struct
+	{
+		string name;								// 
+		int workers;								// ߳
+		stage_func func;							// 
+	}stage_info;
+
+	typedef struct
+	{
+		size_t seq;									// ˳
+		Job job;									// 
+		string errorInfo;							// Ϣ,ǿʱ
+	}job_slot;
+	typedef unique_ptr<job_slot> slot_ptr;
+
+	vector<stage_info> stages;						// 
+	vector<unique_ptr<boundedQueue<slot_ptr>>> queues;	// ,stages.size()+1
+	vector<size_t> jobNum;							// 
+	vector<double> busyMs;							// ʱ֮ .ms
+	mutex reportMutex;								// ͳд
+
+	/*
+	 * @breif:һеһ߳,ȡ󽻸һ,ιرȡʱ˳
+	 * @prama[in]:s->
+	 * @retval:None
+	 */
+	void stageWorker(int s)
+	{
+		stage_info& stage = stageExecutor::stages[s];
+		size_t localNum = 0;
+		double localMs = 0;
+		slot_ptr slot;
+		while (stageExecutor::queues[s]->pop(slot))
+		{
+			if (slot->errorInfo.empty())
+			{
+				auto timeBegin = chrono::steady_clock::now();
+				bool success = false;
+				try
+				{
+					success = stage.func(slot->job, slot->errorInfo);
+				}
+				// 쳣(ƥ㲻㵼OpenCV)Ӱˮ
+				catch (const exception& e)
+				{
+					slot->errorInfo = e.what();
+				}
+				if (!success && slot->errorInfo.empty())	slot->errorInfo = stage.name + "ʧ";
+				localMs += chrono::duration<double, milli>(chrono::steady_clock::now() - timeBegin).count();
+				localNum++;
+			}
+			if (!stageExecutor::queues[s + 1]->push(slot))	break;
+		}
+		lock_guard<mutex> lock(stageExecutor::reportMutex);
+		stageExecutor::jobNum[s] += localNum;
+		stageExecutor::busyMs[s] += localMs;
+	}
+};
+
+#endif // !STAGEEXECUTOR_H
@@ -0,0 +1,162 @@
+/*******************************************************************************
+ *
+ * \file    synthPano.cpp
+ * \brief   ϳȫݣɳȾNֵӦعصͼ
+ * \author  agent
+ * \version 1.0
+ * \date    2026-10-19
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * -----------------------------------------------------------------------------
+ * ļ޸ʷ
+ * <ʱ>       | <汾>  | <>         |
+ * 2026-10-19  | v1.0    | agent          |
+ * -----------------------------------------------------------------------------
+ ******************************************************************************/
+#include "synthPano.h"
+
+/*===================================================================================*/
+/******************************* к *********************************************/
+/*===================================================================================*/
+
+/*
+ * @breif:캯,ͼ,Դתֱƫơ͸عŶ
+ * @prama[in]:viewSize->ͼߴ;viewNum->ͼ;overlap->ͼˮƽص
+ * @prama[in]:noiseSigma->˹׼;exposure->عŶΧ;seed->
+ */
+synthPano::synthPano(Size viewSize, int viewNum, double overlap, double noiseSigma, double exposure, uint64 seed)
+{
+	synthPano::viewSize = viewSize;
+	synthPano::viewNum = viewNum;
+	synthPano::overlap = overlap;
+	synthPano::noiseSigma = noiseSigma;
+	synthPano::seed = seed;
+
+	// ͼͼΪԭ͸ת,ƽƵȫеλ
+	RNG rng(seed);
+	double step = viewSize.width * (1 - overlap);
+	double cx = viewSize.width * 0.5, cy = viewSize.height * 0.5;
+	Mat toCenter = (Mat_<double>(3, 3) << 1, 0, -cx, 0, 1, -cy, 0, 0, 1);
+	for (int i = 0; i < viewNum; i++)
+	{
+		double angle = rng.uniform(-SYNTH_ROTATE, SYNTH_ROTATE);
+		double dy = rng.uniform(-SYNTH_SHIFTY, SYNTH_SHIFTY) * viewSize.height;
+		double px = rng.uniform(-SYNTH_PERSP, SYNTH_PERSP) / cx, py = rng.uniform(-SYNTH_PERSP, SYNTH_PERSP) / cy;
+		Mat persp = (Mat_<double>(3, 3) << 1, 0, 0, 0, 1, 0, px, py, 1);
+		Mat rotate = (Mat_<double>(3, 3) << cos(angle), -sin(angle), 0, sin(angle), cos(angle), 0, 0, 0, 1);
+		Mat toPano = (Mat_<double>(3, 3) << 1, 0, i * step + cx, 0, 1, cy + dy, 0, 0, 1);
+		synthPano::homoToPano.push_back(toPano * rotate * persp * toCenter);
+		synthPano::gains.push_back((float)(1 + rng.uniform(-exposure, exposure)));
+	}
+}
+
+/*
+ * @breif:Ⱦһͼ,ȫϵаؽֵ,ͼֱ޹,Ⱦפڴ
+ * @prama[in]:idx->ͼ
+ * @retval:ͼͼ(CV_8UC3)
+ */
+Mat synthPano::renderView(int idx)
+{
+	Mat dstImg(synthPano::viewSize, CV_8UC3);
+	Mat_<double> H = synthPano::homoToPano[idx];
+	float gain = synthPano::gains[idx];
+	parallel_for_(Range(0, dstImg.rows), [&](const Range& range)
+	{
+		for (int i = range.start; i < range.end; i++)
+		{
+			// ÿж,Ⱦ̻߳޹
+			RNG rng(synthPano::seed * 1000003 + (uint64)idx * 65537 + i);
+			uchar* rowAddr = dstImg.ptr<uchar>(i);
+			for (int j = 0; j < dstImg.cols; j++)
+			{
+				double w = H(2, 0) * j + H(2, 1) * i + H(2, 2);
+				double x = (H(0, 0) * j + H(0, 1) * i + H(0, 2)) / w;
+				double y = (H(1, 0) * j + H(1, 1) * i + H(1, 2)) / w;
+				float color[3];
+				synthPano::calTexture(x, y, color);
+				for (int c = 0; c < 3; c++)
+					rowAddr[j * 3 + c] = saturate_cast<uchar>(color[c] * gain + rng.gaussian(synthPano::noiseSigma));
+			}
+		}
+	});
+	return dstImg;
+}
+
+/*
+ * @breif:ͼֵ֮Ӧ
+ * @prama[in]:leftIdx,rightIdx->ͼ
+ * @retval:ͼͼĵӦ(CV_64F)
+ */
+Mat synthPano::getTrueHomo(int leftIdx, int rightIdx)
+{
+	Mat H = synthPano::homoToPano[leftIdx].inv() * synthPano::homoToPano[rightIdx];
+	return H / H.at<double>(2, 2);
+}
+/*-----------------------------------------------------------------------------------*/
+
+
+/*===================================================================================*/
+/******************************* ˽к *********************************************/
+/*===================================================================================*/
+
+/*
+ * @breif:ȫ괦ĳ,߶ֵͼϵɫ
+ * @prama[in]:x,y->ȫ;color->ͨɫ
+ * @retval:None
+ */
+void synthPano::calTexture(double x, double y, float* color)
+{
+	for (int c = 0; c < 3; c++)
+	{
+		color[c] = 255.f * (0.55f * synthPano::valueNoise(x, y, SYNTH_CELL * 16, c)
+			+ 0.30f * synthPano::valueNoise(x, y, SYNTH_CELL * 4, c + 3)
+			+ 0.15f * synthPano::valueNoise(x, y, SYNTH_CELL, c + 6));
+	}
+
+	// ÿԪһλáСɫɫ,Ϊṩǵ
+	int cellX = (int)floor(x / SYNTH_CELL), cellY = (int)floor(y / SYNTH_CELL);
+	unsigned int h = synthPano::hashCell(cellX, cellY, 9);
+	if ((h & 3) == 0)	return;
+	double left = ((h >> 2) & 7) * SYNTH_CELL / 16.0, top = ((h >> 5) & 7) * SYNTH_CELL / 16.0;
+	double width = (4 + ((h >> 8) & 7)) * SYNTH_CELL / 16.0, height = (4 + ((h >> 11) & 7)) * SYNTH_CELL / 16.0;
+	double u = x - cellX * SYNTH_CELL, v = y - cellY * SYNTH_CELL;
+	if (u < left || u >= left + width || v < top || v >= top + height)	return;
+	unsigned int shade = synthPano::hashCell(cellX, cellY, 10);
+	for (int c = 0; c < 3; c++)	color[c] = (float)((shade >> (c * 8)) & 255);
+}
+
+/*
+ * @breif:ƽֵֵ
+ * @prama[in]:x,y->ȫ;cellSize->;layer->
+ * @retval:[0,1]ڵֵ
+ */
+float synthPano::valueNoise(double x, double y, double cellSize, unsigned int layer)
+{
+	double fx = x / cellSize, fy = y / cellSize;
+	int ix = (int)floor(fx), iy = (int)floor(fy);
+	float tx = (float)(fx - ix), ty = (float)(fy - iy);
+	tx = tx * tx * (3 - 2 * tx);
+	ty = ty * ty * (3 - 2 * ty);
+	const float norm = 1.f / 4294967295.f;
+	float v00 = synthPano::hashCell(ix, iy, layer) * norm, v10 = synthPano::hashCell(ix + 1, iy, layer) * norm;
+	float v01 = synthPano::hashCell(ix, iy + 1, layer) * norm, v11 = synthPano::hashCell(ix + 1, iy + 1, layer) * norm;
+	return (v00 * (1 - tx) + v10 * tx) * (1 - ty) + (v01 * (1 - tx) + v11 * tx) * ty;
+}
+
+/*
+ * @breif:ϣ,ͬһ½ȷ
+ * @prama[in]:x,y->;layer->
+ * @retval:32λϣֵ
+ */
+unsigned int synthPano::hashCell(int x, int y, unsigned int layer)
+{
+	unsigned int h = (unsigned int)synthPano::seed ^ (layer * 0x9e3779b9u);
+	h ^= (unsigned int)x * 0x8da6b343u;
+	h ^= (unsigned int)y * 0xd8163841u;
+	h ^= h >> 16;	h *= 0x7feb352du;
+	h ^= h >> 15;	h *= 0x846ca68bu;
+	h ^= h >> 16;
+	return h;
+}
+/*-----------------------------------------------------------------------------------*/
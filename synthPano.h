@@ -0,0 +1,97 @@
+/*******************************************************************************
+ *
+ * \file    synthPano.h
+ * \brief   ϳȫݣɳȾNֵӦعصͼ
+ * \author  agent
+ * \version 1.0
+ * \date    2026-10-19
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * -----------------------------------------------------------------------------
+ * ļ޸ʷ
+ * <ʱ>       | <汾>  | <>         |
+ * 2026-10-19  | v1.0    | agent          |
+ * -----------------------------------------------------------------------------
+ ******************************************************************************/
+#include <opencv2/imgproc/imgproc.hpp>
+#include <opencv2/core/utility.hpp>
+#include "publicElement.h"
+#include <iostream>
+using namespace cv;
+using namespace std;
+
+/*===================================================================================*/
+/******************************** 궨 *********************************************/
+/*===================================================================================*/
+#define SYNTH_SEED			 20210617							// Ĭ
+#define SYNTH_CELL				   24							// ɫ鵥Ԫ߳ .pix
+#define SYNTH_NOISE				  2.0							// Ĭϸ˹׼
+#define SYNTH_EXPOSURE			 0.15							// ĬعŶΧ,ȡ[1-e,1+e]
+#define SYNTH_ROTATE			 0.02							// ͼתŶΧ .rad
+#define SYNTH_SHIFTY			 0.02							// ͼֱƫŶΧ(ͼ߶)
+#define SYNTH_PERSP				 0.03							// ͼ͸ŶΧ(ͼԵĳ߶ȱ仯)
+/*-----------------------------------------------------------------------------------*/
+
+#pragma once
+#ifndef SYNTHPANO_H
+#define SYNTHPANO_H
+
+class synthPano
+{
+public:
+	Size viewSize;									// ͼߴ
+	int viewNum;									// ͼ
+	double overlap;									// ͼˮƽص
+	double noiseSigma;								// ˹׼
+	uint64 seed;									// 
+	vector<Mat> homoToPano;							// ͼȫϵֵӦ(CV_64F)
+	vector<float> gains;							// ͼع
+
+public:
+	/*
+	 * @breif:캯,ͼ,Դתֱƫơ͸عŶ
+	 * @prama[in]:viewSize->ͼߴ;viewNum->ͼ;overlap->ͼˮƽص
+	 * @prama[in]:noiseSigma->˹׼;exposure->عŶΧ;seed->
+	 */
+	synthPano(Size viewSize, int viewNum, double overlap, double noiseSigma = SYNTH_NOISE, double exposure = SYNTH_EXPOSURE,
+		uint64 seed = SYNTH_SEED);
+
+	/*
+	 * @breif:Ⱦһͼ,ȫϵаؽֵ,ͼֱ޹,Ⱦפڴ
+	 * @prama[in]:idx->ͼ
+	 * @retval:ͼͼ(CV_8UC3)
+	 */
+	Mat renderView(int idx);
+
+	/*
+	 * @breif:ͼֵ֮Ӧ
+	 * @prama[in]:leftIdx,rightIdx->ͼ
+	 * @retval:ͼͼĵӦ(CV_64F)
+	 */
+	Mat getTrueHomo(int leftIdx, int rightIdx);
+
+private:
+	/*
+	 * @breif:ȫ괦ĳ,߶ֵͼϵɫ
+	 * @prama[in]:x,y->ȫ;color->ͨɫ
+	 * @retval:None
+	 */
+	void calTexture(double x, double y, float* color);
+
+	/*
+	 * @breif:ƽֵֵ
+	 * @prama[in]:x,y->ȫ;cellSize->;layer->
+	 * @retval:[0,1]ڵֵ
+	 */
+	float valueNoise(double x, double y, double cellSize, unsigned int layer);
+
+	/*
+	 * @breif:ϣ,ͬһ½ȷ
+	 * @prama[in]:x,y->;layer->
+	 * @retval:32λϣֵ
+	 */
+	unsigned int hashCell(int x, int y, unsigned int layer);
+};
+
+#endif // !SYNTHPANO_H
@@ -0,0 +1,476 @@
+/*******************************************************************************
+ *
+ * \file    tiledCanvas.cpp
+ * \brief   Ƭƴͼķֿ洢ӳں
+ * \author  agent
+ * \version 1.0
+ * \date    2026-10-19
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * -----------------------------------------------------------------------------
+ * ļ޸ʷ
+ * <ʱ>       | <汾>  | <>         |
+ * 2026-10-19  | v1.0    | agent          |
+ * -----------------------------------------------------------------------------
+ ******************************************************************************/
+#include "tiledCanvas.h"
+#include <cstdio>
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#include <winioctl.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+/*===================================================================================*/
+/******************************* к *********************************************/
+/*===================================================================================*/
+
+/*
+ * @breif:,ʱȫӳ䲢ɾļ
+ */
+tiledCanvas::tiledCanvas()
+{
+	tiledCanvas::canvasWidth = 0;
+	tiledCanvas::canvasHeight = 0;
+	tiledCanvas::tileSize = 0;
+	tiledCanvas::tilesX = 0;
+	tiledCanvas::tilesY = 0;
+	tiledCanvas::colorBytes = 0;
+	tiledCanvas::tileBytes = 0;
+	tiledCanvas::tileStride = 0;
+	tiledCanvas::maxMapped = 0;
+#ifdef _WIN32
+	tiledCanvas::hFile = INVALID_HANDLE_VALUE;
+	tiledCanvas::hMapping = NULL;
+#else
+	tiledCanvas::fd = -1;
+#endif
+}
+
+tiledCanvas::~tiledCanvas()
+{
+	tiledCanvas::close();
+}
+
+/*
+ * @breif:,ļϡļ,δдƬȲռڴҲռ
+ * @prama[in]:cacheFile->Ƭļ·; width,height->;
+ * @prama[in]:tileSize->Ƭ߳; maxMapped->ͬʱӳƬ()
+ * @retval:true->ɹ; false->ʧ
+ */
+bool tiledCanvas::create(string cacheFile, int width, int height, int tileSize, int maxMapped)
+{
+	tiledCanvas::close();
+	if (width <= 0 || height <= 0 || tileSize <= 0)	return false;
+
+	tiledCanvas::cacheFile = cacheFile;
+	tiledCanvas::canvasWidth = width;
+	tiledCanvas::canvasHeight = height;
+	tiledCanvas::tileSize = tileSize;
+	tiledCanvas::tilesX = (width + tileSize - 1) / tileSize;
+	tiledCanvas::tilesY = (height + tileSize - 1) / tileSize;
+	tiledCanvas::maxMapped = cmpMax(maxMapped, 1);
+	tiledCanvas::colorBytes = ((size_t)tileSize * tileSize * 3 + sizeof(float) - 1) / sizeof(float) * sizeof(float);
+	tiledCanvas::tileBytes = tiledCanvas::colorBytes + (size_t)tileSize * tileSize * sizeof(float);
+	tiledCanvas::tileStride = (tiledCanvas::tileBytes + TILE_ALIGN - 1) / TILE_ALIGN * TILE_ALIGN;
+
+	int tileNum = tiledCanvas::tilesX * tiledCanvas::tilesY;
+	tiledCanvas::tileUsed.assign(tileNum, 0);
+	tiledCanvas::tileView.assign(tileNum, nullptr);
+	tiledCanvas::lruPos.assign(tileNum, tiledCanvas::lruList.end());
+	unsigned long long fileSize = (unsigned long long)tileNum * tiledCanvas::tileStride;
+
+#ifdef _WIN32
+	HANDLE file = CreateFileA(cacheFile.c_str(), GENERIC_READ | GENERIC_WRITE, 0, NULL, CREATE_ALWAYS,
+		FILE_ATTRIBUTE_TEMPORARY, NULL);
+	if (file == INVALID_HANDLE_VALUE)
+	{
+		MOSAIC_LOG_ERROR("tiledCanvas::create ޷ļ:" << cacheFile);
+		return false;
+	}
+	DWORD bytesReturned = 0;
+	DeviceIoControl(file, FSCTL_SET_SPARSE, NULL, 0, NULL, 0, &bytesReturned, NULL);	// ϡļ,Ƭռ
+	LARGE_INTEGER size;
+	size.QuadPart = (LONGLONG)fileSize;
+	SetFilePointerEx(file, size, NULL, FILE_BEGIN);
+	SetEndOfFile(file);
+	HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READWRITE, (DWORD)(fileSize >> 32), (DWORD)fileSize, NULL);
+	if (mapping == NULL)
+	{
+		MOSAIC_LOG_ERROR("tiledCanvas::create ޷ӳ仺ļ:" << cacheFile);
+		CloseHandle(file);
+		return false;
+	}
+	tiledCanvas::hFile = file;
+	tiledCanvas::hMapping = mapping;
+#else
+	tiledCanvas::fd = open(cacheFile.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0600);
+	if (tiledCanvas::fd < 0 || ftruncate(tiledCanvas::fd, (off_t)fileSize) != 0)	// ftruncateõϡļ
+	{
+		MOSAIC_LOG_ERROR("tiledCanvas::create ޷ļ:" << cacheFile);
+		tiledCanvas::close();
+		return false;
+	}
+#endif
+	return true;
+}
+
+/*
+ * @breif:رջ,ȫӳ䲢ɾļ
+ * @prama[in]:None
+ * @retval:None
+ */
+void tiledCanvas::close()
+{
+	for (int idx : vector<int>(tiledCanvas::lruList.begin(), tiledCanvas::lruList.end()))
+		tiledCanvas::unmapTile(idx);
+#ifdef _WIN32
+	if (tiledCanvas::hMapping != NULL)				CloseHandle(tiledCanvas::hMapping);
+	if (tiledCanvas::hFile != INVALID_HANDLE_VALUE)	CloseHandle(tiledCanvas::hFile);
+	tiledCanvas::hMapping = NULL;
+	tiledCanvas::hFile = INVALID_HANDLE_VALUE;
+#else
+	if (tiledCanvas::fd >= 0)	::close(tiledCanvas::fd);
+	tiledCanvas::fd = -1;
+#endif
+	if (!tiledCanvas::cacheFile.empty())	remove(tiledCanvas::cacheFile.c_str());
+	tiledCanvas::cacheFile.clear();
+	tiledCanvas::tileUsed.clear();
+	tiledCanvas::tileView.clear();
+	tiledCanvas::lruPos.clear();
+}
+
+/*
+ * @breif:ƬǷδд
+ * @prama[in]:tx,ty->ƬСк
+ * @retval:true->Ƭ
+ */
+bool tiledCanvas::isTileEmpty(int tx, int ty)
+{
+	return !tiledCanvas::tileUsed[ty * tiledCanvas::tilesX + tx];
+}
+
+/*
+ * @breif:һͼ񾭵Ӧ任ӳ䵽ں,ÿֻһƬ
+ * @prama[in]:srcImg->Դͼ(CV_8UC3); H->Դͼ񵽻ĵӦ; featherWidth->𻯿
+ * @retval:None
+ */
+void tiledCanvas::addImage(const Mat& srcImg, const Mat& H, int featherWidth)
+{
+	Mat H64;
+	H.convertTo(H64, CV_64F);
+	Rect tiles = tiledCanvas::tileRange(srcImg.size(), H64);
+	Mat weightImg = tiledCanvas::featherWeight(srcImg.size(), featherWidth);
+
+	// Ƭӳں,ΪһƬСʱͼ
+	Mat warpTile, warpWeight;
+	for (int ty = tiles.y; ty < tiles.y + tiles.height; ty++)
+		for (int tx = tiles.x; tx < tiles.x + tiles.width; tx++)
+			tiledCanvas::blendTile(tx, ty, srcImg, weightImg, H64, warpTile, warpWeight);
+}
+
+/*
+ * @breif:ƬΪѭӳ䲢ںȫͼ,ÿƬںཻ֮ȫͼ󼴲ٸı,漴
+ * @prama[in]:srcImgs->Դͼ(CV_8UC3),ȫפڴ; Hs->Դͼ񵽻ĵӦ
+ * @prama[in]:onTile->Ƭɻص(Ƭڻе,Ƭͼ),Ƭͼֱָӳڴ,豣ʱӦ
+ * @prama[in]:featherWidth->𻯿
+ * @retval:None
+ */
+void tiledCanvas::addImagesByTile(const vector<Mat>& srcImgs, const vector<Mat>& Hs, function<void(Rect, const Mat&)> onTile,
+	int featherWidth)
+{
+	vector<Mat> H64s(srcImgs.size()), weightImgs(srcImgs.size());
+	vector<Rect> tileRanges(srcImgs.size());
+	for (size_t k = 0; k < srcImgs.size(); k++)
+	{
+		Hs[k].convertTo(H64s[k], CV_64F);
+		tileRanges[k] = tiledCanvas::tileRange(srcImgs[k].size(), H64s[k]);
+		weightImgs[k] = tiledCanvas::featherWeight(srcImgs[k].size(), featherWidth);
+	}
+
+	// ںϴaddImageͼʱͬ,һ
+	Mat warpTile, warpWeight;
+	for (int ty = 0; ty < tiledCanvas::tilesY; ty++)
+	{
+		for (int tx = 0; tx < tiledCanvas::tilesX; tx++)
+		{
+			for (size_t k = 0; k < srcImgs.size(); k++)
+				if (tileRanges[k].contains(Point(tx, ty)))
+					tiledCanvas::blendTile(tx, ty, srcImgs[k], weightImgs[k], H64s[k], warpTile, warpWeight);
+			if (tiledCanvas::isTileEmpty(tx, ty) || !onTile)	continue;
+			Mat tileImg = tiledCanvas::getTile(tx, ty, false);
+			onTile(Rect(tx * tiledCanvas::tileSize, ty * tiledCanvas::tileSize, tileImg.cols, tileImg.rows), tileImg);
+		}
+	}
+}
+
+/*
+ * @breif:ȡеһ(),ƬԺɫ
+ * @prama[in]:roi->е
+ * @retval:dstImg->ͼ
+ */
+Mat tiledCanvas::readRegion(Rect roi)
+{
+	roi &= Rect(0, 0, tiledCanvas::canvasWidth, tiledCanvas::canvasHeight);
+	Mat dstImg(roi.height, roi.width, CV_8UC3, Scalar(0, 0, 0));
+	if (roi.empty())	return dstImg;
+
+	for (int ty = roi.y / tiledCanvas::tileSize; ty <= (roi.y + roi.height - 1) / tiledCanvas::tileSize; ty++)
+	{
+		for (int tx = roi.x / tiledCanvas::tileSize; tx <= (roi.x + roi.width - 1) / tiledCanvas::tileSize; tx++)
+		{
+			Mat tileImg = tiledCanvas::getTile(tx, ty, false);
+			if (tileImg.empty())	continue;
+			Rect tileRect(tx * tiledCanvas::tileSize, ty * tiledCanvas::tileSize, tileImg.cols, tileImg.rows);
+			Rect part = tileRect & roi;
+			tileImg(Rect(part.x - tileRect.x, part.y - tileRect.y, part.width, part.height))
+				.copyTo(dstImg(Rect(part.x - roi.x, part.y - roi.y, part.width, part.height)));
+		}
+	}
+	return dstImg;
+}
+
+/*
+ * @breif:ʽʽΪBigTIFF(ѹRGB),ÿΪһƬ
+ * @prama[in]:dstFile->ļ·
+ * @retval:true->ɹ; false->ʧ
+ */
+bool tiledCanvas::writeTiff(string dstFile)
+{
+	ofstream file(dstFile, ios::binary);
+	if (!file.is_open())
+	{
+		MOSAIC_LOG_ERROR("tiledCanvas::writeTiff ޷ļ:" << dstFile);
+		return false;
+	}
+	auto put16 = [&file](unsigned short v) { file.write((const char*)&v, 2); };
+	auto put64 = [&file](unsigned long long v) { file.write((const char*)&v, 8); };
+
+	// BigTIFFļͷ:ֽ򡢰汾43ƫֽ8׸IFDƫ()
+	file.write("II", 2);
+	put16(43);
+	put16(8);
+	put16(0);
+	put64(0);
+
+	// д,ÿֻڴбһƬ
+	vector<unsigned long long> stripOffsets, stripBytes;
+	Mat stripRGB;
+	for (int ty = 0; ty < tiledCanvas::tilesY; ty++)
+	{
+		Rect stripRect(0, ty * tiledCanvas::tileSize, tiledCanvas::canvasWidth,
+			cmpMin(tiledCanvas::tileSize, tiledCanvas::canvasHeight - ty * tiledCanvas::tileSize));
+		cvtColor(tiledCanvas::readRegion(stripRect), stripRGB, COLOR_BGR2RGB);
+		stripOffsets.push_back((unsigned long long)file.tellp());
+		stripBytes.push_back((unsigned long long)stripRGB.total() * 3);
+		file.write((const char*)stripRGB.data, stripRGB.total() * 3);
+	}
+
+	// ƫơֽ(1ʱIFD)
+	int stripNum = (int)stripOffsets.size();
+	unsigned long long offsetsPos = stripOffsets[0], bytesPos = stripBytes[0];
+	if (stripNum > 1)
+	{
+		offsetsPos = (unsigned long long)file.tellp();
+		for (unsigned long long v : stripOffsets)	put64(v);
+		bytesPos = (unsigned long long)file.tellp();
+		for (unsigned long long v : stripBytes)	put64(v);
+	}
+
+	// IFD,ǩ
+	unsigned long long ifdPos = (unsigned long long)file.tellp();
+	auto putEntry = [&](unsigned short tag, unsigned short type, unsigned long long count, unsigned long long value)
+	{
+		put16(tag);	put16(type);	put64(count);	put64(value);
+	};
+	put64(10);
+	putEntry(256, 4, 1, (unsigned long long)tiledCanvas::canvasWidth);			// ImageWidth
+	putEntry(257, 4, 1, (unsigned long long)tiledCanvas::canvasHeight);		// ImageLength
+	putEntry(258, 3, 3, 0x0000000800080008ULL);									// BitsPerSample:8,8,8()
+	putEntry(259, 3, 1, 1);														// Compression:
+	putEntry(262, 3, 1, 2);														// Photometric:RGB
+	putEntry(273, 16, stripNum, offsetsPos);									// StripOffsets
+	putEntry(277, 3, 1, 3);														// SamplesPerPixel
+	putEntry(278, 4, 1, (unsigned long long)tiledCanvas::tileSize);			// RowsPerStrip
+	putEntry(279, 16, stripNum, bytesPos);										// StripByteCounts
+	putEntry(284, 3, 1, 1);														// PlanarConfig:
+	put64(0);
+
+	file.seekp(8);
+	put64(ifdPos);
+	return file.good();
+}
+/*-----------------------------------------------------------------------------------*/
+
+
+/*===================================================================================*/
+/******************************* ˽к *********************************************/
+/*===================================================================================*/
+
+/*
+ * @breif:Դͼӳ䵽İΧǵƬΧ
+ * @prama[in]:srcSize->Դͼߴ; H64->Դͼ񵽻ĵӦ(CV_64F)
+ * @retval:ƬΧ,xyΪʼСк,widthheightΪ
+ */
+Rect tiledCanvas::tileRange(Size srcSize, const Mat& H64)
+{
+	vector<Point2f> srcCorners = { Point2f(0, 0), Point2f((float)srcSize.width, 0),
+		Point2f(0, (float)srcSize.height), Point2f((float)srcSize.width, (float)srcSize.height) };
+	vector<Point2f> dstCorners;
+	perspectiveTransform(srcCorners, dstCorners, H64);
+	float minX = dstCorners[0].x, maxX = dstCorners[0].x, minY = dstCorners[0].y, maxY = dstCorners[0].y;
+	for (const Point2f& p : dstCorners)
+	{
+		minX = min(minX, p.x);	maxX = max(maxX, p.x);
+		minY = min(minY, p.y);	maxY = max(maxY, p.y);
+	}
+	int txBegin = cmpMax((int)floor(minX) / tiledCanvas::tileSize, 0);
+	int tyBegin = cmpMax((int)floor(minY) / tiledCanvas::tileSize, 0);
+	int txEnd = cmpMin((int)ceil(maxX) / tiledCanvas::tileSize, tiledCanvas::tilesX - 1);
+	int tyEnd = cmpMin((int)ceil(maxY) / tiledCanvas::tileSize, tiledCanvas::tilesY - 1);
+	return Rect(txBegin, tyBegin, cmpMax(txEnd - txBegin + 1, 0), cmpMax(tyEnd - tyBegin + 1, 0));
+}
+
+/*
+ * @breif:ԴͼȨ(0~255),ͼ߽ԽԶȨԽ
+ * @prama[in]:srcSize->Դͼߴ; featherWidth->𻯿
+ * @retval:weightImg->Ȩͼ(CV_8UC1)
+ */
+Mat tiledCanvas::featherWeight(Size srcSize, int featherWidth)
+{
+	Mat weightImg(srcSize.height, srcSize.width, CV_8UC1);
+	int feather = cmpMax(featherWidth, 1);
+	for (int i = 0; i < srcSize.height; i++)
+	{
+		uchar* rowAddrWeight = weightImg.ptr<uchar>(i);
+		int distY = cmpMin(i + 1, srcSize.height - i);
+		for (int j = 0; j < srcSize.width; j++)
+		{
+			int dist = cmpMin(distY, cmpMin(j + 1, srcSize.width - j));
+			rowAddrWeight[j] = (uchar)(dist >= feather ? 255 : dist * 255 / feather);
+		}
+	}
+	return weightImg;
+}
+
+/*
+ * @breif:һͼӳ䵽һƬȨعһں,δʵʸǵƬʵ廯
+ * @prama[in]:tx,ty->ƬСк; srcImg->Դͼ; weightImg->Ȩ; H64->Դͼ񵽻ĵӦ(CV_64F)
+ * @prama[in]:warpTile,warpWeight->ƬСʱͼ,ø
+ * @retval:None
+ */
+void tiledCanvas::blendTile(int tx, int ty, const Mat& srcImg, const Mat& weightImg, const Mat& H64, Mat& warpTile, Mat& warpWeight)
+{
+	Mat shift = (Mat_<double>(3, 3) << 1, 0, -tx * tiledCanvas::tileSize, 0, 1, -ty * tiledCanvas::tileSize, 0, 0, 1);
+	Mat tileH = shift * H64;
+	Size tileRect(cmpMin(tiledCanvas::tileSize, tiledCanvas::canvasWidth - tx * tiledCanvas::tileSize),
+		cmpMin(tiledCanvas::tileSize, tiledCanvas::canvasHeight - ty * tiledCanvas::tileSize));
+	warpPerspective(weightImg, warpWeight, tileH, tileRect, INTER_LINEAR, BORDER_CONSTANT, Scalar(0));
+	if (countNonZero(warpWeight) == 0)	return;			// Χڵʵδ
+	warpPerspective(srcImg, warpTile, tileH, tileRect, INTER_LINEAR, BORDER_CONSTANT, Scalar(0, 0, 0));
+
+	Mat tileWeight;
+	Mat tileImg = tiledCanvas::getTile(tx, ty, true, &tileWeight);
+	if (tileImg.empty())	return;
+	for (int i = 0; i < tileRect.height; i++)
+	{
+		const uchar* rowAddrSrc = warpTile.ptr<uchar>(i);
+		const uchar* rowAddrWeight = warpWeight.ptr<uchar>(i);
+		uchar* rowAddrDst = tileImg.ptr<uchar>(i);
+		float* rowAddrTotal = tileWeight.ptr<float>(i);
+		for (int j = 0; j < tileRect.width; j++)
+		{
+			int alpha = rowAddrWeight[j];
+			if (alpha == 0)	continue;
+			uchar* dst = rowAddrDst + j * 3;
+			const uchar* src = rowAddrSrc + j * 3;
+			// ۼȨΪ0,ʱԴ;ۼȨعһ,ʵĺɫճں
+			float total = rowAddrTotal[j] + alpha;
+			float wDst = rowAddrTotal[j] / total, wSrc = alpha / total;
+			dst[0] = saturate_cast<uchar>(dst[0] * wDst + src[0] * wSrc);
+			dst[1] = saturate_cast<uchar>(dst[1] * wDst + src[1] * wSrc);
+			dst[2] = saturate_cast<uchar>(dst[2] * wDst + src[2] * wSrc);
+			rowAddrTotal[j] = total;
+		}
+	}
+}
+
+/*
+ * @breif:ȡƬ(ӳ䵽ڴ),ҪʱLRṶƬ
+ * @prama[in]:tx,ty->ƬСк; alloc->ƬǷʵ廯; weightTile->ۼȨ(CV_32FC1,Ϊ)
+ * @note:صMatֱָӳڴ,getTileÿʹʧЧ
+ * @retval:tileImg->Ƭͼ; ƬallocΪfalseʱؿMat
+ */
+Mat tiledCanvas::getTile(int tx, int ty, bool alloc, Mat* weightTile)
+{
+	int idx = ty * tiledCanvas::tilesX + tx;
+	if (!tiledCanvas::tileUsed[idx] && !alloc)	return Mat();
+
+	uchar* view = tiledCanvas::tileView[idx];
+	if (view == nullptr)
+	{
+		// ʱ̭δʹõƬ,ϵͳдļ
+		while ((int)tiledCanvas::lruList.size() >= tiledCanvas::maxMapped)
+			tiledCanvas::unmapTile(tiledCanvas::lruList.back());
+		view = tiledCanvas::mapTile(idx);
+		if (view == nullptr)	return Mat();
+		tiledCanvas::lruList.push_front(idx);
+		tiledCanvas::lruPos[idx] = tiledCanvas::lruList.begin();
+	}
+	else
+		tiledCanvas::lruList.splice(tiledCanvas::lruList.begin(), tiledCanvas::lruList, tiledCanvas::lruPos[idx]);
+
+	tiledCanvas::tileUsed[idx] = 1;			// ϡļĿնΪ0,ɫۼȨΪ0ĿƬ
+	int width = cmpMin(tiledCanvas::tileSize, tiledCanvas::canvasWidth - tx * tiledCanvas::tileSize);
+	int height = cmpMin(tiledCanvas::tileSize, tiledCanvas::canvasHeight - ty * tiledCanvas::tileSize);
+	if (weightTile != nullptr)
+		*weightTile = Mat(height, width, CV_32FC1, view + tiledCanvas::colorBytes, (size_t)tiledCanvas::tileSize * sizeof(float));
+	return Mat(height, width, CV_8UC3, view, (size_t)tiledCanvas::tileSize * 3);
+}
+
+/*
+ * @breif:ӳ䡢ӳ䵥Ƭ
+ * @prama[in]:idx->Ƭ
+ * @retval:ӳַ or None
+ */
+uchar* tiledCanvas::mapTile(int idx)
+{
+	unsigned long long offset = (unsigned long long)idx * tiledCanvas::tileStride;
+#ifdef _WIN32
+	void* view = MapViewOfFile((HANDLE)tiledCanvas::hMapping, FILE_MAP_ALL_ACCESS,
+		(DWORD)(offset >> 32), (DWORD)offset, tiledCanvas::tileBytes);
+	if (view == NULL)
+	{
+		MOSAIC_LOG_ERROR("tiledCanvas::mapTile ӳƬʧ:" << idx);
+		return nullptr;
+	}
+#else
+	void* view = mmap(NULL, tiledCanvas::tileBytes, PROT_READ | PROT_WRITE, MAP_SHARED, tiledCanvas::fd, (off_t)offset);
+	if (view == MAP_FAILED)
+	{
+		MOSAIC_LOG_ERROR("tiledCanvas::mapTile ӳƬʧ:" << idx);
+		return nullptr;
+	}
+#endif
+	tiledCanvas::tileView[idx] = (uchar*)view;
+	return (uchar*)view;
+}
+
+void tiledCanvas::unmapTile(int idx)
+{
+	if (tiledCanvas::tileView[idx] == nullptr)	return;
+#ifdef _WIN32
+	UnmapViewOfFile(tiledCanvas::tileView[idx]);
+#else
+	munmap(tiledCanvas::tileView[idx], tiledCanvas::tileBytes);
+#endif
+	tiledCanvas::tileView[idx] = nullptr;
+	tiledCanvas::lruList.erase(tiledCanvas::lruPos[idx]);
+	tiledCanvas::lruPos[idx] = tiledCanvas::lruList.end();
+}
+/*-----------------------------------------------------------------------------------*/
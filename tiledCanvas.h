@@ -0,0 +1,174 @@
+/*******************************************************************************
+ *
+ * \file    tiledCanvas.h
+ * \brief   Ƭƴͼķֿ洢ӳں
+ * \author  agent
+ * \version 1.0
+ * \date    2026-10-19
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * -----------------------------------------------------------------------------
+ * ļ޸ʷ
+ * <ʱ>       | <汾>  | <>         |
+ * 2026-10-19  | v1.0    | agent          |
+ * -----------------------------------------------------------------------------
+ ******************************************************************************/
+#include <opencv2/imgproc/imgproc.hpp>
+#ifndef MOSAIC_HEADLESS
+#include <opencv2/highgui/highgui.hpp>
+#endif
+#include "publicElement.h"
+#include <iostream>
+#include <fstream>
+#include <list>
+#include <functional>
+using namespace cv;
+using namespace std;
+
+/*===================================================================================*/
+/******************************** 궨 *********************************************/
+/*===================================================================================*/
+#define TILE_SIZE				  512							// Ƭ߳ .pix
+#define TILE_MAXMAPPED			   64							// ͬʱӳ䵽ڴƬ
+#define TILE_FEATHER			   32							// ں𻯿 .pix
+#define TILE_ALIGN				65536							// ƬļеĶ(Windowsӳ)
+/*-----------------------------------------------------------------------------------*/
+
+#pragma once
+#ifndef TILEDCANVAS_H
+#define TILEDCANVAS_H
+
+/*
+ * ÿƬڻļδɫ(CV_8UC3)ۼȨؿ(CV_32FC1)ɫΪۼȨعһļȨƽ,
+ * ͼʱ c=(c*W+s*w)/(W+w),ںϴ޹();ۼȨΪ0,ɫжϡ
+ * ļӳ,ɿ
+ */
+class tiledCanvas
+{
+public:
+	int canvasWidth;								//  .pix
+	int canvasHeight;								//  .pix
+	int tileSize;									// Ƭ߳ .pix
+	int tilesX;										// Ƭ
+	int tilesY;										// Ƭ
+
+public:
+	/*
+	 * @breif:,ʱȫӳ䲢ɾļ
+	 */
+	tiledCanvas();
+	~tiledCanvas();
+	tiledCanvas(const tiledCanvas&) = delete;
+	tiledCanvas& operator=(const tiledCanvas&) = delete;
+
+	/*
+	 * @breif:,ļϡļ,δдƬȲռڴҲռ
+	 * @prama[in]:cacheFile->Ƭļ·; width,height->;
+	 * @prama[in]:tileSize->Ƭ߳; maxMapped->ͬʱӳƬ()
+	 * @retval:true->ɹ; false->ʧ
+	 */
+	bool create(string cacheFile, int width, int height, int tileSize = TILE_SIZE, int maxMapped = TILE_MAXMAPPED);
+
+	/*
+	 * @breif:رջ,ȫӳ䲢ɾļ
+	 * @prama[in]:None
+	 * @retval:None
+	 */
+	void close();
+
+	/*
+	 * @breif:ƬǷδд
+	 * @prama[in]:tx,ty->ƬСк
+	 * @retval:true->Ƭ
+	 */
+	bool isTileEmpty(int tx, int ty);
+
+	/*
+	 * @breif:һͼ񾭵Ӧ任ӳ䵽ں,ÿֻһƬ
+	 * @prama[in]:srcImg->Դͼ(CV_8UC3); H->Դͼ񵽻ĵӦ; featherWidth->𻯿
+	 * @retval:None
+	 */
+	void addImage(const Mat& srcImg, const Mat& H, int featherWidth = TILE_FEATHER);
+
+	/*
+	 * @breif:ƬΪѭӳ䲢ںȫͼ,ÿƬںཻ֮ȫͼ󼴲ٸı,漴
+	 * @prama[in]:srcImgs->Դͼ(CV_8UC3),ȫפڴ; Hs->Դͼ񵽻ĵӦ
+	 * @prama[in]:onTile->Ƭɻص(Ƭڻе,Ƭͼ),Ƭͼֱָӳڴ,豣ʱӦ
+	 * @prama[in]:featherWidth->𻯿
+	 * @retval:None
+	 */
+	void addImagesByTile(const vector<Mat>& srcImgs, const vector<Mat>& Hs, function<void(Rect, const Mat&)> onTile,
+		int featherWidth = TILE_FEATHER);
+
+	/*
+	 * @breif:ȡеһ(),ƬԺɫ
+	 * @prama[in]:roi->е
+	 * @retval:dstImg->ͼ
+	 */
+	Mat readRegion(Rect roi);
+
+	/*
+	 * @breif:ʽʽΪBigTIFF(ѹRGB),ÿΪһƬ
+	 * @prama[in]:dstFile->ļ·
+	 * @retval:true->ɹ; false->ʧ
+	 */
+	bool writeTiff(string dstFile);
+
+private:
+	string cacheFile;								// Ƭļ
+	size_t colorBytes;								// Ƭɫ,ΪۼȨؿ .byte
+	size_t tileBytes;								// Ƭ(ɫۼȨؿ) .byte
+	size_t tileStride;								// ƬļռõĿռ(TILE_ALIGN)
+	int maxMapped;									// ͬʱӳƬ
+	vector<uchar> tileUsed;							// ƬǷʵ廯
+	vector<uchar*> tileView;						// Ƭӳַ,δӳΪnullptr
+	list<int> lruList;								// ӳƬ,ͷΪʹ
+	vector<list<int>::iterator> lruPos;				// ƬlruListеλ
+#ifdef _WIN32
+	void* hFile;									// ļ
+	void* hMapping;									// ļӳ
+#else
+	int fd;											// ļ
+#endif
+
+	/*
+	 * @breif:Դͼӳ䵽İΧǵƬΧ
+	 * @prama[in]:srcSize->Դͼߴ; H64->Դͼ񵽻ĵӦ(CV_64F)
+	 * @retval:ƬΧ,xyΪʼСк,widthheightΪ
+	 */
+	Rect tileRange(Size srcSize, const Mat& H64);
+
+	/*
+	 * @breif:ԴͼȨ(0~255),ͼ߽ԽԶȨԽ
+	 * @prama[in]:srcSize->Դͼߴ; featherWidth->𻯿
+	 * @retval:weightImg->Ȩͼ(CV_8UC1)
+	 */
+	static Mat featherWeight(Size srcSize, int featherWidth);
+
+	/*
+	 * @breif:һͼӳ䵽һƬȨعһں,δʵʸǵƬʵ廯
+	 * @prama[in]:tx,ty->ƬСк; srcImg->Դͼ; weightImg->Ȩ; H64->Դͼ񵽻ĵӦ(CV_64F)
+	 * @prama[in]:warpTile,warpWeight->ƬСʱͼ,ø
+	 * @retval:None
+	 */
+	void blendTile(int tx, int ty, const Mat& srcImg, const Mat& weightImg, const Mat& H64, Mat& warpTile, Mat& warpWeight);
+
+	/*
+	 * @breif:ȡƬ(ӳ䵽ڴ),ҪʱLRṶƬ
+	 * @prama[in]:tx,ty->ƬСк; alloc->ƬǷʵ廯; weightTile->ۼȨ(CV_32FC1,Ϊ)
+	 * @note:صMatֱָӳڴ,getTileÿʹʧЧ
+	 * @retval:tileImg->Ƭͼ; ƬallocΪfalseʱؿMat
+	 */
+	Mat getTile(int tx, int ty, bool alloc, Mat* weightTile = nullptr);
+
+	/*
+	 * @breif:ӳ䡢ӳ䵥Ƭ
+	 * @prama[in]:idx->Ƭ
+	 * @retval:ӳַ or None
+	 */
+	uchar* mapTile(int idx);
+	void unmapTile(int idx);
+};
+
+#endif // !TILEDCANVAS_H
@@ -0,0 +1,259 @@
+/*******************************************************************************
+ *
+ * \file    validMask.cpp
+ * \brief   Ч룺γ̼¼ͼݵ浥Ӧӳɲƴд
+ * \author  agent
+ * \version 1.0
+ * \date    2026-10-19
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * -----------------------------------------------------------------------------
+ * ļ޸ʷ
+ * <ʱ>       | <汾>  | <>         |
+ * 2026-10-19  | v1.0    | agent          |
+ * -----------------------------------------------------------------------------
+ ******************************************************************************/
+#include "validMask.h"
+
+/*===================================================================================*/
+/******************************* к *********************************************/
+/*===================================================================================*/
+
+/*
+ * @breif:Ч,Ч
+ * @prama[in]:size->ߴ; rect->Ч,Ĳֲõ
+ * @retval:None
+ */
+void validMask::setRect(Size size, Rect rect)
+{
+	validMask::reset(size);
+	for (int i = 0; i < size.height; i++)
+	{
+		if (i >= rect.y && i < rect.y + rect.height)	validMask::addRun(rect.x, rect.x + rect.width);
+		validMask::closeRow();
+	}
+}
+
+/*
+ * @breif:ԴͼЧʱ,ӦӳЧ:ӳԴͼ[0,W-1]x[0,H-1]w>0,
+ *        ÿһڶԲʽ,ÿһ
+ * @prama[in]:mapSize->ӳͼߴ; H->ԴͼӳͼĵӦ; srcSize->Դͼߴ
+ * @retval:None
+ */
+void validMask::setHomo(Size mapSize, const Mat& H, Size srcSize)
+{
+	Mat Hinv;
+	H.convertTo(Hinv, CV_64F);
+	Hinv = Hinv.inv();
+	validMask::reset(mapSize);
+	for (int i = 0; i < mapSize.height; i++)
+	{
+		row_run run = validMask::homoRowRun(Hinv.ptr<double>(), i, mapSize.width, srcSize);
+		validMask::addRun(run.begin, run.end);
+		validMask::closeRow();
+	}
+}
+
+/*
+ * @breif:Դͼ뾭ӦӳЧ,ԴЧʱͬsetHomo;˫ӳ,
+ *        ȡֵΪ255(ֵȫЧ)Ч,ֻsetHomoɨ
+ * @prama[in]:srcMask->Դͼ; H->ԴͼӳͼĵӦ; mapSize->ӳͼߴ
+ * @prama[in]:mapCache->HmapSizeӦӳ,ʱremapwarpPerspective
+ * @retval:None
+ */
+void validMask::warpFrom(const validMask& srcMask, const Mat& H, Size mapSize, warpMapCache* mapCache)
+{
+	if (srcMask.isFull())
+	{
+		validMask::setHomo(mapSize, H, srcMask.size);
+		return;
+	}
+	srcMask.toMat(validMask::srcPlane);
+	if (mapCache == nullptr)	warpPerspective(validMask::srcPlane, validMask::dstPlane, H, mapSize);
+	else						mapCache->apply(validMask::srcPlane, validMask::dstPlane);
+
+	Mat Hinv;
+	H.convertTo(Hinv, CV_64F);
+	Hinv = Hinv.inv();
+	validMask::reset(mapSize);
+	for (int i = 0; i < mapSize.height; i++)
+	{
+		row_run bound = validMask::homoRowRun(Hinv.ptr<double>(), i, mapSize.width, srcMask.size);
+		const uchar* rowAddr = validMask::dstPlane.ptr<uchar>(i);
+		int j = bound.begin;
+		while (j < bound.end)
+		{
+			while (j < bound.end && rowAddr[j] != 255)	j++;
+			int begin = j;
+			while (j < bound.end && rowAddr[j] == 255)	j++;
+			validMask::addRun(begin, j);
+		}
+		validMask::closeRow();
+	}
+}
+
+/*
+ * @breif:8λͼ,0ΪЧ
+ * @prama[in]:mask->ͼ(CV_8UC1)
+ * @retval:None
+ */
+void validMask::fromMat(const Mat& mask)
+{
+	validMask::reset(mask.size());
+	for (int i = 0; i < mask.rows; i++)
+	{
+		const uchar* rowAddr = mask.ptr<uchar>(i);
+		int j = 0;
+		while (j < mask.cols)
+		{
+			while (j < mask.cols && rowAddr[j] == 0)	j++;
+			int begin = j;
+			while (j < mask.cols && rowAddr[j] != 0)	j++;
+			validMask::addRun(begin, j);
+		}
+		validMask::closeRow();
+	}
+}
+
+/*
+ * @breif:չΪ8λͼ,ߴ粻ʱڴ
+ * @prama[in]:mask->ͼ(CV_8UC1),255ΪЧ
+ * @retval:None
+ */
+void validMask::toMat(Mat& mask) const
+{
+	mask.create(validMask::size, CV_8UC1);
+	for (int i = 0; i < mask.rows; i++)
+	{
+		uchar* rowAddr = mask.ptr<uchar>(i);
+		memset(rowAddr, 0, mask.cols);
+		const row_run* rowRun = validMask::rowRuns(i);
+		for (int r = 0; r < validMask::runNum(i); r++)
+			memset(rowAddr + rowRun[r].begin, 255, rowRun[r].end - rowRun[r].begin);
+	}
+}
+
+/*
+ * @breif:й:reset׷,ÿcloseRow
+ * @prama[in]:size->ߴ; begin,end->,밴׷,һصʱϲ,ȵĲֲõ
+ * @retval:None
+ */
+void validMask::reset(Size size)
+{
+	validMask::size = size;
+	validMask::runs.clear();
+	validMask::rowStart.clear();
+	validMask::rowStart.reserve(size.height + 1);
+	validMask::rowStart.push_back(0);
+}
+
+void validMask::addRun(int begin, int end)
+{
+	begin = cmpMax(begin, 0);
+	end = cmpMin(end, validMask::size.width);
+	if (begin >= end)	return;
+	if ((int)validMask::runs.size() > validMask::rowStart.back() && begin <= validMask::runs.back().end)
+	{
+		validMask::runs.back().end = cmpMax(validMask::runs.back().end, end);
+		return;
+	}
+	validMask::runs.push_back({ begin, end });
+}
+
+void validMask::closeRow()
+{
+	validMask::rowStart.push_back((int)validMask::runs.size());
+}
+
+/*
+ * @breif:rowе׸
+ * @prama[in]:row->к
+ * @retval:; ׸ַ
+ */
+int validMask::runNum(int row) const
+{
+	if (row < 0 || row + 1 >= (int)validMask::rowStart.size())	return 0;
+	return validMask::rowStart[row + 1] - validMask::rowStart[row];
+}
+
+const validMask::row_run* validMask::rowRuns(int row) const
+{
+	if (row < 0 || row + 1 >= (int)validMask::rowStart.size())	return nullptr;
+	return validMask::runs.data() + validMask::rowStart[row];
+}
+
+/*
+ * @breif:ǷЧ
+ * @prama[in]:None
+ * @retval:true->ÿж[0,cols)
+ */
+bool validMask::isFull() const
+{
+	if (validMask::size.area() == 0 || (int)validMask::rowStart.size() != validMask::size.height + 1 ||
+		(int)validMask::runs.size() != validMask::size.height)
+		return false;
+	for (const row_run& run : validMask::runs)
+		if (run.begin != 0 || run.end != validMask::size.width)	return false;
+	return true;
+}
+
+/*
+ * @breif:ͷȫ
+ * @prama[in]:None
+ * @retval:None
+ */
+void validMask::release()
+{
+	validMask::size = Size();
+	vector<int>().swap(validMask::rowStart);
+	vector<row_run>().swap(validMask::runs);
+	validMask::srcPlane.release();
+	validMask::dstPlane.release();
+}
+
+/*
+ * @breif:ռõڴ
+ * @prama[in]:None
+ * @retval:ռ .byte
+ */
+size_t validMask::bytes() const
+{
+	return validMask::rowStart.capacity() * sizeof(int) + validMask::runs.capacity() * sizeof(row_run) +
+		validMask::srcPlane.total() * validMask::srcPlane.elemSize() + validMask::dstPlane.total() * validMask::dstPlane.elemSize();
+}
+/*-----------------------------------------------------------------------------------*/
+
+
+/*===================================================================================*/
+/******************************* ˽к *********************************************/
+/*===================================================================================*/
+
+/*
+ * @breif:ӦӳyȫԼ
+ * @prama[in]:Hinv->ӳͼԴͼĵӦ(); y->к; cols->ӳͼ; srcSize->Դͼߴ
+ * @note:ӳ(u',v',w')=Hinv*(x,y,1),Լw'>00<=u'<=(W-1)w'0<=v'<=(H-1)w'дa*x+b>=0
+ * @retval:,Чʱbegin>=end
+ */
+validMask::row_run validMask::homoRowRun(const double* Hinv, int y, int cols, Size srcSize)
+{
+	double maxU = srcSize.width - 1, maxV = srcSize.height - 1;
+	double uA = Hinv[0], uB = Hinv[1] * y + Hinv[2];
+	double vA = Hinv[3], vB = Hinv[4] * y + Hinv[5];
+	double wA = Hinv[6], wB = Hinv[7] * y + Hinv[8];
+	const double constraints[5][2] = {
+		{ wA, wB - VALIDMASK_MINW },
+		{ uA, uB }, { maxU * wA - uA, maxU * wB - uB },
+		{ vA, vB }, { maxV * wA - vA, maxV * wB - vB } };
+
+	double lo = 0, hi = cols - 1;
+	for (const auto& c : constraints)
+	{
+		if (c[0] > 0)			lo = max(lo, -c[1] / c[0]);
+		else if (c[0] < 0)		hi = min(hi, -c[1] / c[0]);
+		else if (c[1] < 0)		return { 0, 0 };
+		if (lo > hi)			return { 0, 0 };
+	}
+	return { (int)ceil(lo), (int)floor(hi) + 1 };
+}
+/*-----------------------------------------------------------------------------------*/
@@ -0,0 +1,141 @@
+/*******************************************************************************
+ *
+ * \file    validMask.h
+ * \brief   Ч룺γ̼¼ͼݵ浥Ӧӳɲƴд
+ * \author  agent
+ * \version 1.0
+ * \date    2026-10-19
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * -----------------------------------------------------------------------------
+ * ļ޸ʷ
+ * <ʱ>       | <汾>  | <>         |
+ * 2026-10-19  | v1.0    | agent          |
+ * -----------------------------------------------------------------------------
+ ******************************************************************************/
+#include <opencv2/imgproc/imgproc.hpp>
+#include "publicElement.h"
+#include "warpMapCache.h"
+#include <vector>
+#include <cmath>
+using namespace cv;
+using namespace std;
+
+/*===================================================================================*/
+/******************************** 궨 *********************************************/
+/*===================================================================================*/
+#define VALIDMASK_MINW			 1e-8							// w,wڴֵĵ
+/*-----------------------------------------------------------------------------------*/
+
+#pragma once
+#ifndef VALIDMASK_H
+#define VALIDMASK_H
+
+/*
+ * iеЧΪruns[rowStart[i]]runs[rowStart[i+1]-1],ÿΪ[begin,end),һڡ
+ * ͼЧʱÿһ;Ӧӳн,жɫ,ʵĺɫҲᱻݡ
+ * Ҫ(ӳƴͼ롢ͼ)ʱչΪ8λͼ,255ΪЧ
+ */
+class validMask
+{
+public:
+	typedef struct
+	{
+		int begin;									// ʼ
+		int end;									// ()
+	}row_run;
+
+	Size size;										// ߴ
+	vector<int> rowStart;							// ׸runsеλ,rows+1
+	vector<row_run> runs;							// Ч
+
+public:
+	/*
+	 * @breif:Ч,Ч
+	 * @prama[in]:size->ߴ; rect->Ч,Ĳֲõ
+	 * @retval:None
+	 */
+	void setRect(Size size, Rect rect);
+
+	/*
+	 * @breif:ԴͼЧʱ,ӦӳЧ:ӳԴͼ[0,W-1]x[0,H-1]w>0,
+	 *        ÿһڶԲʽ,ÿһ
+	 * @prama[in]:mapSize->ӳͼߴ; H->ԴͼӳͼĵӦ; srcSize->Դͼߴ
+	 * @retval:None
+	 */
+	void setHomo(Size mapSize, const Mat& H, Size srcSize);
+
+	/*
+	 * @breif:Դͼ뾭ӦӳЧ,ԴЧʱͬsetHomo;˫ӳ,
+	 *        ȡֵΪ255(ֵȫЧ)Ч,ֻsetHomoɨ
+	 * @prama[in]:srcMask->Դͼ; H->ԴͼӳͼĵӦ; mapSize->ӳͼߴ
+	 * @prama[in]:mapCache->HmapSizeӦӳ,ʱremapwarpPerspective
+	 * @retval:None
+	 */
+	void warpFrom(const validMask& srcMask, const Mat& H, Size mapSize, warpMapCache* mapCache = nullptr);
+
+	/*
+	 * @breif:8λͼ,0ΪЧ
+	 * @prama[in]:mask->ͼ(CV_8UC1)
+	 * @retval:None
+	 */
+	void fromMat(const Mat& mask);
+
+	/*
+	 * @breif:չΪ8λͼ,ߴ粻ʱڴ
+	 * @prama[in]:mask->ͼ(CV_8UC1),255ΪЧ
+	 * @retval:None
+	 */
+	void toMat(Mat& mask) const;
+
+	/*
+	 * @breif:й:reset׷,ÿcloseRow
+	 * @prama[in]:size->ߴ; begin,end->,밴׷,һصʱϲ,ȵĲֲõ
+	 * @retval:None
+	 */
+	void reset(Size size);
+	void addRun(int begin, int end);
+	void closeRow();
+
+	/*
+	 * @breif:rowе׸
+	 * @prama[in]:row->к
+	 * @retval:; ׸ַ
+	 */
+	int runNum(int row) const;
+	const row_run* rowRuns(int row) const;
+
+	/*
+	 * @breif:ǷЧ
+	 * @prama[in]:None
+	 * @retval:true->ÿж[0,cols)
+	 */
+	bool isFull() const;
+
+	/*
+	 * @breif:ͷȫ
+	 * @prama[in]:None
+	 * @retval:None
+	 */
+	void release();
+
+	/*
+	 * @breif:ռõڴ
+	 * @prama[in]:None
+	 * @retval:ռ .byte
+	 */
+	size_t bytes() const;
+
+private:
+	Mat srcPlane, dstPlane;							// warpFromչӳõĻ,֡
+
+	/*
+	 * @breif:ӦӳyȫԼ
+	 * @prama[in]:Hinv->ӳͼԴͼĵӦ(); y->к; cols->ӳͼ; srcSize->Դͼߴ
+	 * @retval:,Чʱbegin>=end
+	 */
+	static row_run homoRowRun(const double* Hinv, int y, int cols, Size srcSize);
+};
+
+#endif // !VALIDMASK_H
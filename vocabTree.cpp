@@ -0,0 +1,326 @@
+/*******************************************************************************
+ *
+ * \file    vocabTree.cpp
+ * \brief   ʻͼֲ๹Ӿʵ䣬ļ֣ΪͼɸѡѡƴӶ
+ * \author  agent
+ * \version 1.0
+ * \date    2026-10-19
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * -----------------------------------------------------------------------------
+ * ļ޸ʷ
+ * <ʱ>       | <汾>  | <>         |
+ * 2026-10-19  | v1.0    | agent          |
+ * -----------------------------------------------------------------------------
+ ******************************************************************************/
+#include "vocabTree.h"
+
+/*===================================================================================*/
+/******************************* к *********************************************/
+/*===================================================================================*/
+
+/*
+ * @breif:캯
+ * @prama[in]:branch->ÿڵķ֧; depth->
+ */
+vocabTree::vocabTree(int branch, int depth)
+{
+	vocabTree::branch = cmpMax(branch, 2);
+	vocabTree::depth = cmpMax(depth, 1);
+	vocabTree::wordNum = 0;
+	vocabTree::imgNum = 0;
+	vocabTree::descType = -1;
+	vocabTree::descCols = 0;
+}
+
+/*
+ * @breif:ɸͼӷֲ๹ʻ,k-means,k-majority
+ * @prama[in]:descs->ͼ(CV_32FCV_8U,һ)
+ * @retval:true->ɹ; false->ӻͲһ
+ */
+bool vocabTree::train(const vector<Mat>& descs)
+{
+	int total = 0, type = -1, cols = 0;
+	for (const Mat& desc : descs)
+	{
+		if (desc.empty())	continue;
+		if (type >= 0 && (desc.type() != type || desc.cols != cols))
+		{
+			cout << "vocabTree::train Ͳһ" << endl;
+			return false;
+		}
+		type = desc.type();
+		cols = desc.cols;
+		total += desc.rows;
+	}
+	if (total == 0 || (type != CV_32F && type != CV_8U))
+	{
+		cout << "vocabTree::train ޿" << endl;
+		return false;
+	}
+
+	// ʱͼͬ,ָͼڴʵеı
+	int stride = (total + VOCAB_TRAINMAX - 1) / VOCAB_TRAINMAX;
+	Mat data;
+	for (const Mat& desc : descs)
+		for (int r = 0; r < desc.rows; r += stride)	data.push_back(desc.row(r));
+
+	vocabTree::descType = type;
+	vocabTree::descCols = cols;
+	vocabTree::wordNum = 0;
+	vocabTree::imgNum = 0;
+	vocabTree::imgWords.clear();
+	vocabTree::invertedFile.clear();
+	tree_node root;
+	root.childBegin = -1;
+	root.wordIdx = -1;
+	vocabTree::nodes.assign(1, root);
+	vector<int> rows(data.rows);
+	for (int r = 0; r < data.rows; r++)	rows[r] = r;
+	vocabTree::buildNode(0, data, rows, 0);
+	return true;
+}
+
+/*
+ * @breif:һԸȡľ,ΪӾ
+ * @prama[in]:desc->Ӿ; row->к
+ * @retval:Ӿ
+ */
+int vocabTree::quantize(const Mat& desc, int row) const
+{
+	if (vocabTree::nodes.empty())	return -1;
+	int nodeIdx = 0;
+	while (vocabTree::nodes[nodeIdx].wordIdx < 0)
+	{
+		const tree_node& node = vocabTree::nodes[nodeIdx];
+		int best = 0;
+		float bestDist = FLT_MAX;
+		for (int c = 0; c < node.centers.rows; c++)
+		{
+			float dist = (vocabTree::descType == CV_8U)
+				? (float)hal::normHamming(desc.ptr<uchar>(row), node.centers.ptr<uchar>(c), vocabTree::descCols)
+				: hal::normL2Sqr_(desc.ptr<float>(row), node.centers.ptr<float>(c), vocabTree::descCols);
+			if (dist < bestDist)
+			{
+				bestDist = dist;
+				best = c;
+			}
+		}
+		nodeIdx = node.childBegin + best;
+	}
+	return vocabTree::nodes[nodeIdx].wordIdx;
+}
+
+/*
+ * @breif:һͼ,вͳӾƵ
+ * @prama[in]:imgIdx->ͼ; desc->
+ * @retval:None
+ */
+void vocabTree::addImage(int imgIdx, const Mat& desc)
+{
+	if (imgIdx >= (int)vocabTree::imgWords.size())	vocabTree::imgWords.resize(imgIdx + 1);
+	vocabTree::imgNum = (int)vocabTree::imgWords.size();
+	vocabTree::imgWords[imgIdx].clear();
+	if (desc.empty() || vocabTree::nodes.empty())	return;
+	if (desc.type() != vocabTree::descType || desc.cols != vocabTree::descCols)
+	{
+		cout << "vocabTree::addImage ʵ䲻һ:" << imgIdx << endl;
+		return;
+	}
+
+	vector<int> words(desc.rows);
+	parallel_for_(Range(0, desc.rows), [&](const Range& range)
+	{
+		for (int r = range.start; r < range.end; r++)	words[r] = vocabTree::quantize(desc, r);
+	});
+
+	// γͳƵ,õеϡ
+	sort(words.begin(), words.end());
+	vector<pair<int, float>>& counts = vocabTree::imgWords[imgIdx];
+	for (size_t k = 0; k < words.size(); k++)
+	{
+		if (counts.empty() || counts.back().first != words[k])	counts.push_back(make_pair(words[k], 1.0f));
+		else	counts.back().second += 1.0f;
+	}
+}
+
+/*
+ * @breif:ȫͼĵƵ,ɹһtf-idf뵹ļ
+ * @prama[in]:None
+ * @retval:None
+ */
+void vocabTree::build()
+{
+	vector<int> docFreq(vocabTree::wordNum, 0);
+	for (const vector<pair<int, float>>& words : vocabTree::imgWords)
+		for (const pair<int, float>& w : words)	docFreq[w.first]++;
+
+	// ȫͼеĵidfΪ0,
+	vocabTree::invertedFile.assign(vocabTree::wordNum, vector<inverted_entry>());
+	for (int i = 0; i < vocabTree::imgNum; i++)
+	{
+		vector<pair<int, float>>& words = vocabTree::imgWords[i];
+		double sqSum = 0;
+		for (pair<int, float>& w : words)
+		{
+			w.second *= (float)log((double)vocabTree::imgNum / docFreq[w.first]);
+			sqSum += (double)w.second * w.second;
+		}
+		if (sqSum <= 0)	continue;
+		float scale = (float)(1.0 / sqrt(sqSum));
+		for (pair<int, float>& w : words)
+		{
+			w.second *= scale;
+			if (w.second > 0)	vocabTree::invertedFile[w.first].push_back({ i, w.second });
+		}
+	}
+}
+
+/*
+ * @breif:ĳѼͼΪѯ,ļۼƶ,ص÷ߵɷͼ
+ * @prama[in]:imgIdx->ѯͼ; topK->صͼ
+ * @retval:(ͼ,ƶ),ƶȽ
+ */
+vector<pair<int, float>> vocabTree::query(int imgIdx, int topK) const
+{
+	vector<pair<int, float>> result;
+	if (imgIdx < 0 || imgIdx >= vocabTree::imgNum || vocabTree::invertedFile.empty())	return result;
+
+	// ֻѯͼеʵͼ,빲ִȶͼ
+	vector<float> scores(vocabTree::imgNum, 0);
+	for (const pair<int, float>& w : vocabTree::imgWords[imgIdx])
+		for (const inverted_entry& entry : vocabTree::invertedFile[w.first])	scores[entry.imgIdx] += w.second * entry.weight;
+
+	for (int j = 0; j < vocabTree::imgNum; j++)
+		if (j != imgIdx && scores[j] > 0)	result.push_back(make_pair(j, scores[j]));
+	int keepNum = cmpMin(topK, (int)result.size());
+	partial_sort(result.begin(), result.begin() + keepNum, result.end(),
+		[](const pair<int, float>& a, const pair<int, float>& b) { return a.second > b.second; });
+	result.resize(keepNum);
+	return result;
+}
+
+/*
+ * @breif:ÿͼȡtopKƵͼΪѡƴӶ,ϲȥ
+ * @prama[in]:topK->ÿͼĺѡ
+ * @retval:ѡƴӶ(i<j),
+ */
+vector<pair<int, int>> vocabTree::candidatePairs(int topK) const
+{
+	vector<vector<pair<int, float>>> neighbors(vocabTree::imgNum);
+	parallel_for_(Range(0, vocabTree::imgNum), [&](const Range& range)
+	{
+		for (int i = range.start; i < range.end; i++)	neighbors[i] = vocabTree::query(i, topK);
+	});
+
+	set<pair<int, int>> pairSet;
+	for (int i = 0; i < vocabTree::imgNum; i++)
+		for (const pair<int, float>& n : neighbors[i])	pairSet.insert(make_pair(cmpMin(i, n.first), cmpMax(i, n.first)));
+	return vector<pair<int, int>>(pairSet.begin(), pairSet.end());
+}
+/*-----------------------------------------------------------------------------------*/
+
+
+/*===================================================================================*/
+/******************************* ˽к *********************************************/
+/*===================================================================================*/
+
+/*
+ * @breif:ݹضԽڵѵಢӽڵ,򵽴ʱΪҶڵ
+ * @prama[in]:nodeIdx->ڵ; data->ѵ; rows->ýڵк; level->ڵ
+ * @retval:None
+ */
+void vocabTree::buildNode(int nodeIdx, const Mat& data, const vector<int>& rows, int level)
+{
+	if (level >= vocabTree::depth || (int)rows.size() <= vocabTree::branch)
+	{
+		vocabTree::nodes[nodeIdx].wordIdx = vocabTree::wordNum++;
+		return;
+	}
+
+	Mat centers;
+	vector<int> labels;
+	vocabTree::cluster(data, rows, centers, labels);
+	vector<vector<int>> childRows(centers.rows);
+	for (size_t k = 0; k < rows.size(); k++)	childRows[labels[k]].push_back(rows[k]);
+
+	// ӽڵ,ݺֻͨŷ
+	tree_node child;
+	child.childBegin = -1;
+	child.wordIdx = -1;
+	int childBegin = (int)vocabTree::nodes.size();
+	vocabTree::nodes[nodeIdx].centers = centers;
+	vocabTree::nodes[nodeIdx].childBegin = childBegin;
+	vocabTree::nodes.resize(childBegin + centers.rows, child);
+	for (int c = 0; c < centers.rows; c++)	vocabTree::buildNode(childBegin + c, data, childRows[c], level + 1);
+}
+
+/*
+ * @breif:Ϊbranch
+ * @prama[in]:data->ѵ; rows->к; centers->ľ; labels->ĸ
+ * @retval:None
+ */
+void vocabTree::cluster(const Mat& data, const vector<int>& rows, Mat& centers, vector<int>& labels)
+{
+	int sampleNum = (int)rows.size();
+	int k = vocabTree::branch;
+	labels.assign(sampleNum, 0);
+	if (vocabTree::descType == CV_32F)
+	{
+		Mat samples(sampleNum, data.cols, CV_32F), labelMat;
+		for (int i = 0; i < sampleNum; i++)	data.row(rows[i]).copyTo(samples.row(i));
+		kmeans(samples, k, labelMat, TermCriteria(TermCriteria::COUNT + TermCriteria::EPS, VOCAB_KMEANSITERS, 1e-4), 1,
+			KMEANS_PP_CENTERS, centers);
+		for (int i = 0; i < sampleNum; i++)	labels[i] = labelMat.at<int>(i);
+		return;
+	}
+
+	// k-majority:ķ,ĵÿһλȡĶֵ
+	int cols = data.cols;
+	centers.create(k, cols, CV_8U);
+	for (int c = 0; c < k; c++)	data.row(rows[(size_t)c * sampleNum / k]).copyTo(centers.row(c));
+	for (int it = 0; it < VOCAB_KMEANSITERS; it++)
+	{
+		parallel_for_(Range(0, sampleNum), [&](const Range& range)
+		{
+			for (int i = range.start; i < range.end; i++)
+			{
+				int best = 0, bestDist = INT_MAX;
+				for (int c = 0; c < k; c++)
+				{
+					int dist = hal::normHamming(data.ptr<uchar>(rows[i]), centers.ptr<uchar>(c), cols);
+					if (dist < bestDist)
+					{
+						bestDist = dist;
+						best = c;
+					}
+				}
+				labels[i] = best;
+			}
+		});
+
+		vector<int> bitCounts(k * cols * 8, 0), clusterSize(k, 0);
+		for (int i = 0; i < sampleNum; i++)
+		{
+			const uchar* rowAddr = data.ptr<uchar>(rows[i]);
+			int* countAddr = &bitCounts[labels[i] * cols * 8];
+			for (int b = 0; b < cols * 8; b++)	countAddr[b] += (rowAddr[b >> 3] >> (7 - (b & 7))) & 1;
+			clusterSize[labels[i]]++;
+		}
+		for (int c = 0; c < k; c++)
+		{
+			// ౣԭ
+			if (clusterSize[c] == 0)	continue;
+			uchar* centerAddr = centers.ptr<uchar>(c);
+			const int* countAddr = &bitCounts[c * cols * 8];
+			for (int j = 0; j < cols; j++)
+			{
+				uchar byte = 0;
+				for (int b = 0; b < 8; b++)	byte = (uchar)((byte << 1) | (countAddr[j * 8 + b] * 2 > clusterSize[c] ? 1 : 0));
+				centerAddr[j] = byte;
+			}
+		}
+	}
+}
+/*-----------------------------------------------------------------------------------*/
@@ -0,0 +1,134 @@
+/*******************************************************************************
+ *
+ * \file    vocabTree.h
+ * \brief   ʻͼֲ๹Ӿʵ䣬ļ֣ΪͼɸѡѡƴӶ
+ * \author  agent
+ * \version 1.0
+ * \date    2026-10-19
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * -----------------------------------------------------------------------------
+ * ļ޸ʷ
+ * <ʱ>       | <汾>  | <>         |
+ * 2026-10-19  | v1.0    | agent          |
+ * -----------------------------------------------------------------------------
+ ******************************************************************************/
+#include <opencv2/core.hpp>
+#include <opencv2/core/hal/hal.hpp>
+#include "publicElement.h"
+#include <iostream>
+#include <vector>
+#include <set>
+#include <cfloat>
+#include <climits>
+using namespace cv;
+using namespace std;
+
+/*===================================================================================*/
+/******************************** 궨 *********************************************/
+/*===================================================================================*/
+#define VOCAB_BRANCH			   10							// ÿڵķ֧
+#define VOCAB_DEPTH					4							// ,Ҷڵ(Ӿ)ΪBRANCH^DEPTH
+#define VOCAB_KMEANSITERS			8							// ÿڵľ
+#define VOCAB_TRAINMAX		   100000							// ѵ,ʱȳ
+#define VOCAB_TOPK					8							// ÿͼĺѡƴӶ
+/*-----------------------------------------------------------------------------------*/
+
+#pragma once
+#ifndef VOCABTREE_H
+#define VOCABTREE_H
+
+class vocabTree
+{
+public:
+	int branch;										// ÿڵķ֧
+	int depth;										// 
+	int wordNum;									// Ӿ
+	int imgNum;										// Ѽͼ
+
+public:
+	/*
+	 * @breif:캯
+	 * @prama[in]:branch->ÿڵķ֧; depth->
+	 */
+	vocabTree(int branch = VOCAB_BRANCH, int depth = VOCAB_DEPTH);
+
+	/*
+	 * @breif:ɸͼӷֲ๹ʻ,k-means,k-majority
+	 * @prama[in]:descs->ͼ(CV_32FCV_8U,һ)
+	 * @retval:true->ɹ; false->ӻͲһ
+	 */
+	bool train(const vector<Mat>& descs);
+
+	/*
+	 * @breif:һԸȡľ,ΪӾ
+	 * @prama[in]:desc->Ӿ; row->к
+	 * @retval:Ӿ
+	 */
+	int quantize(const Mat& desc, int row) const;
+
+	/*
+	 * @breif:һͼ,вͳӾƵ
+	 * @prama[in]:imgIdx->ͼ; desc->
+	 * @retval:None
+	 */
+	void addImage(int imgIdx, const Mat& desc);
+
+	/*
+	 * @breif:ȫͼĵƵ,ɹһtf-idf뵹ļ
+	 * @prama[in]:None
+	 * @retval:None
+	 */
+	void build();
+
+	/*
+	 * @breif:ĳѼͼΪѯ,ļۼƶ,ص÷ߵɷͼ
+	 * @prama[in]:imgIdx->ѯͼ; topK->صͼ
+	 * @retval:(ͼ,ƶ),ƶȽ
+	 */
+	vector<pair<int, float>> query(int imgIdx, int topK) const;
+
+	/*
+	 * @breif:ÿͼȡtopKƵͼΪѡƴӶ,ϲȥ
+	 * @prama[in]:topK->ÿͼĺѡ
+	 * @retval:ѡƴӶ(i<j),
+	 */
+	vector<pair<int, int>> candidatePairs(int topK = VOCAB_TOPK) const;
+
+private:
+	typedef struct
+	{
+		Mat centers;								// ӽڵľ,ÿһ,ҶڵΪ
+		int childBegin;								// һӽڵnodesе
+		int wordIdx;								// ҶڵӾ,ҶڵΪ-1
+	}tree_node;
+
+	typedef struct
+	{
+		int imgIdx;									// ͼ
+		float weight;								// ͼtf-idfڸõϵķ
+	}inverted_entry;
+
+	int descType;									// ,CV_32FCV_8U
+	int descCols;									// 
+	vector<tree_node> nodes;						// ڵ,nodes[0]Ϊ
+	vector<vector<pair<int, float>>> imgWords;		// ͼϡӾ,buildǰΪƵ,buildΪһtf-idf
+	vector<vector<inverted_entry>> invertedFile;	// Ӿʵĵļ
+
+	/*
+	 * @breif:ݹضԽڵѵಢӽڵ,򵽴ʱΪҶڵ
+	 * @prama[in]:nodeIdx->ڵ; data->ѵ; rows->ýڵк; level->ڵ
+	 * @retval:None
+	 */
+	void buildNode(int nodeIdx, const Mat& data, const vector<int>& rows, int level);
+
+	/*
+	 * @breif:Ϊbranch
+	 * @prama[in]:data->ѵ; rows->к; centers->ľ; labels->ĸ
+	 * @retval:None
+	 */
+	void cluster(const Mat& data, const vector<int>& rows, Mat& centers, vector<int>& labels);
+};
+
+#endif // !VOCABTREE_H
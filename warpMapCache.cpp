@@ -0,0 +1,224 @@
+/*******************************************************************************
+ *
+ * \file    warpMapCache.cpp
+ * \brief   Ӧ任ұ棺̶λԤ㶨remapӳظʹ
+ * \author  agent
+ * \version 1.0
+ * \date    2026-10-19
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * -----------------------------------------------------------------------------
+ * ļ޸ʷ
+ * <ʱ>       | <汾>  | <>         |
+ * 2026-10-19  | v1.0    | agent          |
+ * -----------------------------------------------------------------------------
+ ******************************************************************************/
+#include "warpMapCache.h"
+
+/*===================================================================================*/
+/******************************* к *********************************************/
+/*===================================================================================*/
+
+/*
+ * @breif:캯
+ * @prama[in]:tag->ʶ
+ */
+warpMapCache::warpMapCache(string tag)
+{
+	warpMapCache::tag = tag;
+	warpMapCache::reuseNum = 0;
+}
+
+/*
+ * @breif:жϻǷڸHߴ,Hı仯ĽǷͶӰԴͼƫƺ,
+ *        Hƶ,λСݲ(ȡ)ڱ仯ʱͬЧ,ʱߴԻΪ׼
+ * @prama[in]:H->Ӧ; srcSize->Դͼߴ; roi->; tol->ƫݲ .pix
+ * @retval:true->Ч
+ */
+bool warpMapCache::isValid(const Mat& H, Size srcSize, Rect roi, double tol)
+{
+	if (warpMapCache::mapXY.empty() || warpMapCache::srcSize != srcSize)	return false;
+	int roiTol = (int)ceil(tol);
+	const Rect& oldRoi = warpMapCache::roi;
+	if (abs(oldRoi.x - roi.x) > roiTol || abs(oldRoi.y - roi.y) > roiTol ||
+		abs(oldRoi.width - roi.width) > roiTol || abs(oldRoi.height - roi.height) > roiTol)
+		return false;
+
+	Mat H64;
+	H.convertTo(H64, CV_64F);
+	Mat HinvOld = warpMapCache::H.inv();
+	Mat HinvNew = H64.inv();
+	Mat dstCorner = (Mat_<double>(3, 4) << oldRoi.x, oldRoi.x + oldRoi.width, oldRoi.x, oldRoi.x + oldRoi.width,
+		oldRoi.y, oldRoi.y, oldRoi.y + oldRoi.height, oldRoi.y + oldRoi.height,
+		1, 1, 1, 1);
+	Mat srcOld = HinvOld * dstCorner;
+	Mat srcNew = HinvNew * dstCorner;
+	for (int i = 0; i < 4; i++)
+	{
+		double dx = srcOld.at<double>(0, i) / srcOld.at<double>(2, i) - srcNew.at<double>(0, i) / srcNew.at<double>(2, i);
+		double dy = srcOld.at<double>(1, i) / srcOld.at<double>(2, i) - srcNew.at<double>(1, i) / srcNew.at<double>(2, i);
+		if (sqrt(dx * dx + dy * dy) > tol)	return false;
+	}
+	return true;
+}
+
+/*
+ * @breif:ܷ׼ֱûH:ӳɡԴͼߴһδWARPCACHE_RECHECK֡,ʱ1
+ * @prama[in]:srcSize->Դͼߴ
+ * @retval:true->
+ */
+bool warpMapCache::reuse(Size srcSize)
+{
+	if (warpMapCache::mapXY.empty() || warpMapCache::srcSize != srcSize || warpMapCache::reuseNum >= WARPCACHE_RECHECK)
+		return false;
+	warpMapCache::reuseNum++;
+	return true;
+}
+
+/*
+ * @breif:Ԥ㶨ӳ
+ * @prama[in]:H->Ӧ; srcSize->Դͼߴ; roi->
+ * @retval:None
+ */
+void warpMapCache::build(const Mat& H, Size srcSize, Rect roi)
+{
+	H.convertTo(warpMapCache::H, CV_64F);
+	warpMapCache::srcSize = srcSize;
+	warpMapCache::roi = roi;
+	warpMapCache::mapXY.create(roi.height, roi.width, CV_16SC2);
+	warpMapCache::mapA.create(roi.height, roi.width, CV_16UC1);
+
+	Mat Hinv = warpMapCache::H.inv();
+	const double* h = Hinv.ptr<double>(0);
+	int stripNum = (roi.height + WARPCACHE_STRIP - 1) / WARPCACHE_STRIP;
+	parallel_for_(Range(0, stripNum), [&](const Range& range)
+	{
+		Mat stripX(WARPCACHE_STRIP, roi.width, CV_32FC1), stripY(WARPCACHE_STRIP, roi.width, CV_32FC1);
+		for (int s = range.start; s < range.end; s++)
+		{
+			int rowBegin = s * WARPCACHE_STRIP;
+			int rowEnd = cmpMin(rowBegin + WARPCACHE_STRIP, roi.height);
+			for (int i = rowBegin; i < rowEnd; i++)
+			{
+				float* rowAddrX = stripX.ptr<float>(i - rowBegin);
+				float* rowAddrY = stripY.ptr<float>(i - rowBegin);
+				double y = i + roi.y;
+				for (int j = 0; j < roi.width; j++)
+				{
+					double x = j + roi.x;
+					double w = h[6] * x + h[7] * y + h[8];
+					w = (w != 0) ? 1.0 / w : 0;
+					rowAddrX[j] = (float)((h[0] * x + h[1] * y + h[2]) * w);
+					rowAddrY[j] = (float)((h[3] * x + h[4] * y + h[5]) * w);
+				}
+			}
+			// תΪ+ֵ,remapʱҪֵȨؼ
+			Mat dstXY = warpMapCache::mapXY.rowRange(rowBegin, rowEnd);
+			Mat dstA = warpMapCache::mapA.rowRange(rowBegin, rowEnd);
+			convertMaps(stripX.rowRange(0, rowEnd - rowBegin), stripY.rowRange(0, rowEnd - rowBegin), dstXY, dstA, CV_16SC2);
+		}
+	});
+}
+
+/*
+ * @breif:ӻĿ¼ӳ(ʶԴͼߴ),ڻHݲʱ¼㲢ԭļ
+ * @prama[in]:cacheDir->Ŀ¼,Ϊ; H->Ӧ; srcSize->Դͼߴ; roi->
+ * @retval:None
+ */
+void warpMapCache::loadOrBuild(string cacheDir, const Mat& H, Size srcSize, Rect roi)
+{
+	if (warpMapCache::isValid(H, srcSize, roi))	return;
+	if (cacheDir.empty())
+	{
+		warpMapCache::build(H, srcSize, roi);
+		return;
+	}
+
+	string fileName = cacheDir + "/" + warpMapCache::keyName(warpMapCache::tag, srcSize);
+	if (warpMapCache::load(fileName) && warpMapCache::isValid(H, srcSize, roi))	return;
+	warpMapCache::build(H, srcSize, roi);
+	warpMapCache::save(fileName);
+}
+
+/*
+ * @breif:桢ȡӳ
+ * @prama[in]:fileName->ļ·
+ * @retval:true->ɹ; false->ʧ
+ */
+bool warpMapCache::save(string fileName)
+{
+	ofstream file(fileName, ios::binary);
+	if (!file.is_open())	return false;
+
+	int header[7] = { WARPCACHE_MAGIC, warpMapCache::srcSize.width, warpMapCache::srcSize.height,
+		warpMapCache::roi.x, warpMapCache::roi.y, warpMapCache::roi.width, warpMapCache::roi.height };
+	file.write((const char*)header, sizeof(header));
+	file.write((const char*)warpMapCache::H.ptr<double>(0), 9 * sizeof(double));
+	for (int i = 0; i < warpMapCache::mapXY.rows; i++)
+		file.write((const char*)warpMapCache::mapXY.ptr(i), warpMapCache::mapXY.cols * warpMapCache::mapXY.elemSize());
+	for (int i = 0; i < warpMapCache::mapA.rows; i++)
+		file.write((const char*)warpMapCache::mapA.ptr(i), warpMapCache::mapA.cols * warpMapCache::mapA.elemSize());
+	return file.good();
+}
+
+bool warpMapCache::load(string fileName)
+{
+	ifstream file(fileName, ios::binary);
+	if (!file.is_open())	return false;
+
+	int header[7] = { 0 };
+	file.read((char*)header, sizeof(header));
+	if (!file.good() || header[0] != WARPCACHE_MAGIC)	return false;
+	warpMapCache::srcSize = Size(header[1], header[2]);
+	warpMapCache::roi = Rect(header[3], header[4], header[5], header[6]);
+	warpMapCache::H.create(3, 3, CV_64F);
+	file.read((char*)warpMapCache::H.ptr<double>(0), 9 * sizeof(double));
+	warpMapCache::mapXY.create(warpMapCache::roi.height, warpMapCache::roi.width, CV_16SC2);
+	warpMapCache::mapA.create(warpMapCache::roi.height, warpMapCache::roi.width, CV_16UC1);
+	for (int i = 0; i < warpMapCache::mapXY.rows; i++)
+		file.read((char*)warpMapCache::mapXY.ptr(i), warpMapCache::mapXY.cols * warpMapCache::mapXY.elemSize());
+	for (int i = 0; i < warpMapCache::mapA.rows; i++)
+		file.read((char*)warpMapCache::mapA.ptr(i), warpMapCache::mapA.cols * warpMapCache::mapA.elemSize());
+	if (!file.good())
+	{
+		warpMapCache::mapXY.release();
+		warpMapCache::mapA.release();
+		return false;
+	}
+	return true;
+}
+
+/*
+ * @breif:remap,ÿֻ֡һڴ޵ȡֵ
+ * @prama[in]:srcImg->Դͼ; dstImg->ͼ,ߴΪroiС
+ * @retval:None
+ */
+void warpMapCache::apply(const Mat& srcImg, Mat& dstImg)
+{
+	dstImg.create(warpMapCache::roi.height, warpMapCache::roi.width, srcImg.type());
+	int stripNum = (warpMapCache::roi.height + WARPCACHE_STRIP - 1) / WARPCACHE_STRIP;
+	parallel_for_(Range(0, stripNum), [&](const Range& range)
+	{
+		for (int s = range.start; s < range.end; s++)
+		{
+			int rowBegin = s * WARPCACHE_STRIP;
+			int rowEnd = cmpMin(rowBegin + WARPCACHE_STRIP, warpMapCache::roi.height);
+			Mat dstStrip = dstImg.rowRange(rowBegin, rowEnd);
+			remap(srcImg, dstStrip, warpMapCache::mapXY.rowRange(rowBegin, rowEnd),
+				warpMapCache::mapA.rowRange(rowBegin, rowEnd), INTER_LINEAR, BORDER_CONSTANT, Scalar(0, 0, 0));
+		}
+	});
+}
+
+/*
+ * @breif:ɱʶԴͼߴɻļ,ͬһƴӶֻռһļ,H仯󸲸
+ * @prama[in]:tag->ʶ; srcSize->Դͼߴ
+ * @retval:ļ
+ */
+string warpMapCache::keyName(string tag, Size srcSize)
+{
+	if (tag.empty())	return getFormatStr("warpmap_%dx%d.bin", srcSize.width, srcSize.height);
+	return getFormatStr("warpmap_%s_%dx%d.bin", tag.c_str(), srcSize.width, srcSize.height);
+}
+/*-----------------------------------------------------------------------------------*/
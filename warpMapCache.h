@@ -0,0 +1,107 @@
+/*******************************************************************************
+ *
+ * \file    warpMapCache.h
+ * \brief   Ӧ任ұ棺̶λԤ㶨remapӳظʹ
+ * \author  agent
+ * \version 1.0
+ * \date    2026-10-19
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * -----------------------------------------------------------------------------
+ * ļ޸ʷ
+ * <ʱ>       | <汾>  | <>         |
+ * 2026-10-19  | v1.0    | agent          |
+ * -----------------------------------------------------------------------------
+ ******************************************************************************/
+#include <opencv2/imgproc/imgproc.hpp>
+#include "publicElement.h"
+#include <iostream>
+#include <fstream>
+using namespace cv;
+using namespace std;
+
+/*===================================================================================*/
+/******************************** 궨 *********************************************/
+/*===================================================================================*/
+#define WARPCACHE_TOL			  0.5							// H仯Դƫݲ .pix
+#define WARPCACHE_STRIP			   64							// д
+#define WARPCACHE_MAGIC		0x50414D57							// ļʶ"WMAP"
+#define WARPCACHE_RECHECK		   30							// ûH֡,֮׼
+/*-----------------------------------------------------------------------------------*/
+
+#pragma once
+#ifndef WARPMAPCACHE_H
+#define WARPMAPCACHE_H
+
+class warpMapCache
+{
+public:
+	Mat H;											// ӳʱĵӦ(Դͼ->ͼ)
+	Size srcSize;									// Դͼߴ
+	Rect roi;										// (ͼ)
+	Mat mapXY;										// ӳ,CV_16SC2
+	Mat mapA;										// ֵ,CV_16UC1
+	string tag;										// ʶ(ƴӶ),Դͼߴһ𹹳ļ
+	int reuseNum;									// ûHδ׼֡
+
+public:
+	/*
+	 * @breif:캯
+	 * @prama[in]:tag->ʶ
+	 */
+	warpMapCache(string tag = "");
+
+	/*
+	 * @breif:жϻǷڸHߴ,Hı仯ĽǷͶӰԴͼƫƺ,
+	 *        Hƶ,λСݲ(ȡ)ڱ仯ʱͬЧ,ʱߴԻΪ׼
+	 * @prama[in]:H->Ӧ; srcSize->Դͼߴ; roi->; tol->ƫݲ .pix
+	 * @retval:true->Ч
+	 */
+	bool isValid(const Mat& H, Size srcSize, Rect roi, double tol = WARPCACHE_TOL);
+
+	/*
+	 * @breif:ܷ׼ֱûH:ӳɡԴͼߴһδWARPCACHE_RECHECK֡,ʱ1
+	 * @prama[in]:srcSize->Դͼߴ
+	 * @retval:true->
+	 */
+	bool reuse(Size srcSize);
+
+	/*
+	 * @breif:Ԥ㶨ӳ
+	 * @prama[in]:H->Ӧ; srcSize->Դͼߴ; roi->
+	 * @retval:None
+	 */
+	void build(const Mat& H, Size srcSize, Rect roi);
+
+	/*
+	 * @breif:ӻĿ¼ӳ(ʶԴͼߴ),ڻHݲʱ¼㲢ԭļ
+	 * @prama[in]:cacheDir->Ŀ¼,Ϊ; H->Ӧ; srcSize->Դͼߴ; roi->
+	 * @retval:None
+	 */
+	void loadOrBuild(string cacheDir, const Mat& H, Size srcSize, Rect roi);
+
+	/*
+	 * @breif:桢ȡӳ
+	 * @prama[in]:fileName->ļ·
+	 * @retval:true->ɹ; false->ʧ
+	 */
+	bool save(string fileName);
+	bool load(string fileName);
+
+	/*
+	 * @breif:remap,ÿֻ֡һڴ޵ȡֵ
+	 * @prama[in]:srcImg->Դͼ; dstImg->ͼ,ߴΪroiС
+	 * @retval:None
+	 */
+	void apply(const Mat& srcImg, Mat& dstImg);
+
+	/*
+	 * @breif:ɱʶԴͼߴɻļ,ͬһƴӶֻռһļ,H仯󸲸
+	 * @prama[in]:tag->ʶ; srcSize->Դͼߴ
+	 * @retval:ļ
+	 */
+	static string keyName(string tag, Size srcSize);
+};
+
+#endif // !WARPMAPCACHE_H